@@ -15,6 +15,10 @@
 #ifndef RCL_LOGGING_INTERFACE__RCL_LOGGING_INTERFACE_H_
 #define RCL_LOGGING_INTERFACE__RCL_LOGGING_INTERFACE_H_
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
 #include "rcl_logging_interface/visibility_control.h"
 #include "rcutils/allocator.h"
 
@@ -27,12 +31,149 @@ typedef enum
   RCL_LOGGING_RET_OK = 0,
   RCL_LOGGING_RET_ERROR = 2,
   RCL_LOGGING_RET_INVALID_ARGUMENT = 11,
+  RCL_LOGGING_RET_NOT_ENOUGH_SPACE = 12,
   RCL_LOGGING_RET_CONFIG_FILE_DOESNT_EXIST = 21,
   RCL_LOGGING_RET_CONFIG_FILE_INVALID = 22,
 } rcl_logging_ret_t;
 
+/// A message to be logged as part of a batch, see rcl_logging_external_log_batch().
+typedef struct rcl_logging_record_s
+{
+  /// The severity level of the message.
+  int severity;
+  /// The name of the logger, need not be null terminated.
+  /**
+   * May be NULL if name_length is 0.
+   * If empty the root logger will be used.
+   */
+  const char * name;
+  /// The length of the name in bytes.
+  size_t name_length;
+  /// The message, need not be null terminated.
+  const char * msg;
+  /// The length of the message in bytes.
+  size_t msg_length;
+} rcl_logging_record_t;
+
+/// A message with its context kept apart, see rcl_logging_external_log_structured().
+typedef struct rcl_logging_structured_record_s
+{
+  /// The severity level of the message.
+  int severity;
+  /// The name of the logger, need not be null terminated.
+  /**
+   * May be NULL if name_length is 0.
+   * If empty the root logger will be used.
+   */
+  const char * name;
+  /// The length of the name in bytes.
+  size_t name_length;
+  /// When the message was logged, in nanoseconds since the epoch of the system clock.
+  int64_t timestamp_ns;
+  /// The source file the message was logged from, a null terminated C string or NULL.
+  const char * file_name;
+  /// The function the message was logged from, a null terminated C string or NULL.
+  const char * function_name;
+  /// The line the message was logged from, 0 if unknown.
+  size_t line_number;
+  /// The message, need not be null terminated.
+  /**
+   * This is only the text of the message, without the severity, time stamp
+   * and so on around it.
+   */
+  const char * msg;
+  /// The length of the message in bytes.
+  size_t msg_length;
+} rcl_logging_structured_record_t;
+
+/// The severity levels counted separately in rcl_logging_stats_t.
+/**
+ * A severity in between two of them is counted with the higher one, as it is
+ * logged at that level.
+ */
+typedef enum
+{
+  RCL_LOGGING_STATS_SEVERITY_DEBUG = 0,
+  RCL_LOGGING_STATS_SEVERITY_INFO,
+  RCL_LOGGING_STATS_SEVERITY_WARN,
+  RCL_LOGGING_STATS_SEVERITY_ERROR,
+  RCL_LOGGING_STATS_SEVERITY_FATAL,
+  /// The number of severity levels, not a level itself.
+  RCL_LOGGING_STATS_SEVERITY_COUNT,
+} rcl_logging_stats_severity_t;
+
+/// What the logging backend did since it was initialized, see rcl_logging_external_get_stats().
+typedef struct rcl_logging_stats_s
+{
+  /// The number of messages passed on to be written, by rcl_logging_stats_severity_t.
+  uint64_t accepted[RCL_LOGGING_STATS_SEVERITY_COUNT];
+  /// The number of messages not written, by rcl_logging_stats_severity_t.
+  /**
+   * These are below the level of their logger, or were left out by the
+   * backend, as duplicates for instance.
+   */
+  uint64_t filtered[RCL_LOGGING_STATS_SEVERITY_COUNT];
+  /// The number of bytes written to the log, as the backend writes messages there.
+  uint64_t bytes_written;
+  /// The number of accepted messages lost because a queue or buffer was full.
+  uint64_t dropped;
+  /// The number of times the log was flushed.
+  uint64_t flush_count;
+  /// The total time spent flushing, in nanoseconds.
+  uint64_t flush_time_ns;
+  /// The number of messages waiting to be written.
+  uint64_t queue_depth;
+  /// The largest number of messages ever waiting to be written.
+  uint64_t peak_queue_depth;
+} rcl_logging_stats_t;
+
+/// The number of buckets of rcl_logging_latency_histogram_t.
+#define RCL_LOGGING_LATENCY_HISTOGRAM_BUCKET_COUNT 64
+
+/// A histogram of latencies, see rcl_logging_external_get_latency_histograms().
+typedef struct rcl_logging_latency_histogram_s
+{
+  /// The number of latencies recorded.
+  uint64_t count;
+  /// The median latency in nanoseconds.
+  uint64_t p50_ns;
+  /// The 90th percentile latency in nanoseconds.
+  uint64_t p90_ns;
+  /// The 99th percentile latency in nanoseconds.
+  uint64_t p99_ns;
+  /// The 99.9th percentile latency in nanoseconds.
+  uint64_t p999_ns;
+  /// The largest latency in nanoseconds.
+  uint64_t max_ns;
+  /// The number of latencies of 2^i up to 2^(i+1) nanoseconds in bucket i.
+  /**
+   * Bucket 0 also counts latencies of 0.
+   */
+  uint64_t buckets[RCL_LOGGING_LATENCY_HISTOGRAM_BUCKET_COUNT];
+} rcl_logging_latency_histogram_t;
+
+/// How long messages take through the logging backend.
+typedef struct rcl_logging_latency_histograms_s
+{
+  /// From the call logging a message until it is written to the log file.
+  /**
+   * It may still be buffered in the process then, and would be lost in a crash.
+   */
+  rcl_logging_latency_histogram_t written;
+  /// From the call logging a message until it is flushed out of the process.
+  rcl_logging_latency_histogram_t flushed;
+} rcl_logging_latency_histograms_t;
+
 /// Initialize the external logging library.
 /**
+ * Initialization is reference counted, so that several clients in a process,
+ * like rcl contexts, can share the logging backend.
+ * Calls after the first successful one only take another reference to the
+ * logging set up by it, including its open log file, and their arguments are
+ * ignored.
+ * Each successful call has to be matched by a call to
+ * rcl_logging_external_shutdown().
+ *
  * \param[in] file_name_prefix The prefix for log file name that external
  *   logging library should use to configure itself.
  *   If provided, it must be a null terminated C string.
@@ -44,6 +185,8 @@ typedef enum
  * \param[in] allocator The allocator to use for memory allocation.  This is
  *   an rcutils_allocator_t rather than an rcl_allocator_t to ensure that the
  *   rcl_logging_* packages don't have a circular dependency back to rcl.
+ *   The logging library may keep using it until rcl_logging_external_shutdown()
+ *   returns, also from threads of its own.
  * \return RCL_LOGGING_RET_OK if initialized successfully.
  * \return RCL_LOGGING_RET_ERROR if an unspecified error occurs.
  * \return RCL_LOGGING_RET_CONFIG_FILE_DOESNT_EXIST if a config_file is provided
@@ -61,7 +204,11 @@ rcl_logging_external_initialize(
 
 /// Free the resources allocated for the external logging system.
 /**
- * This puts the system into a state equivalent to being uninitialized.
+ * This releases the reference taken by one call to
+ * rcl_logging_external_initialize().
+ * Only the last one puts the system into a state equivalent to being
+ * uninitialized, before that logging keeps working for the other clients.
+ * Calling it when not initialized does nothing.
  *
  * \return RCL_LOGGING_RET_OK if successfully shutdown, or
  * \return RCL_LOGGING_RET_ERROR if an unspecified error occurs.
@@ -83,6 +230,177 @@ RCL_LOGGING_INTERFACE_PUBLIC
 void
 rcl_logging_external_log(int severity, const char * name, const char * msg);
 
+/// Log a message of known length.
+/**
+ * This is the same as rcl_logging_external_log(), except that neither the
+ * logger name nor the message have to be null terminated, so callers which
+ * already know the lengths (after formatting the message, for instance)
+ * save the backend from measuring them again.
+ *
+ * \param[in] severity The severity level of the message being logged.
+ * \param[in] name The name of the logger, need not be null terminated.
+ *   May be NULL if name_length is 0.
+ *   If empty the root logger will be used.
+ * \param[in] name_length The length of the name in bytes.
+ * \param[in] msg The message to be logged, need not be null terminated.
+ * \param[in] msg_length The length of the message in bytes.
+ */
+RCL_LOGGING_INTERFACE_PUBLIC
+void
+rcl_logging_external_log_with_length(
+  int severity, const char * name, size_t name_length, const char * msg, size_t msg_length);
+
+/// Log several messages at once.
+/**
+ * This is the same as calling rcl_logging_external_log_with_length() for each
+ * record in order, but lets the backend take its locks and read the time once
+ * for the whole batch, which adds up for callers forwarding bursts of messages
+ * from elsewhere.
+ * Records are filtered by severity individually.
+ *
+ * \param[in] records The messages to be logged.
+ *   May be NULL if count is 0.
+ * \param[in] count The number of records.
+ */
+RCL_LOGGING_INTERFACE_PUBLIC
+void
+rcl_logging_external_log_batch(const rcl_logging_record_t * records, size_t count);
+
+/// Log a message which the backend formats itself.
+/**
+ * The other functions logging messages take them already formatted, with the
+ * severity, time stamp and so on rendered into them by rcutils before the
+ * backend gets to check the level of the logger.
+ * Here the backend gets the parts separately instead, so messages which aren't
+ * logged are never formatted, and the backend can format the others the way
+ * it wants, reusing what it rendered for earlier messages.
+ *
+ * How the message is formatted is up to the backend.
+ * Backends which don't format messages log the message by itself.
+ *
+ * \param[in] record The message and its context.
+ *   If NULL nothing is logged.
+ */
+RCL_LOGGING_INTERFACE_PUBLIC
+void
+rcl_logging_external_log_structured(const rcl_logging_structured_record_t * record);
+
+/// Write out the messages the backend has kept in memory instead of logging.
+/**
+ * Backends may keep recent messages below the level of their logger in memory,
+ * to be written out only when something goes wrong, like a flight recorder.
+ * This writes them out now, to capture the context of a failure the backend
+ * can't see by itself.
+ * Backends which don't keep such messages do nothing.
+ *
+ * \return RCL_LOGGING_RET_OK if successful, or
+ * \return RCL_LOGGING_RET_ERROR if an unspecified error occurs.
+ */
+RCL_LOGGING_INTERFACE_PUBLIC
+RCUTILS_WARN_UNUSED
+rcl_logging_ret_t
+rcl_logging_external_dump_flight_recorder(void);
+
+/// Get statistics of the logging backend.
+/**
+ * The statistics start from zero when the backend is initialized.
+ * Backends keep them without adding contention between threads logging at
+ * once, so they may not account for messages still being logged by other
+ * threads yet.
+ * Backends fill in what they keep track of, and leave the rest zero.
+ *
+ * \param[out] stats The statistics, must not be NULL.
+ * \return RCL_LOGGING_RET_OK if successful, or
+ * \return RCL_LOGGING_RET_INVALID_ARGUMENT if stats is NULL, or
+ * \return RCL_LOGGING_RET_ERROR if an unspecified error occurs.
+ */
+RCL_LOGGING_INTERFACE_PUBLIC
+RCUTILS_WARN_UNUSED
+rcl_logging_ret_t
+rcl_logging_external_get_stats(rcl_logging_stats_t * stats);
+
+/// Get histograms of how long messages took through the logging backend.
+/**
+ * The histograms start empty when the backend is initialized.
+ * Backends which don't measure latencies, or aren't configured to, leave them
+ * empty.
+ *
+ * \param[out] histograms The histograms, must not be NULL.
+ * \return RCL_LOGGING_RET_OK if successful, or
+ * \return RCL_LOGGING_RET_INVALID_ARGUMENT if histograms is NULL, or
+ * \return RCL_LOGGING_RET_ERROR if an unspecified error occurs.
+ */
+RCL_LOGGING_INTERFACE_PUBLIC
+RCUTILS_WARN_UNUSED
+rcl_logging_ret_t
+rcl_logging_external_get_latency_histograms(rcl_logging_latency_histograms_t * histograms);
+
+/// Check whether a message would be logged.
+/**
+ * This takes into account the severity level of the specified logger, and
+ * can be used to skip formatting a message which would then be dropped.
+ *
+ * \param[in] name The name of the logger, must either be a null terminated
+ *   C string or NULL.
+ *   If NULL or empty the root logger will be used.
+ * \param[in] severity The severity level of the message.
+ * \return true if a message of that severity from that logger would be
+ *   emitted by the logging backend, false otherwise.
+ */
+RCL_LOGGING_INTERFACE_PUBLIC
+bool
+rcl_logging_external_is_enabled_for(const char * name, int severity);
+
+/// The lowest severity level the logging backend may currently emit.
+/**
+ * Messages of a lower severity are dropped by the backend whatever their
+ * logger, so callers can skip them without calling into the backend.
+ * It is kept up to date by the backend as logger levels change.
+ * Backends which don't maintain it leave it at RCUTILS_LOG_SEVERITY_UNSET,
+ * meaning that any message might be emitted.
+ *
+ * It should not be accessed directly, use
+ * rcl_logging_external_severity_might_be_enabled() to read it and
+ * rcl_logging_external_set_severity_threshold() to write it.
+ */
+RCL_LOGGING_INTERFACE_PUBLIC
+extern int g_rcl_logging_external_severity_threshold;
+
+/// Check whether the logging backend might emit a message of a given severity.
+/**
+ * This is a single relaxed load of g_rcl_logging_external_severity_threshold,
+ * cheap enough to be done before any formatting.
+ * A false return means that rcl_logging_external_log() would drop the message
+ * for any logger; a true return still needs to be confirmed by
+ * rcl_logging_external_is_enabled_for() for a particular logger.
+ *
+ * \param[in] severity The severity level of the message.
+ * \return false if a message of that severity would be dropped, true otherwise.
+ */
+static inline
+bool
+rcl_logging_external_severity_might_be_enabled(int severity)
+{
+#if defined(_MSC_VER)
+  // Aligned 32-bit volatile loads are atomic on all the platforms MSVC targets.
+  return severity >= *(const volatile int *)&g_rcl_logging_external_severity_threshold;
+#else
+  return severity >=
+         __atomic_load_n(&g_rcl_logging_external_severity_threshold, __ATOMIC_RELAXED);
+#endif
+}
+
+/// Set the lowest severity level the logging backend may currently emit.
+/**
+ * This is meant to be called by logging backends only.
+ *
+ * \param[in] severity The new threshold, see
+ *   g_rcl_logging_external_severity_threshold.
+ */
+RCL_LOGGING_INTERFACE_PUBLIC
+void
+rcl_logging_external_set_severity_threshold(int severity);
+
 /// Set the severity level for a logger.
 /**
  * This function sets the severity level for the specified logger.
@@ -123,6 +441,31 @@ RCL_LOGGING_INTERFACE_PUBLIC
 rcl_logging_ret_t
 rcl_logging_get_logging_directory(rcutils_allocator_t allocator, char ** directory);
 
+/// Get the logging directory into a buffer, without allocating memory.
+/**
+ * Gets the same directory as rcl_logging_get_logging_directory(), but writes it
+ * into a buffer owned by the caller, so that it can be called as often as
+ * needed without going through an allocator.
+ *
+ * If the buffer is too small, RCL_LOGGING_RET_NOT_ENOUGH_SPACE is returned
+ * without setting an error message, and length is still set.
+ * Passing a NULL buffer with a buffer_size of 0 is a way to get the length.
+ *
+ * \param[out] buffer Where to write the directory path as a null terminated C
+ *   string. Only meaningful if the call is successful.
+ * \param[in] buffer_size The size of buffer in bytes, including room for the
+ *   null terminator.
+ * \param[out] length The length of the directory path, without the null
+ *   terminator. May be NULL.
+ * \return RCL_LOGGING_RET_OK if successful, or
+ * \return RCL_LOGGING_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return RCL_LOGGING_RET_NOT_ENOUGH_SPACE if the buffer is too small, or
+ * \return RCL_LOGGING_RET_ERROR if an unspecified error occurs.
+ */
+RCL_LOGGING_INTERFACE_PUBLIC
+rcl_logging_ret_t
+rcl_logging_get_logging_directory_to_buffer(char * buffer, size_t buffer_size, size_t * length);
+
 #ifdef __cplusplus
 }
 #endif
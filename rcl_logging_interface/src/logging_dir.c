@@ -12,28 +12,47 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <stddef.h>
+#include <string.h>
+
 #include <rcutils/allocator.h>
 #include <rcutils/env.h>
 #include <rcutils/error_handling.h>
 #include <rcutils/filesystem.h>
-#include <rcutils/format_string.h>
-#include <rcutils/strdup.h>
 
 #include "rcl_logging_interface/rcl_logging_interface.h"
 
-rcl_logging_ret_t
-rcl_logging_get_logging_directory(rcutils_allocator_t allocator, char ** directory)
+// Appends to a buffer as far as it fits, and counts the full length regardless.
+typedef struct path_builder_s
 {
-  if (NULL == directory) {
-    RCUTILS_SET_ERROR_MSG("directory argument must not be null");
-    return RCL_LOGGING_RET_INVALID_ARGUMENT;
+  char * buffer;
+  size_t buffer_size;
+  size_t length;
+} path_builder_t;
+
+static void
+append(path_builder_t * builder, const char * str)
+{
+  size_t str_length = strlen(str);
+  if (builder->length < builder->buffer_size) {
+    size_t room = builder->buffer_size - builder->length;
+    memcpy(builder->buffer + builder->length, str, str_length < room ? str_length : room);
   }
-  RCUTILS_CHECK_ALLOCATOR(&allocator, return RCL_LOGGING_RET_INVALID_ARGUMENT);
-  if (NULL != *directory) {
-    RCUTILS_SET_ERROR_MSG("directory argument must point to null");
+  builder->length += str_length;
+}
+
+rcl_logging_ret_t
+rcl_logging_get_logging_directory_to_buffer(char * buffer, size_t buffer_size, size_t * length)
+{
+  if (NULL == buffer && 0 != buffer_size) {
+    RCUTILS_SET_ERROR_MSG("buffer argument must not be null");
     return RCL_LOGGING_RET_INVALID_ARGUMENT;
   }
 
+  // The same as joining, expanding '~' and converting to a native path one
+  // after the other, but straight into the buffer.
+  const char * parts[5];
+  size_t part_count = 0;
   const char * log_dir_env;
   const char * err = rcutils_get_env("ROS_LOG_DIR", &log_dir_env);
   if (NULL != err) {
@@ -41,11 +60,7 @@ rcl_logging_get_logging_directory(rcutils_allocator_t allocator, char ** directo
     return RCL_LOGGING_RET_ERROR;
   }
   if ('\0' != *log_dir_env) {
-    *directory = rcutils_strdup(log_dir_env, allocator);
-    if (NULL == *directory) {
-      RCUTILS_SET_ERROR_MSG("rcutils_strdup failed");
-      return RCL_LOGGING_RET_ERROR;
-    }
+    parts[part_count++] = log_dir_env;
   } else {
     const char * ros_home_dir_env;
     err = rcutils_get_env("ROS_HOME", &ros_home_dir_env);
@@ -53,42 +68,92 @@ rcl_logging_get_logging_directory(rcutils_allocator_t allocator, char ** directo
       RCUTILS_SET_ERROR_MSG("rcutils_get_env failed");
       return RCL_LOGGING_RET_ERROR;
     }
-    char * ros_home_dir;
     if ('\0' == *ros_home_dir_env) {
-      ros_home_dir = rcutils_join_path("~", ".ros", allocator);
-      if (NULL == ros_home_dir) {
-        RCUTILS_SET_ERROR_MSG("rcutils_join_path failed");
-        return RCL_LOGGING_RET_ERROR;
-      }
+      parts[part_count++] = "~";
+      parts[part_count++] = RCUTILS_PATH_DELIMITER;
+      parts[part_count++] = ".ros";
     } else {
-      ros_home_dir = rcutils_strdup(ros_home_dir_env, allocator);
-      if (NULL == ros_home_dir) {
-        RCUTILS_SET_ERROR_MSG("rcutils_strdup failed");
-        return RCL_LOGGING_RET_ERROR;
-      }
+      parts[part_count++] = ros_home_dir_env;
     }
-    *directory = rcutils_join_path(ros_home_dir, "log", allocator);
-    allocator.deallocate(ros_home_dir, allocator.state);
-    if (NULL == *directory) {
-      RCUTILS_SET_ERROR_MSG("rcutils_join_path failed");
+    parts[part_count++] = RCUTILS_PATH_DELIMITER;
+    parts[part_count++] = "log";
+  }
+
+  path_builder_t builder = {buffer, buffer_size, 0};
+  if ('~' == parts[0][0]) {
+    const char * home_dir = rcutils_get_home_dir();
+    if (NULL == home_dir) {
+      RCUTILS_SET_ERROR_MSG("failed to get the home directory");
       return RCL_LOGGING_RET_ERROR;
     }
+    append(&builder, home_dir);
+    append(&builder, parts[0] + 1);
+  } else {
+    append(&builder, parts[0]);
+  }
+  for (size_t i = 1; i < part_count; ++i) {
+    append(&builder, parts[i]);
   }
 
-  char * directory_maybe_not_expanded = *directory;
-  *directory = rcutils_expand_user(directory_maybe_not_expanded, allocator);
-  allocator.deallocate(directory_maybe_not_expanded, allocator.state);
-  if (NULL == *directory) {
-    RCUTILS_SET_ERROR_MSG("rcutils_expand_user failed");
-    return RCL_LOGGING_RET_ERROR;
+  if (NULL != length) {
+    *length = builder.length;
+  }
+  if (builder.length >= buffer_size) {
+    return RCL_LOGGING_RET_NOT_ENOUGH_SPACE;
+  }
+  buffer[builder.length] = '\0';
+  for (char * c = buffer; '\0' != *c; ++c) {
+    if ('/' == *c || '\\' == *c) {
+      *c = RCUTILS_PATH_DELIMITER[0];
+    }
+  }
+  return RCL_LOGGING_RET_OK;
+}
+
+rcl_logging_ret_t
+rcl_logging_get_logging_directory(rcutils_allocator_t allocator, char ** directory)
+{
+  if (NULL == directory) {
+    RCUTILS_SET_ERROR_MSG("directory argument must not be null");
+    return RCL_LOGGING_RET_INVALID_ARGUMENT;
+  }
+  RCUTILS_CHECK_ALLOCATOR(&allocator, return RCL_LOGGING_RET_INVALID_ARGUMENT);
+  if (NULL != *directory) {
+    RCUTILS_SET_ERROR_MSG("directory argument must point to null");
+    return RCL_LOGGING_RET_INVALID_ARGUMENT;
   }
 
-  char * directory_maybe_not_native = *directory;
-  *directory = rcutils_to_native_path(directory_maybe_not_native, allocator);
-  allocator.deallocate(directory_maybe_not_native, allocator.state);
+  // Most paths fit on the stack, so that this allocates only the result.
+  char stack_buffer[256];
+  size_t length = 0;
+  rcl_logging_ret_t ret =
+    rcl_logging_get_logging_directory_to_buffer(stack_buffer, sizeof(stack_buffer), &length);
+  if (RCL_LOGGING_RET_OK == ret) {
+    *directory = allocator.allocate(length + 1, allocator.state);
+    if (NULL == *directory) {
+      RCUTILS_SET_ERROR_MSG("failed to allocate the directory");
+      return RCL_LOGGING_RET_ERROR;
+    }
+    memcpy(*directory, stack_buffer, length + 1);
+    return RCL_LOGGING_RET_OK;
+  }
+  if (RCL_LOGGING_RET_NOT_ENOUGH_SPACE != ret) {
+    return ret;
+  }
+
+  *directory = allocator.allocate(length + 1, allocator.state);
   if (NULL == *directory) {
-    RCUTILS_SET_ERROR_MSG("rcutils_to_native_path failed");
+    RCUTILS_SET_ERROR_MSG("failed to allocate the directory");
     return RCL_LOGGING_RET_ERROR;
   }
-  return RCL_LOGGING_RET_OK;
+  ret = rcl_logging_get_logging_directory_to_buffer(*directory, length + 1, NULL);
+  if (RCL_LOGGING_RET_OK != ret) {
+    allocator.deallocate(*directory, allocator.state);
+    *directory = NULL;
+    if (RCL_LOGGING_RET_NOT_ENOUGH_SPACE == ret) {
+      RCUTILS_SET_ERROR_MSG("the logging directory changed while getting it");
+      return RCL_LOGGING_RET_ERROR;
+    }
+  }
+  return ret;
 }
@@ -0,0 +1,33 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include <rcutils/logging.h>
+
+#include "rcl_logging_interface/rcl_logging_interface.h"
+
+int g_rcl_logging_external_severity_threshold = RCUTILS_LOG_SEVERITY_UNSET;
+
+void
+rcl_logging_external_set_severity_threshold(int severity)
+{
+#if defined(_MSC_VER)
+  _InterlockedExchange((volatile long *)&g_rcl_logging_external_severity_threshold, severity);
+#else
+  __atomic_store_n(&g_rcl_logging_external_severity_threshold, severity, __ATOMIC_RELAXED);
+#endif
+}
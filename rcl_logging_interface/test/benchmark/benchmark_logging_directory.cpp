@@ -0,0 +1,121 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rcutils/allocator.h>
+#include <rcutils/env.h>
+#include <rcutils/error_handling.h>
+#include <rcutils/macros.h>
+
+#include <rcl_logging_interface/rcl_logging_interface.h>
+
+#include <string>
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+
+using performance_test_fixture::PerformanceTest;
+
+namespace
+{
+enum LogDirSource
+{
+  kRosLogDir = 0,
+  kRosHome = 1,
+  kHome = 2,
+};
+
+std::string get_env(const char * name)
+{
+  const char * value = nullptr;
+  if (nullptr != rcutils_get_env(name, &value)) {
+    return "";
+  }
+  return value;
+}
+}  // namespace
+
+class LoggingDirectoryBenchmarkPerformance : public PerformanceTest
+{
+public:
+  void SetUp(benchmark::State & st)
+  {
+    orig_ros_log_dir_ = get_env("ROS_LOG_DIR");
+    orig_ros_home_ = get_env("ROS_HOME");
+    bool set = true;
+    switch (st.range(0)) {
+      case kRosLogDir:
+        set = rcutils_set_env("ROS_LOG_DIR", "/tmp/ros/log") && rcutils_set_env("ROS_HOME", "");
+        break;
+      case kRosHome:
+        set = rcutils_set_env("ROS_LOG_DIR", "") && rcutils_set_env("ROS_HOME", "~/ros_home");
+        break;
+      default:
+        set = rcutils_set_env("ROS_LOG_DIR", "") && rcutils_set_env("ROS_HOME", "");
+        break;
+    }
+    if (!set) {
+      st.SkipWithError("failed to set the environment");
+    }
+    PerformanceTest::SetUp(st);
+  }
+
+  void TearDown(benchmark::State & st)
+  {
+    PerformanceTest::TearDown(st);
+    if (!rcutils_set_env("ROS_LOG_DIR", orig_ros_log_dir_.c_str()) ||
+      !rcutils_set_env("ROS_HOME", orig_ros_home_.c_str()))
+    {
+      st.SkipWithError("failed to restore the environment");
+    }
+  }
+
+private:
+  std::string orig_ros_log_dir_;
+  std::string orig_ros_home_;
+};
+
+BENCHMARK_DEFINE_F(LoggingDirectoryBenchmarkPerformance, get_logging_directory)(
+  benchmark::State & st)
+{
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    char * directory = nullptr;
+    rcl_logging_ret_t ret = rcl_logging_get_logging_directory(allocator, &directory);
+    if (ret != RCL_LOGGING_RET_OK) {
+      st.SkipWithError(rcutils_get_error_string().str);
+      break;
+    }
+    allocator.deallocate(directory, allocator.state);
+  }
+}
+BENCHMARK_REGISTER_F(LoggingDirectoryBenchmarkPerformance, get_logging_directory)
+->ArgName("source")->Arg(kRosLogDir)->Arg(kRosHome)->Arg(kHome);
+
+BENCHMARK_DEFINE_F(LoggingDirectoryBenchmarkPerformance, get_logging_directory_to_buffer)(
+  benchmark::State & st)
+{
+  char buffer[4096];
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    rcl_logging_ret_t ret =
+      rcl_logging_get_logging_directory_to_buffer(buffer, sizeof(buffer), nullptr);
+    if (ret != RCL_LOGGING_RET_OK) {
+      st.SkipWithError(rcutils_get_error_string().str);
+      break;
+    }
+    benchmark::DoNotOptimize(buffer);
+  }
+}
+BENCHMARK_REGISTER_F(LoggingDirectoryBenchmarkPerformance, get_logging_directory_to_buffer)
+->ArgName("source")->Arg(kRosLogDir)->Arg(kRosHome)->Arg(kHome);
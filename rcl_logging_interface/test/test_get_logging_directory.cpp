@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstring>
 #include <filesystem>
 #include <iostream>
 #include <string>
@@ -182,3 +183,112 @@ TEST(test_logging_directory, directory)
 
   ASSERT_EQ(true, rcutils_set_env("ROS_HOME", nullptr));
 }
+
+TEST(test_logging_directory, directory_to_buffer)
+{
+  RestoreEnvVar home_var("HOME");
+  RestoreEnvVar userprofile_var("USERPROFILE");
+  RestoreEnvVar log_dir_var("ROS_LOG_DIR");
+  RestoreEnvVar ros_home_var("ROS_HOME");
+  ASSERT_EQ(true, rcutils_set_env("HOME", nullptr));
+  ASSERT_EQ(true, rcutils_set_env("USERPROFILE", nullptr));
+  ASSERT_EQ(true, rcutils_set_env("ROS_LOG_DIR", nullptr));
+  ASSERT_EQ(true, rcutils_set_env("ROS_HOME", nullptr));
+
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  char buffer[256];
+  size_t length = 0;
+
+  // Invalid argument if given a nullptr with room
+  EXPECT_EQ(
+    RCL_LOGGING_RET_INVALID_ARGUMENT,
+    rcl_logging_get_logging_directory_to_buffer(nullptr, sizeof(buffer), &length));
+  EXPECT_TRUE(rcutils_error_is_set());
+  rcutils_reset_error();
+
+  // Fails without any relevant env vars at all (HOME included)
+  EXPECT_EQ(
+    RCL_LOGGING_RET_ERROR,
+    rcl_logging_get_logging_directory_to_buffer(buffer, sizeof(buffer), &length));
+  EXPECT_TRUE(rcutils_error_is_set());
+  rcutils_reset_error();
+
+  // The same directories as the allocating version
+  std::filesystem::path fake_home("/fake_home_dir");
+  ASSERT_EQ(true, rcutils_set_env("HOME", fake_home.string().c_str()));
+  ASSERT_EQ(true, rcutils_set_env("USERPROFILE", fake_home.string().c_str()));
+  struct
+  {
+    const char * ros_log_dir;
+    const char * ros_home;
+    std::filesystem::path expected;
+  } cases[] = {
+    {nullptr, nullptr, fake_home / ".ros" / "log"},
+    {"/my/ros_log_dir", nullptr, "/my/ros_log_dir"},
+    {"/my/ros_log_dir", "/this/wont/be/used", "/my/ros_log_dir"},
+    {"~/logdir", nullptr, fake_home / "logdir"},
+    {"/prefix/~/logdir", nullptr, "/prefix/~/logdir"},
+    {"~", nullptr, fake_home},
+    {"", "/my/ros/home", std::filesystem::path("/my/ros/home") / "log"},
+    {nullptr, "~/.fakeroshome", fake_home / ".fakeroshome" / "log"},
+    {nullptr, "", fake_home / ".ros" / "log"},
+  };
+  for (auto & env : cases) {
+    ASSERT_EQ(true, rcutils_set_env("ROS_LOG_DIR", env.ros_log_dir));
+    ASSERT_EQ(true, rcutils_set_env("ROS_HOME", env.ros_home));
+    std::string expected = env.expected.make_preferred().string();
+    length = 0;
+    EXPECT_EQ(
+      RCL_LOGGING_RET_OK,
+      rcl_logging_get_logging_directory_to_buffer(buffer, sizeof(buffer), &length)) <<
+      expected;
+    EXPECT_EQ(expected, buffer);
+    EXPECT_EQ(expected.size(), length);
+  }
+
+  // Too long for the stack buffer of the allocating version
+  std::string long_dir = "/" + std::string(1000, 'x');
+  ASSERT_EQ(true, rcutils_set_env("ROS_LOG_DIR", long_dir.c_str()));
+  char * directory = nullptr;
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_get_logging_directory(allocator, &directory));
+  EXPECT_STREQ(
+    std::filesystem::path(long_dir).make_preferred().string().c_str(), directory);
+  allocator.deallocate(directory, allocator.state);
+}
+
+TEST(test_logging_directory, directory_to_buffer_not_enough_space)
+{
+  RestoreEnvVar log_dir_var("ROS_LOG_DIR");
+  ASSERT_EQ(true, rcutils_set_env("ROS_LOG_DIR", "/my/ros_log_dir"));
+  std::string expected = std::filesystem::path("/my/ros_log_dir").make_preferred().string();
+
+  // Just for the length, without an error
+  size_t length = 0;
+  EXPECT_EQ(
+    RCL_LOGGING_RET_NOT_ENOUGH_SPACE,
+    rcl_logging_get_logging_directory_to_buffer(nullptr, 0, &length));
+  EXPECT_EQ(expected.size(), length);
+  EXPECT_FALSE(rcutils_error_is_set());
+
+  // Nothing is written past a short buffer, and the length needed is still set
+  char buffer[32];
+  std::memset(buffer, 'x', sizeof(buffer));
+  for (size_t buffer_size : {size_t(1), size_t(8), expected.size()}) {
+    length = 0;
+    EXPECT_EQ(
+      RCL_LOGGING_RET_NOT_ENOUGH_SPACE,
+      rcl_logging_get_logging_directory_to_buffer(buffer, buffer_size, &length)) << buffer_size;
+    EXPECT_EQ(expected.size(), length);
+    EXPECT_FALSE(rcutils_error_is_set());
+    EXPECT_EQ('x', buffer[buffer_size]);
+  }
+  EXPECT_EQ(
+    RCL_LOGGING_RET_NOT_ENOUGH_SPACE,
+    rcl_logging_get_logging_directory_to_buffer(buffer, 8, nullptr));
+
+  // Just large enough
+  EXPECT_EQ(
+    RCL_LOGGING_RET_OK,
+    rcl_logging_get_logging_directory_to_buffer(buffer, expected.size() + 1, nullptr));
+  EXPECT_EQ(expected, buffer);
+}
@@ -14,6 +14,11 @@
 
 #include <rcl_logging_interface/rcl_logging_interface.h>
 #include <rcutils/allocator.h>
+#include <rcutils/error_handling.h>
+#include <rcutils/logging.h>
+
+#include <climits>
+#include <cstring>
 
 rcl_logging_ret_t rcl_logging_external_initialize(
   const char * file_name_prefix,
@@ -23,11 +28,14 @@ rcl_logging_ret_t rcl_logging_external_initialize(
   (void) file_name_prefix;
   (void) config_file;
   (void) allocator;
+  // Nothing is ever emitted, so callers can skip every message.
+  rcl_logging_external_set_severity_threshold(INT_MAX);
   return RCL_LOGGING_RET_OK;
 }
 
 rcl_logging_ret_t rcl_logging_external_shutdown()
 {
+  rcl_logging_external_set_severity_threshold(RCUTILS_LOG_SEVERITY_UNSET);
   return RCL_LOGGING_RET_OK;
 }
 
@@ -38,6 +46,60 @@ void rcl_logging_external_log(int severity, const char * name, const char * msg)
   (void) msg;
 }
 
+void rcl_logging_external_log_with_length(
+  int severity, const char * name, size_t name_length, const char * msg, size_t msg_length)
+{
+  (void) severity;
+  (void) name;
+  (void) name_length;
+  (void) msg;
+  (void) msg_length;
+}
+
+void rcl_logging_external_log_batch(const rcl_logging_record_t * records, size_t count)
+{
+  (void) records;
+  (void) count;
+}
+
+void rcl_logging_external_log_structured(const rcl_logging_structured_record_t * record)
+{
+  (void) record;
+}
+
+rcl_logging_ret_t rcl_logging_external_dump_flight_recorder()
+{
+  return RCL_LOGGING_RET_OK;
+}
+
+rcl_logging_ret_t rcl_logging_external_get_stats(rcl_logging_stats_t * stats)
+{
+  if (nullptr == stats) {
+    RCUTILS_SET_ERROR_MSG("stats argument must not be null");
+    return RCL_LOGGING_RET_INVALID_ARGUMENT;
+  }
+  std::memset(stats, 0, sizeof(*stats));
+  return RCL_LOGGING_RET_OK;
+}
+
+rcl_logging_ret_t rcl_logging_external_get_latency_histograms(
+  rcl_logging_latency_histograms_t * histograms)
+{
+  if (nullptr == histograms) {
+    RCUTILS_SET_ERROR_MSG("histograms argument must not be null");
+    return RCL_LOGGING_RET_INVALID_ARGUMENT;
+  }
+  std::memset(histograms, 0, sizeof(*histograms));
+  return RCL_LOGGING_RET_OK;
+}
+
+bool rcl_logging_external_is_enabled_for(const char * name, int severity)
+{
+  (void) name;
+  (void) severity;
+  return false;
+}
+
 rcl_logging_ret_t rcl_logging_external_set_logger_level(const char * name, int level)
 {
   (void) name;
@@ -0,0 +1,400 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+
+#include "rcpputils/scope_exit.hpp"
+
+#include "rcutils/allocator.h"
+#include "rcutils/env.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/logging.h"
+#include "rcutils/process.h"
+
+#include "rcl_logging_interface/rcl_logging_interface.h"
+
+#include "rcl_logging_shm/logger_levels.hpp"
+#include "rcl_logging_shm/ring.hpp"
+
+namespace
+{
+
+constexpr const char kRingSizeEnvVar[] = "RCL_LOGGING_SHM_RING_SIZE";
+constexpr size_t kDefaultRingSize = 1024 * 1024;
+
+std::mutex g_logger_mutex;
+// Owns the ring, only changed by initialize and shutdown under g_logger_mutex.
+std::unique_ptr<rcl_logging_shm::Ring> g_ring_owner;
+// The ring the logging functions write to, see RingUse.
+std::atomic<rcl_logging_shm::Ring *> g_ring{nullptr};
+// The number of clients which initialized logging and didn't shut it down yet.
+size_t g_initialize_count = 0;
+
+// spdlog's default level is info, so keep that as the default root level.
+rcl_logging_shm::LoggerLevels g_logger_levels(RCUTILS_LOG_SEVERITY_INFO);
+
+void publish_severity_threshold()
+{
+  rcl_logging_external_set_severity_threshold(g_logger_levels.get_minimum_level());
+}
+
+bool should_log(int severity, std::string_view name)
+{
+  return severity >= g_logger_levels.get_effective_level(name);
+}
+
+// Counts of messages per severity, and of calls using the ring, in shards so
+// that threads logging at once mostly don't write to the same cache line.
+struct alignas(64) CounterShard
+{
+  std::atomic<uint64_t> accepted[RCL_LOGGING_STATS_SEVERITY_COUNT];
+  std::atomic<uint64_t> filtered[RCL_LOGGING_STATS_SEVERITY_COUNT];
+  std::atomic<size_t> ring_users{0};
+};
+
+constexpr size_t kCounterShardCount = 16;
+CounterShard g_counter_shards[kCounterShardCount];
+std::atomic<size_t> g_next_counter_shard{0};
+std::atomic<uint64_t> g_bytes_written{0};
+
+CounterShard & counter_shard()
+{
+  thread_local size_t t_shard =
+    g_next_counter_shard.fetch_add(1, std::memory_order_relaxed) % kCounterShardCount;
+  return g_counter_shards[t_shard];
+}
+
+// Gets the ring for a call, and keeps shutdown from unmapping it until the
+// call is done with it.
+class RingUse final
+{
+public:
+  RingUse()
+  : shard_(counter_shard())
+  {
+    // Both sequentially consistent, like the store in shutdown: either
+    // shutdown sees this call counted, or this sees no ring.
+    shard_.ring_users.fetch_add(1, std::memory_order_seq_cst);
+    ring_ = g_ring.load(std::memory_order_seq_cst);
+  }
+
+  ~RingUse()
+  {
+    shard_.ring_users.fetch_sub(1, std::memory_order_release);
+  }
+
+  RingUse(const RingUse &) = delete;
+  RingUse & operator=(const RingUse &) = delete;
+
+  /// The ring, or null if logging isn't initialized.
+  rcl_logging_shm::Ring *
+  ring() const
+  {
+    return ring_;
+  }
+
+private:
+  CounterShard & shard_;
+  rcl_logging_shm::Ring * ring_;
+};
+
+// Take the ring away from the logging functions, and wait until none uses it.
+void wait_for_ring_users()
+{
+  g_ring.store(nullptr, std::memory_order_seq_cst);
+  for (const CounterShard & shard : g_counter_shards) {
+    while (0 != shard.ring_users.load(std::memory_order_acquire)) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+size_t severity_index(int severity)
+{
+  if (severity <= RCUTILS_LOG_SEVERITY_DEBUG) {
+    return RCL_LOGGING_STATS_SEVERITY_DEBUG;
+  } else if (severity <= RCUTILS_LOG_SEVERITY_INFO) {
+    return RCL_LOGGING_STATS_SEVERITY_INFO;
+  } else if (severity <= RCUTILS_LOG_SEVERITY_WARN) {
+    return RCL_LOGGING_STATS_SEVERITY_WARN;
+  } else if (severity <= RCUTILS_LOG_SEVERITY_ERROR) {
+    return RCL_LOGGING_STATS_SEVERITY_ERROR;
+  }
+  return RCL_LOGGING_STATS_SEVERITY_FATAL;
+}
+
+// Write a message which passed its logger's level to the ring, and count it.
+void write(
+  rcl_logging_shm::Ring & ring, int severity, int64_t timestamp_ns, std::string_view name,
+  std::string_view msg)
+{
+  CounterShard & shard = counter_shard();
+  shard.accepted[severity_index(severity)].fetch_add(1, std::memory_order_relaxed);
+  if (ring.write(severity, timestamp_ns, name, msg)) {
+    g_bytes_written.fetch_add(name.size() + msg.size(), std::memory_order_relaxed);
+  }
+}
+
+void count_filtered(int severity)
+{
+  counter_shard().filtered[severity_index(severity)].fetch_add(1, std::memory_order_relaxed);
+}
+
+int64_t now_ns()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+}  // namespace
+
+rcl_logging_ret_t rcl_logging_external_initialize(
+  const char * file_name_prefix,
+  const char * config_file,
+  rcutils_allocator_t allocator)
+{
+  RCUTILS_CHECK_ALLOCATOR(&allocator, return RCL_LOGGING_RET_INVALID_ARGUMENT);
+  // There is nothing to configure beyond the ring size.
+  (void) config_file;
+
+  std::lock_guard<std::mutex> lk(g_logger_mutex);
+  // It is possible for this to get called more than once in a process, e.g.
+  // by each rcl context. They all share the ring set up by the first one, and
+  // it is only closed once all of them shut down.
+  if (g_ring_owner != nullptr) {
+    ++g_initialize_count;
+    return RCL_LOGGING_RET_OK;
+  }
+
+  const char * ring_size_value = nullptr;
+  const char * get_env_error = rcutils_get_env(kRingSizeEnvVar, &ring_size_value);
+  if (nullptr != get_env_error) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "failed to get env var '%s': %s", kRingSizeEnvVar, get_env_error);
+    return RCL_LOGGING_RET_ERROR;
+  }
+  size_t ring_size = kDefaultRingSize;
+  if ('\0' != ring_size_value[0]) {
+    char * end = nullptr;
+    unsigned long long value = std::strtoull(ring_size_value, &end, 10);  // NOLINT
+    if (ring_size_value[0] < '0' || ring_size_value[0] > '9' || '\0' != *end ||
+      value < rcl_logging_shm::Ring::kMinCapacity || value > rcl_logging_shm::Ring::kMaxCapacity)
+    {
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "failed to get env var '%s': unrecognized value: %s", kRingSizeEnvVar, ring_size_value);
+      return RCL_LOGGING_RET_ERROR;
+    }
+    ring_size = static_cast<size_t>(value);
+  }
+
+  // The collector shows the process name next to the pid of every message.
+  std::string process_name;
+  if (nullptr != file_name_prefix && '\0' != file_name_prefix[0]) {
+    process_name = file_name_prefix;
+  } else {
+    char * executable_name = rcutils_get_executable_name(allocator);
+    if (nullptr == executable_name) {
+      RCUTILS_SET_ERROR_MSG("Failed to get the executable name");
+      return RCL_LOGGING_RET_ERROR;
+    }
+    RCPPUTILS_SCOPE_EXIT(
+    {
+      allocator.deallocate(executable_name, allocator.state);
+    });
+    process_name = executable_name;
+  }
+
+  int64_t pid = rcutils_get_pid();
+  // A process with the same pid before this one may have left its ring behind
+  // for the collector to drain, so tell the two apart.
+  auto nonce = static_cast<uint64_t>(
+    std::chrono::steady_clock::now().time_since_epoch().count());
+  try {
+    g_ring_owner = rcl_logging_shm::Ring::create(
+      rcl_logging_shm::ring_name(pid, nonce), ring_size, pid, process_name);
+  } catch (const std::system_error & error) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Failed to create the log ring: %s", error.what());
+    return RCL_LOGGING_RET_ERROR;
+  }
+
+  for (CounterShard & shard : g_counter_shards) {
+    for (size_t i = 0; i < RCL_LOGGING_STATS_SEVERITY_COUNT; ++i) {
+      shard.accepted[i].store(0, std::memory_order_relaxed);
+      shard.filtered[i].store(0, std::memory_order_relaxed);
+    }
+  }
+  g_bytes_written.store(0, std::memory_order_relaxed);
+
+  g_logger_levels.reset(RCUTILS_LOG_SEVERITY_INFO);
+  g_ring.store(g_ring_owner.get(), std::memory_order_seq_cst);
+  publish_severity_threshold();
+  g_initialize_count = 1;
+  return RCL_LOGGING_RET_OK;
+}
+
+rcl_logging_ret_t rcl_logging_external_shutdown()
+{
+  std::lock_guard<std::mutex> lk(g_logger_mutex);
+  if (g_initialize_count > 1) {
+    --g_initialize_count;
+    return RCL_LOGGING_RET_OK;
+  }
+  g_initialize_count = 0;
+  rcl_logging_external_set_severity_threshold(RCUTILS_LOG_SEVERITY_UNSET);
+  if (g_ring_owner != nullptr) {
+    // Nothing may write to the ring once it is closed and unmapped.
+    wait_for_ring_users();
+    g_ring_owner->close();
+    // With a collector attached, it drains what is left and removes the ring.
+    // Otherwise nobody would, so don't leave it behind.
+    if (!g_ring_owner->attached()) {
+      g_ring_owner->unlink();
+    }
+    g_ring_owner = nullptr;
+  }
+  return RCL_LOGGING_RET_OK;
+}
+
+void rcl_logging_external_log(int severity, const char * name, const char * msg)
+{
+  rcl_logging_external_log_with_length(
+    severity, name, nullptr == name ? 0 : std::strlen(name), msg, std::strlen(msg));
+}
+
+void rcl_logging_external_log_with_length(
+  int severity, const char * name, size_t name_length, const char * msg, size_t msg_length)
+{
+  std::string_view name_view(nullptr == name ? "" : name, name_length);
+  RingUse use;
+  if (nullptr == use.ring()) {
+    return;
+  }
+  if (!should_log(severity, name_view)) {
+    count_filtered(severity);
+    return;
+  }
+  write(*use.ring(), severity, now_ns(), name_view, std::string_view(msg, msg_length));
+}
+
+void rcl_logging_external_log_batch(const rcl_logging_record_t * records, size_t count)
+{
+  RingUse use;
+  if (nullptr == use.ring()) {
+    return;
+  }
+  int64_t timestamp_ns = now_ns();
+  for (size_t i = 0; i < count; ++i) {
+    const rcl_logging_record_t & record = records[i];
+    std::string_view name(nullptr == record.name ? "" : record.name, record.name_length);
+    if (should_log(record.severity, name)) {
+      write(
+        *use.ring(), record.severity, timestamp_ns, name,
+        std::string_view(record.msg, record.msg_length));
+    } else {
+      count_filtered(record.severity);
+    }
+  }
+}
+
+void rcl_logging_external_log_structured(const rcl_logging_structured_record_t * record)
+{
+  if (nullptr == record) {
+    return;
+  }
+  RingUse use;
+  if (nullptr == use.ring()) {
+    return;
+  }
+  std::string_view name(nullptr == record->name ? "" : record->name, record->name_length);
+  if (!should_log(record->severity, name)) {
+    count_filtered(record->severity);
+    return;
+  }
+  // The collector formats messages with their time stamp and severity already,
+  // there is no room in the ring for the source location.
+  write(
+    *use.ring(), record->severity, record->timestamp_ns, name,
+    std::string_view(record->msg, record->msg_length));
+}
+
+rcl_logging_ret_t rcl_logging_external_dump_flight_recorder()
+{
+  // Nothing is kept back, every message goes to the ring.
+  return RCL_LOGGING_RET_OK;
+}
+
+rcl_logging_ret_t rcl_logging_external_get_stats(rcl_logging_stats_t * stats)
+{
+  if (nullptr == stats) {
+    RCUTILS_SET_ERROR_MSG("stats argument must not be null");
+    return RCL_LOGGING_RET_INVALID_ARGUMENT;
+  }
+  *stats = rcl_logging_stats_t();
+  for (const CounterShard & shard : g_counter_shards) {
+    for (size_t i = 0; i < RCL_LOGGING_STATS_SEVERITY_COUNT; ++i) {
+      stats->accepted[i] += shard.accepted[i].load(std::memory_order_relaxed);
+      stats->filtered[i] += shard.filtered[i].load(std::memory_order_relaxed);
+    }
+  }
+  stats->bytes_written = g_bytes_written.load(std::memory_order_relaxed);
+  // The ring is never flushed, and holds bytes rather than a number of messages,
+  // so there is no flushing or queue depth to report.
+  RingUse use;
+  if (nullptr != use.ring()) {
+    stats->dropped = use.ring()->dropped();
+  }
+  return RCL_LOGGING_RET_OK;
+}
+
+rcl_logging_ret_t rcl_logging_external_get_latency_histograms(
+  rcl_logging_latency_histograms_t * histograms)
+{
+  if (nullptr == histograms) {
+    RCUTILS_SET_ERROR_MSG("histograms argument must not be null");
+    return RCL_LOGGING_RET_INVALID_ARGUMENT;
+  }
+  // Messages are written by the collector, this process doesn't see that.
+  *histograms = rcl_logging_latency_histograms_t();
+  return RCL_LOGGING_RET_OK;
+}
+
+bool rcl_logging_external_is_enabled_for(const char * name, int severity)
+{
+  RingUse use;
+  return nullptr != use.ring() &&
+         should_log(severity, nullptr == name ? std::string_view() : std::string_view(name));
+}
+
+rcl_logging_ret_t rcl_logging_external_set_logger_level(const char * name, int level)
+{
+  // Hold the lock so that concurrent calls publish their thresholds in the
+  // same order as they update the levels.
+  std::lock_guard<std::mutex> lock(g_logger_mutex);
+  g_logger_levels.set_level(name, level);
+  publish_severity_threshold();
+  return RCL_LOGGING_RET_OK;
+}
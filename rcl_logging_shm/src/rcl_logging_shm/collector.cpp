@@ -0,0 +1,191 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <signal.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cinttypes>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include "rcutils/logging.h"
+
+#include "rcl_logging_shm/collector.hpp"
+#include "rcl_logging_shm/ring.hpp"
+
+namespace rcl_logging_shm
+{
+
+namespace
+{
+
+bool
+process_alive(int64_t pid)
+{
+  return 0 == ::kill(static_cast<pid_t>(pid), 0) || EPERM == errno;
+}
+
+const char *
+severity_name(int severity)
+{
+  switch (severity) {
+    case RCUTILS_LOG_SEVERITY_DEBUG:
+      return "DEBUG";
+    case RCUTILS_LOG_SEVERITY_INFO:
+      return "INFO";
+    case RCUTILS_LOG_SEVERITY_WARN:
+      return "WARN";
+    case RCUTILS_LOG_SEVERITY_ERROR:
+      return "ERROR";
+    case RCUTILS_LOG_SEVERITY_FATAL:
+      return "FATAL";
+    default:
+      return nullptr;
+  }
+}
+
+}  // namespace
+
+Collector::Collector(FILE * output, std::string shm_dir)
+: output_(output),
+  shm_dir_(std::move(shm_dir))
+{
+}
+
+Collector::~Collector()
+{
+  for (auto & source : sources_) {
+    source.second.ring->detach();
+  }
+}
+
+size_t
+Collector::poll()
+{
+  discover();
+
+  size_t written = 0;
+  for (auto it = sources_.begin(); it != sources_.end(); ) {
+    Ring & ring = *it->second.ring;
+    // Checked before draining, so that whatever was written before the owner
+    // finished is drained below.
+    bool finished = ring.closed() || !process_alive(ring.pid());
+    written += ring.drain(
+      [this, &ring](const Record & record) {
+        write_line(ring, record.severity, record.timestamp_ns, record.name, record.msg);
+      });
+
+    uint64_t dropped = ring.dropped();
+    if (dropped != it->second.dropped_reported) {
+      auto now = std::chrono::system_clock::now().time_since_epoch();
+      write_line(
+        ring, RCUTILS_LOG_SEVERITY_WARN,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now).count(),
+        "rcl_logging_shm_collector",
+        std::to_string(dropped - it->second.dropped_reported) +
+        " messages were dropped because the ring was full");
+      it->second.dropped_reported = dropped;
+      ++written;
+    }
+
+    if (finished) {
+      ring.unlink();
+      it = sources_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  return written;
+}
+
+size_t
+Collector::ring_count() const
+{
+  return sources_.size();
+}
+
+void
+Collector::discover()
+{
+  std::error_code ec;
+  std::filesystem::directory_iterator entries(shm_dir_, ec);
+  if (ec) {
+    return;
+  }
+  for (const auto & entry : entries) {
+    std::string filename = entry.path().filename().string();
+    if (0 != filename.rfind(kRingNamePrefix, 0)) {
+      continue;
+    }
+    std::string name = "/" + filename;
+    if (sources_.count(name) > 0) {
+      continue;
+    }
+    std::unique_ptr<Ring> ring;
+    try {
+      ring = Ring::open(name);
+    } catch (const std::system_error &) {
+      // Most likely a ring of another user; retried on the next poll.
+      continue;
+    }
+    if (nullptr == ring) {
+      // Still being set up, retried on the next poll.
+      continue;
+    }
+    ring->attach();
+    sources_.emplace(name, Source{std::move(ring), 0});
+  }
+}
+
+void
+Collector::write_line(
+  const Ring & ring, int severity, int64_t timestamp_ns, std::string_view name,
+  std::string_view msg)
+{
+  // Room for the longest process name a ring holds, and the rest.
+  char prefix[256];
+  const char * severity_string = severity_name(severity);
+  char severity_number[16];
+  if (nullptr == severity_string) {
+    std::snprintf(severity_number, sizeof(severity_number), "%d", severity);
+    severity_string = severity_number;
+  }
+  std::string_view process_name = ring.process_name();
+  int prefix_length = std::snprintf(
+    prefix, sizeof(prefix), "[%s] [%" PRId64 ".%09" PRId64 "] [%.*s:%" PRId64 "] [",
+    severity_string, timestamp_ns / 1000000000, timestamp_ns % 1000000000,
+    static_cast<int>(process_name.size()), process_name.data(), ring.pid());
+
+  line_.clear();
+  if (prefix_length < 0) {
+    return;
+  }
+  line_.append(prefix, std::min(static_cast<size_t>(prefix_length), sizeof(prefix) - 1));
+  line_.append(name);
+  line_.append("]: ");
+  line_.append(msg);
+  line_.push_back('\n');
+  std::fwrite(line_.data(), 1, line_.size(), output_);
+}
+
+}  // namespace rcl_logging_shm
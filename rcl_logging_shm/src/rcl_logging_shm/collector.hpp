@@ -0,0 +1,89 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_LOGGING_SHM__COLLECTOR_HPP_
+#define RCL_LOGGING_SHM__COLLECTOR_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "rcl_logging_interface/visibility_control.h"
+
+#include "rcl_logging_shm/ring.hpp"
+
+namespace rcl_logging_shm
+{
+
+/// Drains the rings of every process on the host into a single text file.
+/**
+ * Rings are found by name in the directory where the system keeps its shared
+ * memory objects.
+ * Once the owner of a ring has shut logging down or died, the ring is drained
+ * one last time and its shared memory object removed.
+ *
+ * Each message becomes one line:
+ * "[SEVERITY] [seconds.nanoseconds] [process:pid] [logger]: message".
+ */
+class RCL_LOGGING_INTERFACE_LOCAL Collector final
+{
+public:
+  /// Create a collector writing to output, which it doesn't close.
+  explicit Collector(FILE * output, std::string shm_dir = "/dev/shm");
+
+  /// Let the owners of the rings still being drained clean up after themselves.
+  ~Collector();
+
+  Collector(const Collector &) = delete;
+  Collector & operator=(const Collector &) = delete;
+
+  /// Pick up new rings, drain them all, and retire those whose owner is done.
+  /**
+   * \return The number of lines written.
+   */
+  size_t
+  poll();
+
+  /// The number of rings currently being drained.
+  size_t
+  ring_count() const;
+
+private:
+  struct Source
+  {
+    std::unique_ptr<Ring> ring;
+    uint64_t dropped_reported;
+  };
+
+  void
+  discover();
+
+  void
+  write_line(
+    const Ring & ring, int severity, int64_t timestamp_ns, std::string_view name,
+    std::string_view msg);
+
+  FILE * output_;
+  std::string shm_dir_;
+  std::map<std::string, Source> sources_;
+  // Reused for every line so that steady state collecting doesn't allocate.
+  std::string line_;
+};
+
+}  // namespace rcl_logging_shm
+
+#endif  // RCL_LOGGING_SHM__COLLECTOR_HPP_
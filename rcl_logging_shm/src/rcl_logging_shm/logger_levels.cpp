@@ -0,0 +1,94 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+
+#include "rcutils/logging.h"
+
+#include "rcl_logging_shm/logger_levels.hpp"
+
+namespace rcl_logging_shm
+{
+
+LoggerLevels::LoggerLevels(int root_level)
+: root_level_(root_level), minimum_level_(root_level)
+{
+}
+
+void
+LoggerLevels::set_level(const char * name, int level)
+{
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  if (nullptr == name || '\0' == name[0]) {
+    root_level_.store(level, std::memory_order_relaxed);
+  } else if (RCUTILS_LOG_SEVERITY_UNSET == level) {
+    levels_.erase(name);
+  } else {
+    levels_[name] = level;
+  }
+  publish();
+}
+
+int
+LoggerLevels::get_effective_level(std::string_view name) const
+{
+  if (name.empty() || !have_logger_levels_.load(std::memory_order_acquire)) {
+    return root_level_.load(std::memory_order_relaxed);
+  }
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  while (true) {
+    auto it = levels_.find(name);
+    if (it != levels_.end()) {
+      return it->second;
+    }
+    size_t separator = name.rfind('.');
+    if (std::string_view::npos == separator) {
+      return root_level_.load(std::memory_order_relaxed);
+    }
+    name = name.substr(0, separator);
+  }
+}
+
+int
+LoggerLevels::get_minimum_level() const
+{
+  return minimum_level_.load(std::memory_order_relaxed);
+}
+
+void
+LoggerLevels::reset(int root_level)
+{
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  root_level_.store(root_level, std::memory_order_relaxed);
+  levels_.clear();
+  publish();
+}
+
+void
+LoggerLevels::publish()
+{
+  int minimum_level = root_level_.load(std::memory_order_relaxed);
+  for (const auto & logger_level : levels_) {
+    minimum_level = std::min(minimum_level, logger_level.second);
+  }
+  have_logger_levels_.store(!levels_.empty(), std::memory_order_release);
+  minimum_level_.store(minimum_level, std::memory_order_relaxed);
+}
+
+}  // namespace rcl_logging_shm
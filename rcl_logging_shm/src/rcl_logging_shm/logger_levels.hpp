@@ -0,0 +1,81 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_LOGGING_SHM__LOGGER_LEVELS_HPP_
+#define RCL_LOGGING_SHM__LOGGER_LEVELS_HPP_
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+
+#include "rcl_logging_interface/visibility_control.h"
+
+namespace rcl_logging_shm
+{
+
+/// Severity thresholds for named loggers, with hierarchical inheritance.
+/**
+ * A logger without a level of its own inherits that of its closest
+ * '.'-separated ancestor, falling back to the root level.
+ *
+ * Lookups share a lock which setting a level takes exclusively.
+ * Levels of individual loggers are rare, and without any the root level is
+ * read without taking the lock.
+ */
+class RCL_LOGGING_INTERFACE_LOCAL LoggerLevels final
+{
+public:
+  explicit LoggerLevels(int root_level);
+
+  LoggerLevels(const LoggerLevels &) = delete;
+  LoggerLevels & operator=(const LoggerLevels &) = delete;
+
+  /// Set the level of a logger, or of the root logger for a NULL or empty name.
+  /**
+   * Setting a named logger to RCUTILS_LOG_SEVERITY_UNSET removes its level,
+   * so that it inherits from its ancestors again.
+   */
+  void
+  set_level(const char * name, int level);
+
+  /// Get the level that applies to a logger, safe to call concurrently with set_level().
+  int
+  get_effective_level(std::string_view name) const;
+
+  /// Get the lowest level set on any logger, including the root logger.
+  int
+  get_minimum_level() const;
+
+  /// Drop all per-logger levels and set the root level.
+  void
+  reset(int root_level);
+
+private:
+  // Update the atomics read without the lock, with it held exclusively.
+  void
+  publish();
+
+  mutable std::shared_mutex mutex_;
+  std::map<std::string, int, std::less<>> levels_;
+  std::atomic<int> root_level_;
+  std::atomic<bool> have_logger_levels_{false};
+  std::atomic<int> minimum_level_;
+};
+
+}  // namespace rcl_logging_shm
+
+#endif  // RCL_LOGGING_SHM__LOGGER_LEVELS_HPP_
@@ -0,0 +1,379 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include "rcl_logging_shm/ring.hpp"
+
+namespace rcl_logging_shm
+{
+
+namespace
+{
+
+constexpr uint32_t kMagic = 0x52434c52;  // "RCLR"
+constexpr uint32_t kVersion = 1;
+
+// Set in the size word of the filler at the end of the buffer, which isn't a record.
+constexpr uint32_t kPaddingFlag = 0x80000000u;
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "shared atomics must be lock free");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared atomics must be lock free");
+
+struct RecordHeader
+{
+  // Zero until the record is published.
+  std::atomic<uint32_t> size;
+  int32_t severity;
+  int64_t timestamp_ns;
+  uint32_t name_length;
+  uint32_t msg_length;
+};
+
+constexpr uint64_t
+align_record(uint64_t size)
+{
+  return (size + 7) & ~uint64_t(7);
+}
+
+std::atomic<uint32_t> *
+size_word(char * data, uint64_t offset)
+{
+  return reinterpret_cast<std::atomic<uint32_t> *>(data + offset);
+}
+
+[[noreturn]] void
+throw_system_error(const std::string & what)
+{
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+}  // namespace
+
+struct Ring::Header
+{
+  // Stored last when creating, so a consumer never sees a half set up ring.
+  std::atomic<uint32_t> magic;
+  uint32_t version;
+  uint64_t capacity;
+  int64_t pid;
+  char process_name[64];
+  std::atomic<uint32_t> closed;
+  std::atomic<uint32_t> attached;
+  std::atomic<uint64_t> dropped;
+  // Producers and the consumer each get a cache line of their own.
+  alignas(64) std::atomic<uint64_t> write_position;
+  alignas(64) std::atomic<uint64_t> read_position;
+};
+
+const size_t Ring::kDataOffset = (sizeof(Ring::Header) + 63) / 64 * 64;
+
+std::string
+ring_name(int64_t pid, uint64_t nonce)
+{
+  return "/" + std::string(kRingNamePrefix) + std::to_string(pid) + "." + std::to_string(nonce);
+}
+
+std::unique_ptr<Ring>
+Ring::create(
+  const std::string & name, size_t capacity, int64_t pid, std::string_view process_name)
+{
+  uint64_t rounded_capacity = kMinCapacity;
+  while (rounded_capacity < capacity && rounded_capacity < kMaxCapacity) {
+    rounded_capacity *= 2;
+  }
+
+  // Never take over an existing object, it may be the ring of a live process.
+  int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd < 0) {
+    throw_system_error("Failed creating shared memory object " + name);
+  }
+  size_t mapping_size = kDataOffset + rounded_capacity;
+  struct stat status;
+  if (0 != ::fstat(fd, &status) || 0 != ::ftruncate(fd, static_cast<off_t>(mapping_size))) {
+    int error = errno;
+    ::close(fd);
+    ::shm_unlink(name.c_str());
+    errno = error;
+    throw_system_error("Failed sizing shared memory object " + name);
+  }
+  void * mapping = ::mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  int error = errno;
+  // The mapping keeps the object alive.
+  ::close(fd);
+  if (MAP_FAILED == mapping) {
+    ::shm_unlink(name.c_str());
+    errno = error;
+    throw_system_error("Failed mapping shared memory object " + name);
+  }
+
+  // A new object reads as zeroes, which is how every field starts out.
+  std::unique_ptr<Ring> ring(
+    new Ring(
+      name, mapping, mapping_size, static_cast<uint64_t>(status.st_dev),
+      static_cast<uint64_t>(status.st_ino)));
+  Header * header = ring->header_;
+  header->version = kVersion;
+  header->capacity = rounded_capacity;
+  header->pid = pid;
+  process_name = process_name.substr(0, sizeof(header->process_name) - 1);
+  std::memcpy(header->process_name, process_name.data(), process_name.size());
+  header->magic.store(kMagic, std::memory_order_release);
+  ring->capacity_ = rounded_capacity;
+  return ring;
+}
+
+std::unique_ptr<Ring>
+Ring::open(const std::string & name)
+{
+  int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+  if (fd < 0) {
+    if (ENOENT == errno) {
+      return nullptr;
+    }
+    throw_system_error("Failed opening shared memory object " + name);
+  }
+  struct stat status;
+  if (0 != ::fstat(fd, &status)) {
+    int error = errno;
+    ::close(fd);
+    errno = error;
+    throw_system_error("Failed getting the size of shared memory object " + name);
+  }
+  size_t mapping_size = static_cast<size_t>(status.st_size);
+  if (mapping_size < kDataOffset + kMinCapacity) {
+    ::close(fd);
+    return nullptr;
+  }
+  void * mapping = ::mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  int error = errno;
+  ::close(fd);
+  if (MAP_FAILED == mapping) {
+    errno = error;
+    throw_system_error("Failed mapping shared memory object " + name);
+  }
+
+  std::unique_ptr<Ring> ring(
+    new Ring(
+      name, mapping, mapping_size, static_cast<uint64_t>(status.st_dev),
+      static_cast<uint64_t>(status.st_ino)));
+  const Header * header = ring->header_;
+  if (kMagic != header->magic.load(std::memory_order_acquire) || kVersion != header->version) {
+    return nullptr;
+  }
+  uint64_t capacity = header->capacity;
+  if (capacity < kMinCapacity || 0 != (capacity & (capacity - 1)) ||
+    kDataOffset + capacity > mapping_size)
+  {
+    return nullptr;
+  }
+  ring->capacity_ = capacity;
+  return ring;
+}
+
+Ring::Ring(
+  std::string name, void * mapping, size_t mapping_size, uint64_t device, uint64_t inode)
+: name_(std::move(name)),
+  mapping_(mapping),
+  mapping_size_(mapping_size),
+  header_(static_cast<Header *>(mapping)),
+  data_(static_cast<char *>(mapping) + kDataOffset),
+  capacity_(0),
+  device_(device),
+  inode_(inode)
+{
+}
+
+Ring::~Ring()
+{
+  ::munmap(mapping_, mapping_size_);
+}
+
+bool
+Ring::write(int severity, int64_t timestamp_ns, std::string_view name, std::string_view msg)
+{
+  size_t max_payload = static_cast<size_t>(capacity_ / 4) - sizeof(RecordHeader);
+  name = name.substr(0, std::min(name.size(), max_payload));
+  msg = msg.substr(0, std::min(msg.size(), max_payload - name.size()));
+  uint64_t size = align_record(sizeof(RecordHeader) + name.size() + msg.size());
+
+  uint64_t position = header_->write_position.load(std::memory_order_relaxed);
+  uint64_t offset;
+  uint64_t padding;
+  do {
+    offset = position & (capacity_ - 1);
+    padding = offset + size > capacity_ ? capacity_ - offset : 0;
+    // Acquire, so that the consumer zeroing the space happens before it is reused.
+    uint64_t read_position = header_->read_position.load(std::memory_order_acquire);
+    if (position + padding + size - read_position > capacity_) {
+      header_->dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+  } while (!header_->write_position.compare_exchange_weak(
+    position, position + padding + size, std::memory_order_relaxed));
+
+  if (padding > 0) {
+    size_word(data_, offset)->store(
+      static_cast<uint32_t>(padding) | kPaddingFlag, std::memory_order_release);
+    offset = 0;
+  }
+  auto record = reinterpret_cast<RecordHeader *>(data_ + offset);
+  record->severity = severity;
+  record->timestamp_ns = timestamp_ns;
+  record->name_length = static_cast<uint32_t>(name.size());
+  record->msg_length = static_cast<uint32_t>(msg.size());
+  char * payload = data_ + offset + sizeof(RecordHeader);
+  std::memcpy(payload, name.data(), name.size());
+  std::memcpy(payload + name.size(), msg.data(), msg.size());
+  record->size.store(static_cast<uint32_t>(size), std::memory_order_release);
+  return true;
+}
+
+void
+Ring::close()
+{
+  header_->closed.store(1, std::memory_order_release);
+}
+
+void
+Ring::attach()
+{
+  header_->attached.store(1, std::memory_order_release);
+}
+
+void
+Ring::detach()
+{
+  header_->attached.store(0, std::memory_order_release);
+}
+
+size_t
+Ring::drain(const std::function<void(const Record &)> & callback)
+{
+  uint64_t start = header_->read_position.load(std::memory_order_relaxed);
+  uint64_t position = start;
+  size_t count = 0;
+  while (true) {
+    uint64_t offset = position & (capacity_ - 1);
+    uint32_t word = size_word(data_, offset)->load(std::memory_order_acquire);
+    uint64_t size = word & ~kPaddingFlag;
+    if (0 == size || 0 != size % 8 || offset + size > capacity_) {
+      // Not published yet, or nonsense from a producer which died halfway.
+      break;
+    }
+    if (0 == (word & kPaddingFlag)) {
+      auto record = reinterpret_cast<const RecordHeader *>(data_ + offset);
+      if (size < sizeof(RecordHeader) ||
+        sizeof(RecordHeader) + uint64_t(record->name_length) + record->msg_length > size)
+      {
+        break;
+      }
+      const char * payload = data_ + offset + sizeof(RecordHeader);
+      callback(
+        Record{
+          record->severity, record->timestamp_ns,
+          std::string_view(payload, record->name_length),
+          std::string_view(payload + record->name_length, record->msg_length)});
+      ++count;
+    }
+    // The next record to start here may be published in a later lap, so
+    // nothing of this one may be left to be mistaken for its size.
+    std::memset(data_ + offset, 0, size);
+    position += size;
+  }
+  if (position != start) {
+    header_->read_position.store(position, std::memory_order_release);
+  }
+  return count;
+}
+
+void
+Ring::unlink()
+{
+  int fd = ::shm_open(name_.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    // Someone else having removed it already is fine.
+    return;
+  }
+  struct stat status;
+  bool same_object = 0 == ::fstat(fd, &status) &&
+    device_ == static_cast<uint64_t>(status.st_dev) &&
+    inode_ == static_cast<uint64_t>(status.st_ino);
+  ::close(fd);
+  if (same_object) {
+    ::shm_unlink(name_.c_str());
+  }
+}
+
+const std::string &
+Ring::name() const
+{
+  return name_;
+}
+
+int64_t
+Ring::pid() const
+{
+  return header_->pid;
+}
+
+std::string_view
+Ring::process_name() const
+{
+  return std::string_view(
+    header_->process_name, strnlen(header_->process_name, sizeof(header_->process_name)));
+}
+
+bool
+Ring::attached() const
+{
+  return 0 != header_->attached.load(std::memory_order_acquire);
+}
+
+bool
+Ring::closed() const
+{
+  return 0 != header_->closed.load(std::memory_order_acquire);
+}
+
+bool
+Ring::empty() const
+{
+  return header_->read_position.load(std::memory_order_acquire) ==
+         header_->write_position.load(std::memory_order_acquire);
+}
+
+uint64_t
+Ring::dropped() const
+{
+  return header_->dropped.load(std::memory_order_relaxed);
+}
+
+}  // namespace rcl_logging_shm
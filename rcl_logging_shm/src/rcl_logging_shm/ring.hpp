@@ -0,0 +1,178 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_LOGGING_SHM__RING_HPP_
+#define RCL_LOGGING_SHM__RING_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "rcl_logging_interface/visibility_control.h"
+
+namespace rcl_logging_shm
+{
+
+/// Every ring is a shared memory object named kRingNamePrefix followed by the pid and a nonce.
+constexpr const char kRingNamePrefix[] = "rcl_logging_shm.";
+
+/// Get the name of the shared memory object holding a ring of a process.
+/**
+ * The nonce tells apart the rings of processes which got the same pid one
+ * after the other, and of a process which initialized logging again.
+ */
+RCL_LOGGING_INTERFACE_LOCAL
+std::string
+ring_name(int64_t pid, uint64_t nonce);
+
+/// A message as read back from a ring.
+struct Record
+{
+  int severity;
+  int64_t timestamp_ns;
+  std::string_view name;
+  std::string_view msg;
+};
+
+/// A ring buffer of log records in POSIX shared memory.
+/**
+ * Each process logging through this backend owns one ring, and any number of
+ * its threads append to it without taking a lock: a producer reserves space by
+ * advancing the write position with a compare-and-swap, copies its record in,
+ * and then publishes it by storing the size of the record in its first word.
+ * A single consumer, the collector, reads published records in order and
+ * zeroes them before handing the space back through the read position.
+ *
+ * A record never wraps around the end of the buffer; a producer which would
+ * have to pads to the end and starts over at the beginning.
+ * When the ring is full, records are dropped and counted rather than waiting
+ * for the consumer.
+ */
+class RCL_LOGGING_INTERFACE_LOCAL Ring final
+{
+public:
+  /// The smallest and largest capacities a ring can have.
+  static constexpr size_t kMinCapacity = 4096;
+  static constexpr size_t kMaxCapacity = size_t(1) << 30;
+
+  /// Create a ring for this process.
+  /**
+   * \param[in] name The name of the shared memory object.
+   * \param[in] capacity The size of the buffer, rounded up to a power of two.
+   * \param[in] pid The id of the owning process, for the consumer.
+   * \param[in] process_name A name for the owning process, for the consumer.
+   * \throws std::system_error if the shared memory object can't be set up, or
+   *   already exists.
+   */
+  static std::unique_ptr<Ring>
+  create(const std::string & name, size_t capacity, int64_t pid, std::string_view process_name);
+
+  /// Open the ring of another process, to drain it.
+  /**
+   * \return The ring, or nullptr if the object isn't a complete ring (yet).
+   * \throws std::system_error if the shared memory object can't be opened.
+   */
+  static std::unique_ptr<Ring>
+  open(const std::string & name);
+
+  /// Unmap the ring, leaving the shared memory object in place.
+  ~Ring();
+
+  Ring(const Ring &) = delete;
+  Ring & operator=(const Ring &) = delete;
+
+  /// Append a record, safe to call from any number of threads.
+  /**
+   * Names and messages too long for a quarter of the ring are truncated.
+   * \return false if the record was dropped because the ring is full.
+   */
+  bool
+  write(int severity, int64_t timestamp_ns, std::string_view name, std::string_view msg);
+
+  /// Tell the consumer that no more records will be written.
+  void
+  close();
+
+  /// Tell the producer that a consumer is draining the ring.
+  void
+  attach();
+
+  /// Tell the producer that the consumer stopped, so it should clean up after itself.
+  void
+  detach();
+
+  /// Hand every published record to callback in order, then free their space.
+  /**
+   * Only one thread in one process may drain a ring.
+   * \return The number of records drained.
+   */
+  size_t
+  drain(const std::function<void(const Record &)> & callback);
+
+  /// Remove the name of the shared memory object, it goes away once unmapped everywhere.
+  /**
+   * Nothing is removed if the name meanwhile refers to a different object than
+   * the one mapped here.
+   */
+  void
+  unlink();
+
+  const std::string &
+  name() const;
+
+  int64_t
+  pid() const;
+
+  std::string_view
+  process_name() const;
+
+  bool
+  attached() const;
+
+  bool
+  closed() const;
+
+  /// Whether every reserved record has been drained.
+  bool
+  empty() const;
+
+  /// The number of records dropped so far because the ring was full.
+  uint64_t
+  dropped() const;
+
+private:
+  struct Header;
+
+  // Where the records start, after the header.
+  static const size_t kDataOffset;
+
+  Ring(std::string name, void * mapping, size_t mapping_size, uint64_t device, uint64_t inode);
+
+  std::string name_;
+  void * mapping_;
+  size_t mapping_size_;
+  Header * header_;
+  char * data_;
+  uint64_t capacity_;
+  // Which object the name referred to when mapped.
+  uint64_t device_;
+  uint64_t inode_;
+};
+
+}  // namespace rcl_logging_shm
+
+#endif  // RCL_LOGGING_SHM__RING_HPP_
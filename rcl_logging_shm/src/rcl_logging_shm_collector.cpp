@@ -0,0 +1,137 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Drains the log rings of every process logging through rcl_logging_shm into
+// a single file, until interrupted.
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#include "rcutils/allocator.h"
+#include "rcutils/process.h"
+
+#include "rcl_logging_interface/rcl_logging_interface.h"
+
+#include "rcl_logging_shm/collector.hpp"
+
+namespace
+{
+
+std::atomic<bool> g_stop{false};
+
+void
+handle_signal(int)
+{
+  g_stop = true;
+}
+
+void
+print_usage(const char * program)
+{
+  std::fprintf(
+    stderr,
+    "usage: %s [--output-dir DIR] [--poll-interval-ms N] [--once]\n"
+    "\n"
+    "Writes the messages of every process logging through rcl_logging_shm to\n"
+    "DIR/rcl_logging_shm_collector_<pid>_<milliseconds-since-epoch>.log.\n"
+    "\n"
+    "  --output-dir DIR       where to write the log file (default: the ROS log directory)\n"
+    "  --poll-interval-ms N   how often to drain the rings (default: 10)\n"
+    "  --once                 drain the rings once and exit\n",
+    program);
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  std::string output_dir;
+  long poll_interval_ms = 10;  // NOLINT(runtime/int)
+  bool once = false;
+  for (int i = 1; i < argc; ++i) {
+    if (0 == std::strcmp(argv[i], "--output-dir") && i + 1 < argc) {
+      output_dir = argv[++i];
+    } else if (0 == std::strcmp(argv[i], "--poll-interval-ms") && i + 1 < argc) {
+      char * end = nullptr;
+      poll_interval_ms = std::strtol(argv[++i], &end, 10);
+      if ('\0' != *end || poll_interval_ms <= 0) {
+        print_usage(argv[0]);
+        return 1;
+      }
+    } else if (0 == std::strcmp(argv[i], "--once")) {
+      once = true;
+    } else {
+      print_usage(argv[0]);
+      return 1;
+    }
+  }
+
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  if (output_dir.empty()) {
+    char * logdir = nullptr;
+    if (RCL_LOGGING_RET_OK != rcl_logging_get_logging_directory(allocator, &logdir)) {
+      std::fprintf(stderr, "Failed to get the logging directory\n");
+      return 1;
+    }
+    output_dir = logdir;
+    allocator.deallocate(logdir, allocator.state);
+  }
+  std::error_code ec;
+  std::filesystem::create_directories(output_dir, ec);
+  if (ec) {
+    std::fprintf(
+      stderr, "Failed to create directory %s: %s\n", output_dir.c_str(), ec.message().c_str());
+    return 1;
+  }
+
+  auto now = std::chrono::system_clock::now().time_since_epoch();
+  std::filesystem::path filename = std::filesystem::path(output_dir) /
+    ("rcl_logging_shm_collector_" + std::to_string(rcutils_get_pid()) + "_" +
+    std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(now).count()) + ".log");
+  FILE * file = std::fopen(filename.string().c_str(), "a");
+  if (nullptr == file) {
+    std::fprintf(
+      stderr, "Failed to open %s: %s\n", filename.string().c_str(), std::strerror(errno));
+    return 1;
+  }
+  // Every poll ends up as a few large writes rather than one per message.
+  std::setvbuf(file, nullptr, _IOFBF, 1024 * 1024);
+
+  std::signal(SIGINT, handle_signal);
+  std::signal(SIGTERM, handle_signal);
+
+  {
+    rcl_logging_shm::Collector collector(file);
+    while (true) {
+      if (collector.poll() > 0) {
+        std::fflush(file);
+      }
+      if (once || g_stop) {
+        break;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(poll_interval_ms));
+    }
+  }
+  std::fclose(file);
+  return 0;
+}
@@ -0,0 +1,514 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "rcpputils/env.hpp"
+#include "rcpputils/scope_exit.hpp"
+
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/logging.h"
+
+#include "rcl_logging_interface/rcl_logging_interface.h"
+
+#include "rcl_logging_shm/collector.hpp"
+#include "rcl_logging_shm/ring.hpp"
+
+using rcl_logging_shm::Record;
+using rcl_logging_shm::Ring;
+
+namespace
+{
+
+struct DrainedRecord
+{
+  int severity;
+  int64_t timestamp_ns;
+  std::string name;
+  std::string msg;
+};
+
+std::vector<DrainedRecord> drain(Ring & ring)
+{
+  std::vector<DrainedRecord> records;
+  ring.drain(
+    [&records](const Record & record) {
+      records.push_back(
+        {record.severity, record.timestamp_ns, std::string(record.name),
+          std::string(record.msg)});
+    });
+  return records;
+}
+
+std::string read_file(const std::filesystem::path & path)
+{
+  std::ifstream file(path, std::ios::binary);
+  std::stringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+}  // namespace
+
+class RingTest : public ::testing::Test
+{
+public:
+  void SetUp() override
+  {
+    // Not a name the collector picks up.
+    name = "/rcl_logging_shm_test." + std::to_string(getpid());
+  }
+
+  void TearDown() override
+  {
+    std::unique_ptr<Ring> ring = Ring::open(name);
+    if (nullptr != ring) {
+      ring->unlink();
+    }
+  }
+
+  std::string name;
+};
+
+TEST_F(RingTest, write_and_drain)
+{
+  std::unique_ptr<Ring> producer = Ring::create(name, 4096, 1234, "process");
+  std::unique_ptr<Ring> consumer = Ring::open(name);
+  ASSERT_NE(nullptr, consumer);
+  EXPECT_EQ(1234, consumer->pid());
+  EXPECT_EQ("process", consumer->process_name());
+  EXPECT_TRUE(consumer->empty());
+
+  EXPECT_TRUE(producer->write(RCUTILS_LOG_SEVERITY_INFO, 1, "a.b", "first"));
+  EXPECT_TRUE(producer->write(RCUTILS_LOG_SEVERITY_ERROR, 2, "", "second"));
+  EXPECT_TRUE(producer->write(RCUTILS_LOG_SEVERITY_DEBUG, 3, "c", ""));
+  EXPECT_FALSE(consumer->empty());
+
+  std::vector<DrainedRecord> records = drain(*consumer);
+  ASSERT_EQ(3u, records.size());
+  EXPECT_EQ(RCUTILS_LOG_SEVERITY_INFO, records[0].severity);
+  EXPECT_EQ(1, records[0].timestamp_ns);
+  EXPECT_EQ("a.b", records[0].name);
+  EXPECT_EQ("first", records[0].msg);
+  EXPECT_EQ(RCUTILS_LOG_SEVERITY_ERROR, records[1].severity);
+  EXPECT_EQ("", records[1].name);
+  EXPECT_EQ("second", records[1].msg);
+  EXPECT_EQ("c", records[2].name);
+  EXPECT_EQ("", records[2].msg);
+  EXPECT_TRUE(consumer->empty());
+  EXPECT_TRUE(drain(*consumer).empty());
+
+  EXPECT_FALSE(consumer->closed());
+  producer->close();
+  EXPECT_TRUE(consumer->closed());
+}
+
+TEST_F(RingTest, unlink_only_own_object)
+{
+  std::unique_ptr<Ring> producer = Ring::create(name, 4096, 1, "process");
+  std::unique_ptr<Ring> consumer = Ring::open(name);
+  ASSERT_NE(nullptr, consumer);
+  EXPECT_THROW(Ring::create(name, 4096, 2, "other"), std::system_error);
+
+  // The name is taken over once the first object is gone
+  producer->unlink();
+  std::unique_ptr<Ring> reused = Ring::create(name, 4096, 2, "other");
+  consumer->unlink();
+  std::unique_ptr<Ring> reopened = Ring::open(name);
+  ASSERT_NE(nullptr, reopened);
+  EXPECT_EQ(2, reopened->pid());
+}
+
+TEST_F(RingTest, wrap_around)
+{
+  std::unique_ptr<Ring> producer = Ring::create(name, 4096, 1, "process");
+  std::unique_ptr<Ring> consumer = Ring::open(name);
+  ASSERT_NE(nullptr, consumer);
+
+  // Sizes that don't divide the capacity, so records end up padded at the end
+  int next_expected = 0;
+  for (int i = 0; i < 2000; ++i) {
+    std::string msg = std::to_string(i) + std::string(static_cast<size_t>(i % 97), 'x');
+    ASSERT_TRUE(producer->write(RCUTILS_LOG_SEVERITY_INFO, i, "name", msg)) << i;
+    if (i % 7 == 0) {
+      for (const DrainedRecord & record : drain(*consumer)) {
+        EXPECT_EQ(next_expected, record.timestamp_ns);
+        EXPECT_EQ(
+          std::to_string(next_expected) +
+          std::string(static_cast<size_t>(next_expected % 97), 'x'), record.msg);
+        ++next_expected;
+      }
+    }
+  }
+  next_expected += static_cast<int>(drain(*consumer).size());
+  EXPECT_EQ(2000, next_expected);
+  EXPECT_EQ(0u, producer->dropped());
+}
+
+TEST_F(RingTest, drops_when_full)
+{
+  std::unique_ptr<Ring> producer = Ring::create(name, 4096, 1, "process");
+  std::unique_ptr<Ring> consumer = Ring::open(name);
+  ASSERT_NE(nullptr, consumer);
+
+  size_t written = 0;
+  while (producer->write(RCUTILS_LOG_SEVERITY_INFO, 0, "name", std::string(100, 'x'))) {
+    ++written;
+  }
+  EXPECT_GT(written, 0u);
+  EXPECT_EQ(1u, consumer->dropped());
+  EXPECT_EQ(written, drain(*consumer).size());
+  EXPECT_TRUE(producer->write(RCUTILS_LOG_SEVERITY_INFO, 0, "name", "room again"));
+}
+
+TEST_F(RingTest, truncates_long_messages)
+{
+  std::unique_ptr<Ring> producer = Ring::create(name, 4096, 1, "process");
+  std::unique_ptr<Ring> consumer = Ring::open(name);
+  ASSERT_NE(nullptr, consumer);
+
+  std::string msg(10000, 'x');
+  EXPECT_TRUE(producer->write(RCUTILS_LOG_SEVERITY_INFO, 0, "name", msg));
+  std::vector<DrainedRecord> records = drain(*consumer);
+  ASSERT_EQ(1u, records.size());
+  EXPECT_EQ("name", records[0].name);
+  EXPECT_LT(records[0].msg.size(), 1024u);
+  EXPECT_EQ(0u, msg.find(records[0].msg));
+}
+
+TEST_F(RingTest, concurrent_producers)
+{
+  std::unique_ptr<Ring> producer = Ring::create(name, 64 * 1024, 1, "process");
+  std::unique_ptr<Ring> consumer = Ring::open(name);
+  ASSERT_NE(nullptr, consumer);
+
+  constexpr int kThreads = 4;
+  constexpr int kRecordsPerThread = 20000;
+  std::atomic<int> producers_done{0};
+  std::vector<std::thread> threads;
+  for (int thread = 0; thread < kThreads; ++thread) {
+    threads.emplace_back(
+      [&, thread]() {
+        std::string logger_name = "thread" + std::to_string(thread);
+        for (int i = 0; i < kRecordsPerThread; ++i) {
+          producer->write(thread, i, logger_name, "message " + std::to_string(i));
+        }
+        ++producers_done;
+      });
+  }
+
+  // Records of each thread arrive in order, and intact
+  std::vector<int64_t> last(kThreads, -1);
+  size_t drained = 0;
+  auto check = [&](const Record & record) {
+      ASSERT_GE(record.severity, 0);
+      ASSERT_LT(record.severity, kThreads);
+      EXPECT_EQ("thread" + std::to_string(record.severity), record.name);
+      EXPECT_EQ("message " + std::to_string(record.timestamp_ns), record.msg);
+      EXPECT_GT(record.timestamp_ns, last[static_cast<size_t>(record.severity)]);
+      last[static_cast<size_t>(record.severity)] = record.timestamp_ns;
+      ++drained;
+    };
+  while (producers_done < kThreads) {
+    consumer->drain(check);
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  consumer->drain(check);
+
+  EXPECT_TRUE(consumer->empty());
+  EXPECT_EQ(size_t(kThreads * kRecordsPerThread), drained + consumer->dropped());
+}
+
+class LoggingTest : public ::testing::Test
+{
+public:
+  void SetUp() override
+  {
+    allocator = rcutils_get_default_allocator();
+  }
+
+  // The ring of this process, named with a nonce picked by the backend.
+  static std::string ring_of_this_process()
+  {
+    std::string prefix =
+      std::string(rcl_logging_shm::kRingNamePrefix) + std::to_string(getpid()) + ".";
+    for (const auto & entry : std::filesystem::directory_iterator("/dev/shm")) {
+      std::string filename = entry.path().filename().string();
+      if (0 == filename.rfind(prefix, 0)) {
+        return "/" + filename;
+      }
+    }
+    return "";
+  }
+
+  rcutils_allocator_t allocator;
+  std::string name;
+};
+
+TEST_F(LoggingTest, init_invalid)
+{
+  rcutils_allocator_t bad_allocator = rcutils_get_zero_initialized_allocator();
+  EXPECT_EQ(
+    RCL_LOGGING_RET_INVALID_ARGUMENT,
+    rcl_logging_external_initialize(nullptr, nullptr, bad_allocator));
+  rcutils_reset_error();
+
+  std::string original = rcpputils::get_env_var("RCL_LOGGING_SHM_RING_SIZE");
+  RCPPUTILS_SCOPE_EXIT(
+  {
+    rcpputils::set_env_var("RCL_LOGGING_SHM_RING_SIZE", original.c_str());
+  });
+  for (const char * value : {"-1", "100", "1k", "99999999999"}) {
+    rcpputils::set_env_var("RCL_LOGGING_SHM_RING_SIZE", value);
+    EXPECT_EQ(
+      RCL_LOGGING_RET_ERROR,
+      rcl_logging_external_initialize(nullptr, nullptr, allocator)) << value;
+    EXPECT_NE(
+      std::string::npos,
+      std::string(rcutils_get_error_string().str).find("RCL_LOGGING_SHM_RING_SIZE"));
+    rcutils_reset_error();
+  }
+}
+
+TEST_F(LoggingTest, log_to_ring)
+{
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_initialize("test", nullptr, allocator));
+  name = ring_of_this_process();
+  std::unique_ptr<Ring> collector_side = Ring::open(name);
+  ASSERT_NE(nullptr, collector_side);
+  collector_side->attach();
+  EXPECT_EQ("test", collector_side->process_name());
+  EXPECT_EQ(getpid(), collector_side->pid());
+
+  EXPECT_EQ(
+    RCL_LOGGING_RET_OK,
+    rcl_logging_external_set_logger_level("a.b", RCUTILS_LOG_SEVERITY_ERROR));
+  EXPECT_EQ(
+    RCL_LOGGING_RET_OK,
+    rcl_logging_external_set_logger_level("a.b.c.d", RCUTILS_LOG_SEVERITY_DEBUG));
+  EXPECT_TRUE(rcl_logging_external_severity_might_be_enabled(RCUTILS_LOG_SEVERITY_DEBUG));
+  EXPECT_FALSE(rcl_logging_external_is_enabled_for("a.b.c", RCUTILS_LOG_SEVERITY_WARN));
+  EXPECT_TRUE(rcl_logging_external_is_enabled_for("a.b.c.d.e", RCUTILS_LOG_SEVERITY_DEBUG));
+
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_DEBUG, nullptr, "dropped");
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, "root");
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_WARN, "a.b.c", "dropped");
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_ERROR, "a.b.c", "inherited");
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_DEBUG, "a.b.c.d", "own level");
+  rcl_logging_external_log_with_length(RCUTILS_LOG_SEVERITY_INFO, "a.bc", 4, "length", 6);
+  rcl_logging_record_t records[] = {
+    {RCUTILS_LOG_SEVERITY_INFO, "x", 1, "batch 1", 7},
+    {RCUTILS_LOG_SEVERITY_INFO, "a.b", 3, "dropped", 7},
+    {RCUTILS_LOG_SEVERITY_FATAL, "a.b", 3, "batch 2", 7},
+  };
+  rcl_logging_external_log_batch(records, 3);
+  rcl_logging_structured_record_t structured = {
+    RCUTILS_LOG_SEVERITY_WARN, "x", 1, 1234567890123456789, "file.cpp", "function", 42,
+    "structured", 10};
+  rcl_logging_external_log_structured(&structured);
+  structured.name = "a.b";
+  structured.name_length = 3;
+  rcl_logging_external_log_structured(&structured);
+  rcl_logging_external_log_structured(nullptr);
+
+  std::vector<DrainedRecord> drained = drain(*collector_side);
+  std::vector<std::string> expected = {
+    "root", "inherited", "own level", "length", "batch 1", "batch 2", "structured"};
+  ASSERT_EQ(expected.size(), drained.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(expected[i], drained[i].msg);
+  }
+  EXPECT_EQ("a.b.c.d", drained[2].name);
+  EXPECT_EQ(RCUTILS_LOG_SEVERITY_FATAL, drained[5].severity);
+  // Structured messages keep their own time stamp
+  EXPECT_EQ(1234567890123456789, drained[6].timestamp_ns);
+
+  rcl_logging_stats_t stats;
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_get_stats(&stats));
+  EXPECT_EQ(1u, stats.accepted[RCL_LOGGING_STATS_SEVERITY_DEBUG]);
+  EXPECT_EQ(3u, stats.accepted[RCL_LOGGING_STATS_SEVERITY_INFO]);
+  EXPECT_EQ(1u, stats.accepted[RCL_LOGGING_STATS_SEVERITY_WARN]);
+  EXPECT_EQ(1u, stats.accepted[RCL_LOGGING_STATS_SEVERITY_ERROR]);
+  EXPECT_EQ(1u, stats.accepted[RCL_LOGGING_STATS_SEVERITY_FATAL]);
+  EXPECT_EQ(1u, stats.filtered[RCL_LOGGING_STATS_SEVERITY_DEBUG]);
+  EXPECT_EQ(1u, stats.filtered[RCL_LOGGING_STATS_SEVERITY_INFO]);
+  EXPECT_EQ(2u, stats.filtered[RCL_LOGGING_STATS_SEVERITY_WARN]);
+  // The logger names and messages
+  EXPECT_EQ(73u, stats.bytes_written);
+  EXPECT_EQ(0u, stats.dropped);
+
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+  EXPECT_FALSE(rcl_logging_external_is_enabled_for(nullptr, RCUTILS_LOG_SEVERITY_FATAL));
+  // Left for the attached collector to remove
+  EXPECT_TRUE(collector_side->closed());
+  EXPECT_NE(nullptr, Ring::open(name));
+  collector_side->unlink();
+}
+
+TEST_F(LoggingTest, logger_levels_concurrent)
+{
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_initialize("test", nullptr, allocator));
+  name = ring_of_this_process();
+  std::unique_ptr<Ring> collector_side = Ring::open(name);
+  ASSERT_NE(nullptr, collector_side);
+  collector_side->attach();
+
+  // Errors pass both levels, so none may be lost while they change.
+  constexpr int kThreads = 2;
+  constexpr int kMessagesPerThread = 2000;
+  std::atomic<int> loggers_done{0};
+  std::thread setter([&loggers_done]() {
+      for (int i = 0; loggers_done < kThreads; ++i) {
+        EXPECT_EQ(
+          RCL_LOGGING_RET_OK,
+          rcl_logging_external_set_logger_level(
+            "a.b", i % 2 ? RCUTILS_LOG_SEVERITY_WARN : RCUTILS_LOG_SEVERITY_DEBUG));
+      }
+    });
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back(
+      [&loggers_done]() {
+        for (int i = 0; i < kMessagesPerThread; ++i) {
+          rcl_logging_external_log(RCUTILS_LOG_SEVERITY_ERROR, "a.b.c", "message");
+        }
+        ++loggers_done;
+      });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  setter.join();
+
+  EXPECT_EQ(size_t(kThreads * kMessagesPerThread), drain(*collector_side).size());
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+  collector_side->unlink();
+}
+
+// Logging calls racing with shutdown either write to the ring, or do nothing.
+TEST_F(LoggingTest, log_while_reinitializing)
+{
+  std::atomic<bool> stop{false};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back(
+      [&stop]() {
+        rcl_logging_record_t records[] = {
+          {RCUTILS_LOG_SEVERITY_INFO, "batch", 5, "b1", 2},
+          {RCUTILS_LOG_SEVERITY_ERROR, "batch", 5, "b2", 2},
+        };
+        rcl_logging_structured_record_t record = {
+          RCUTILS_LOG_SEVERITY_WARN, "structured", 10, 0, "file.cpp", "function", 1, "s", 1};
+        rcl_logging_stats_t stats;
+        while (!stop) {
+          rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, "a", "message");
+          rcl_logging_external_log_batch(records, 2);
+          rcl_logging_external_log_structured(&record);
+          rcl_logging_external_is_enabled_for("a", RCUTILS_LOG_SEVERITY_INFO);
+          EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_get_stats(&stats));
+        }
+      });
+  }
+  for (int i = 0; i < 50; ++i) {
+    EXPECT_EQ(
+      RCL_LOGGING_RET_OK, rcl_logging_external_initialize("test", nullptr, allocator));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+  }
+  stop = true;
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ("", ring_of_this_process());
+}
+
+TEST_F(LoggingTest, shutdown_without_collector)
+{
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_initialize(nullptr, nullptr, allocator));
+  name = ring_of_this_process();
+  EXPECT_NE(nullptr, Ring::open(name));
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+  EXPECT_EQ(nullptr, Ring::open(name));
+}
+
+TEST_F(LoggingTest, shared_initialization)
+{
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_initialize(nullptr, nullptr, allocator));
+  name = ring_of_this_process();
+  // Another client shares the ring
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_initialize("other", nullptr, allocator));
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+  EXPECT_NE(nullptr, Ring::open(name));
+  EXPECT_TRUE(rcl_logging_external_is_enabled_for(nullptr, RCUTILS_LOG_SEVERITY_INFO));
+  // Removed by the last one
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+  EXPECT_EQ(nullptr, Ring::open(name));
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+}
+
+TEST_F(LoggingTest, collector)
+{
+  std::filesystem::path output_path = std::filesystem::temp_directory_path() /
+    ("rcl_logging_shm_test_" + std::to_string(getpid()) + ".log");
+  FILE * output = std::fopen(output_path.string().c_str(), "w");
+  ASSERT_NE(nullptr, output);
+  RCPPUTILS_SCOPE_EXIT(
+  {
+    std::fclose(output);
+    std::filesystem::remove(output_path);
+  });
+  rcl_logging_shm::Collector collector(output);
+
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_initialize("test", nullptr, allocator));
+  name = ring_of_this_process();
+  collector.poll();
+  EXPECT_GE(collector.ring_count(), 1u);
+
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_WARN, "a.b", "collected");
+  EXPECT_GE(collector.poll(), 1u);
+  std::fflush(output);
+  std::string prefix = "[WARN] [";
+  std::string suffix = "] [test:" + std::to_string(getpid()) + "] [a.b]: collected\n";
+  std::string contents = read_file(output_path);
+  EXPECT_EQ(0u, contents.rfind(prefix, 0)) << contents;
+  EXPECT_NE(std::string::npos, contents.find(suffix)) << contents;
+
+  // Whatever is logged up to shutdown is still collected, and then the ring is removed
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_ERROR, nullptr, "last");
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+  EXPECT_NE(nullptr, Ring::open(name));
+  collector.poll();
+  std::fflush(output);
+  EXPECT_NE(
+    std::string::npos,
+    read_file(output_path).find("] [test:" + std::to_string(getpid()) + "] []: last\n"));
+  EXPECT_EQ(nullptr, Ring::open(name));
+}
@@ -0,0 +1,61 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Turn a log file written by rcl_logging_spdlog in the binary format back into
+// the text the default text format would have written.
+//
+// Usage: decode_binary_log <input.binlog> [<output.log>]
+// The text goes to standard output if no output file is given.
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "rcl_logging_spdlog/binary_log_format.hpp"
+
+int main(int argc, char ** argv)
+{
+  if (argc < 2 || argc > 3) {
+    std::cerr << "Usage: " << argv[0] << " <input.binlog> [<output.log>]" << std::endl;
+    return 2;
+  }
+
+  std::ifstream input(argv[1], std::ios::binary);
+  if (!input) {
+    std::cerr << "Failed to open '" << argv[1] << "' for reading" << std::endl;
+    return 1;
+  }
+
+  std::ofstream output_file;
+  if (argc == 3) {
+    output_file.open(argv[2], std::ios::binary | std::ios::trunc);
+    if (!output_file) {
+      std::cerr << "Failed to open '" << argv[2] << "' for writing" << std::endl;
+      return 1;
+    }
+  }
+  std::ostream & output = argc == 3 ? output_file : std::cout;
+
+  std::string error;
+  if (!rcl_logging_spdlog::binary_log::decode_to_text(input, output, error)) {
+    std::cerr << "Failed to decode '" << argv[1] << "': " << error << std::endl;
+    return 1;
+  }
+  output.flush();
+  if (!output) {
+    std::cerr << "Failed to write the decoded log" << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -12,17 +12,26 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <atomic>
 #include <cerrno>
 #include <chrono>
 #include <cinttypes>
+#include <cstdint>
+#include <cstring>
+#include <exception>
 #include <filesystem>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <new>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <system_error>
 #include <utility>
+#include <vector>
 
-#include "rcpputils/env.hpp"
 #include "rcpputils/scope_exit.hpp"
 
 #include "rcutils/allocator.h"
@@ -33,12 +42,53 @@
 #include "rcutils/time.h"
 
 #include "spdlog/spdlog.h"
-#include "spdlog/sinks/basic_file_sink.h"
 
 #include "rcl_logging_interface/rcl_logging_interface.h"
 
+#include "rcl_logging_spdlog/active_calls.hpp"
+#include "rcl_logging_spdlog/binary_file_sink.hpp"
+#include "rcl_logging_spdlog/datagram_sink.hpp"
+#include "rcl_logging_spdlog/file_sink.hpp"
+#include "rcl_logging_spdlog/file_writer.hpp"
+#include "rcl_logging_spdlog/flight_recorder.hpp"
+#include "rcl_logging_spdlog/flusher.hpp"
+#include "rcl_logging_spdlog/lazy_file_writer.hpp"
+#include "rcl_logging_spdlog/logger.hpp"
+#include "rcl_logging_spdlog/logger_levels.hpp"
+#include "rcl_logging_spdlog/mapped_file_writer.hpp"
+#include "rcl_logging_spdlog/message_counters.hpp"
+#include "rcl_logging_spdlog/message_filter.hpp"
+#include "rcl_logging_spdlog/record_formatter.hpp"
+#include "rcl_logging_spdlog/rotating_file_writer.hpp"
+#include "rcl_logging_spdlog/settings.hpp"
+#include "rcl_logging_spdlog/signal_watcher.hpp"
+#include "rcl_logging_spdlog/text_file_sink.hpp"
+#include "rcl_logging_spdlog/threaded_sink.hpp"
+#include "rcl_logging_spdlog/uring_file_writer.hpp"
+
 static std::mutex g_logger_mutex;
-static std::shared_ptr<spdlog::logger> g_root_logger = nullptr;
+// The number of clients which initialized logging and didn't shut it down yet.
+static size_t g_initialize_count = 0;
+static std::shared_ptr<rcl_logging_spdlog::Logger> g_root_logger = nullptr;
+// Opened by initialize once all of the state below is in place, and closed
+// first by shutdown, which waits for the calls using it to return.
+static rcl_logging_spdlog::ActiveCalls g_active_calls;
+static std::unique_ptr<rcl_logging_spdlog::Flusher> g_flusher = nullptr;
+// spdlog's default level is info, so keep that as the default root level.
+static rcl_logging_spdlog::LoggerLevels g_logger_levels(RCUTILS_LOG_SEVERITY_INFO);
+// Like g_root_logger, only changed by initialize and shutdown.
+static std::unique_ptr<rcl_logging_spdlog::FlightRecorder> g_flight_recorder = nullptr;
+static spdlog::level::level_enum g_flight_recorder_level = spdlog::level::off;
+static spdlog::level::level_enum g_flight_recorder_dump_level = spdlog::level::off;
+static std::unique_ptr<rcl_logging_spdlog::SignalWatcher> g_dump_signal_watcher = nullptr;
+static std::unique_ptr<rcl_logging_spdlog::MessageFilter> g_message_filter = nullptr;
+static std::shared_ptr<rcl_logging_spdlog::FileSink> g_file_sink = nullptr;
+static std::vector<std::shared_ptr<rcl_logging_spdlog::ThreadedSink>> g_extra_sinks;
+// Only for text logs, binary logs keep the parts of structured messages apart.
+static std::unique_ptr<rcl_logging_spdlog::RecordFormatter> g_record_formatter = nullptr;
+static std::chrono::nanoseconds g_latency_report_interval{0};
+static std::atomic<int64_t> g_next_latency_report_ns{0};
+static rcl_logging_spdlog::MessageCounters g_message_counters;
 
 static spdlog::level::level_enum map_external_log_level_to_library_level(int external_level)
 {
@@ -59,38 +109,255 @@ static spdlog::level::level_enum map_external_log_level_to_library_level(int ext
   return level;
 }
 
+// Get the lowest severity which map_external_log_level_to_library_level() maps
+// to a library level that passes library_level.
+static int lowest_external_severity_at_library_level(spdlog::level::level_enum library_level)
+{
+  switch (library_level) {
+    case spdlog::level::level_enum::trace:
+    case spdlog::level::level_enum::debug:
+      return RCUTILS_LOG_SEVERITY_UNSET;
+    case spdlog::level::level_enum::info:
+      return RCUTILS_LOG_SEVERITY_DEBUG + 1;
+    case spdlog::level::level_enum::warn:
+      return RCUTILS_LOG_SEVERITY_INFO + 1;
+    case spdlog::level::level_enum::err:
+      return RCUTILS_LOG_SEVERITY_WARN + 1;
+    case spdlog::level::level_enum::critical:
+      return RCUTILS_LOG_SEVERITY_ERROR + 1;
+    default:
+      return RCUTILS_LOG_SEVERITY_FATAL + 1;
+  }
+}
+
+static int lowest_external_severity_emitted_at_level(int external_level)
+{
+  return lowest_external_severity_at_library_level(
+    map_external_log_level_to_library_level(external_level));
+}
+
+static bool should_log(int severity, std::string_view name)
+{
+  return map_external_log_level_to_library_level(severity) >=
+         map_external_log_level_to_library_level(g_logger_levels.get_effective_level(name));
+}
+
+// Whether a message which isn't logged is kept by the flight recorder instead.
+static bool should_record(spdlog::level::level_enum level)
+{
+  return nullptr != g_flight_recorder && level >= g_flight_recorder_level;
+}
+
+// Whether a message which is logged has the flight recorder written out first.
+static bool should_dump(spdlog::level::level_enum level)
+{
+  return nullptr != g_flight_recorder && level >= g_flight_recorder_dump_level;
+}
+
+static void publish_severity_threshold()
+{
+  int threshold = lowest_external_severity_emitted_at_level(g_logger_levels.get_minimum_level());
+  if (nullptr != g_flight_recorder) {
+    threshold = std::min(
+      threshold, lowest_external_severity_at_library_level(g_flight_recorder_level));
+  }
+  rcl_logging_external_set_severity_threshold(threshold);
+}
+
+// Log what the message filter dropped, ahead of the next message of the logger.
+static void report_filtered(
+  std::string_view name, spdlog::level::level_enum level, uint64_t repeated, uint64_t dropped)
+{
+  spdlog::string_view_t logger_name(name.data(), name.size());
+  if (repeated > 0) {
+    g_root_logger->log(
+      logger_name, level, rcl_logging_spdlog::MessageFilter::repeated_message(name, repeated));
+  }
+  if (dropped > 0) {
+    g_root_logger->log(
+      logger_name, level, rcl_logging_spdlog::MessageFilter::dropped_message(name, dropped));
+  }
+}
+
+static void dump_flight_recorder()
+{
+  if (0 == g_flight_recorder->size()) {
+    return;
+  }
+  // The messages are already formatted by rcutils, so these are set apart
+  // from them only by their text.
+  g_root_logger->log("", spdlog::level::info, "--- Begin of flight recorder dump ---");
+  size_t dumped = g_flight_recorder->dump(
+    [](const spdlog::details::log_msg * msgs, size_t count) {
+      g_root_logger->log_batch(msgs, count);
+    });
+  g_root_logger->log(
+    "", spdlog::level::info,
+    "--- End of flight recorder dump, " + std::to_string(dumped) + " messages ---");
+}
+
+// Get the text to log for a structured message, valid until the calling thread
+// renders the next one.
+static spdlog::string_view_t render(const rcl_logging_structured_record_t & record)
+{
+  if (nullptr == g_record_formatter) {
+    return spdlog::string_view_t(record.msg, record.msg_length);
+  }
+  thread_local spdlog::memory_buf_t buffer;
+  thread_local rcl_logging_spdlog::RecordFormatter::TimeCache time_cache;
+  buffer.clear();
+  g_record_formatter->format(record, time_cache, buffer);
+  return spdlog::string_view_t(buffer.data(), buffer.size());
+}
+
+static std::string format_latency(uint64_t ns)
+{
+  char buffer[32];
+  rcutils_snprintf(buffer, sizeof(buffer), "%.1f us", static_cast<double>(ns) / 1000.0);
+  return buffer;
+}
+
+static void report_latency()
+{
+  rcl_logging_latency_histograms_t histograms;
+  g_file_sink->read_latency(histograms);
+  g_root_logger->log(
+    "", spdlog::level::info,
+    "--- Logging latency of " + std::to_string(histograms.written.count) + " messages: " +
+    "written p50 " + format_latency(histograms.written.p50_ns) +
+    ", p99 " + format_latency(histograms.written.p99_ns) +
+    ", max " + format_latency(histograms.written.max_ns) +
+    "; flushed p50 " + format_latency(histograms.flushed.p50_ns) +
+    ", p99 " + format_latency(histograms.flushed.p99_ns) +
+    ", max " + format_latency(histograms.flushed.max_ns) + " ---");
+}
+
+// Report the latency histograms if the interval is over, from whichever thread
+// logs first then.
+static void maybe_report_latency()
+{
+  if (0 == g_latency_report_interval.count()) {
+    return;
+  }
+  int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    spdlog::log_clock::now().time_since_epoch()).count();
+  int64_t next = g_next_latency_report_ns.load(std::memory_order_relaxed);
+  if (now < next ||
+    !g_next_latency_report_ns.compare_exchange_strong(
+      next, now + g_latency_report_interval.count(), std::memory_order_relaxed))
+  {
+    return;
+  }
+  report_latency();
+}
+
 namespace
 {
 
 RCL_LOGGING_INTERFACE_LOCAL
-bool
-get_should_use_old_flushing_behavior()
+std::unique_ptr<rcl_logging_spdlog::FileWriter>
+create_file_writer(const std::string & filename, const rcl_logging_spdlog::Settings & settings)
 {
-  const char * env_var_name = "RCL_LOGGING_SPDLOG_EXPERIMENTAL_OLD_FLUSHING_BEHAVIOR";
+  auto factory = [settings](const std::string & segment_filename)
+    -> std::unique_ptr<rcl_logging_spdlog::FileWriter> {
+      if (rcl_logging_spdlog::FileWriterType::mmap == settings.file_writer) {
+        return std::make_unique<rcl_logging_spdlog::MappedFileWriter>(
+          segment_filename, settings.mmap_segment_size);
+      }
+      if (rcl_logging_spdlog::FileWriterType::io_uring == settings.file_writer &&
+        rcl_logging_spdlog::UringFileWriter::is_supported())
+      {
+        size_t buffer_size = 0 == settings.buffer_size ? 64 * 1024 : settings.buffer_size;
+        return std::make_unique<rcl_logging_spdlog::UringFileWriter>(
+          segment_filename, buffer_size, settings.io_uring_buffers);
+      }
+      return std::make_unique<rcl_logging_spdlog::StdioFileWriter>(
+        segment_filename, settings.buffer_size);
+    };
+  rcl_logging_spdlog::RotationSettings rotation_settings = settings.rotation();
+  if (rotation_settings.enabled()) {
+    return std::make_unique<rcl_logging_spdlog::RotatingFileWriter>(
+      filename, std::move(factory), rotation_settings);
+  }
+  return factory(filename);
+}
 
-  try {
-    std::string env_var_value = rcpputils::get_env_var(env_var_name);
+RCL_LOGGING_INTERFACE_LOCAL
+void
+create_log_directory(const std::string & logdir)
+{
+  std::error_code ec;
+  std::filesystem::create_directories(logdir, ec);
+  // create_directories returns true if it created the directory, and false if it did not.
+  // This behavior is maintained regardless of whether an error occurred.  Since we don't
+  // actually care whether the directory was created, we only check for errors.
+  if (ec.value() != 0) {
+    spdlog::throw_spdlog_ex("Failed to create log directory '" + logdir + "'", ec.value());
+  }
+}
 
-    if (env_var_value.empty()) {
-      // not set
-      return false;
-    }
-    if ("0" == env_var_value) {
-      // explicitly false
-      return false;
-    }
-    if ("1" == env_var_value) {
-      // explicitly true
-      return true;
-    }
+RCL_LOGGING_INTERFACE_LOCAL
+std::shared_ptr<rcl_logging_spdlog::FileSink>
+create_file_sink(
+  const std::string & filename, const rcl_logging_spdlog::Settings & settings,
+  const rcl_logging_spdlog::FlushSettings & flush_settings)
+{
+  std::unique_ptr<rcl_logging_spdlog::FileWriter> writer;
+  if (settings.lazy_log_file) {
+    // Many processes never log anything, and those that do often only much
+    // later, so don't touch the file system during start up.
+    writer = std::make_unique<rcl_logging_spdlog::LazyFileWriter>(
+      [filename, settings]() {
+        if (settings.lazy_log_directory) {
+          create_log_directory(std::filesystem::path(filename).parent_path().string());
+        }
+        return create_file_writer(filename, settings);
+      });
+  } else {
+    writer = create_file_writer(filename, settings);
+  }
+  if (rcl_logging_spdlog::LogFileFormat::binary == settings.format) {
+    return std::make_shared<rcl_logging_spdlog::BinaryFileSink>(
+      std::move(writer), flush_settings);
+  }
+  return std::make_shared<rcl_logging_spdlog::TextFileSink>(std::move(writer), flush_settings);
+}
 
-    // unknown value
-    throw std::runtime_error("unrecognized value: " + env_var_value);
-  } catch (const std::runtime_error & error) {
-    throw std::runtime_error(
-            std::string("failed to get env var '") + env_var_name + "': " + error.what()
-    );
+// Create an extra sink on a thread of its own, filename_base being the name of
+// the log file without its extension.
+RCL_LOGGING_INTERFACE_LOCAL
+std::shared_ptr<rcl_logging_spdlog::ThreadedSink>
+create_extra_sink(
+  const rcl_logging_spdlog::ExtraSinkSettings & sink_settings,
+  const std::string & filename_base, const char * extension,
+  const rcl_logging_spdlog::Settings & settings, rcutils_allocator_t allocator)
+{
+  spdlog::sink_ptr sink;
+  switch (sink_settings.type) {
+    case rcl_logging_spdlog::ExtraSinkType::file:
+      {
+        // Latencies are measured for the main log file only.
+        rcl_logging_spdlog::FlushSettings flush_settings = settings.flush();
+        flush_settings.record_latency = false;
+        sink = create_file_sink(
+          filename_base + "." + sink_settings.target + extension, settings, flush_settings);
+      }
+      break;
+    case rcl_logging_spdlog::ExtraSinkType::udp:
+      sink = std::make_shared<rcl_logging_spdlog::DatagramSink>(
+        rcl_logging_spdlog::DatagramSink::Protocol::udp, sink_settings.target);
+      break;
+    case rcl_logging_spdlog::ExtraSinkType::unix_socket:
+      sink = std::make_shared<rcl_logging_spdlog::DatagramSink>(
+        rcl_logging_spdlog::DatagramSink::Protocol::unix_socket, sink_settings.target);
+      break;
   }
+  rcl_logging_spdlog::AsyncWriterSettings writer_settings = settings.async_writer();
+  writer_settings.queue_size = settings.extra_sink_queue_size;
+  auto threaded_sink = std::make_shared<rcl_logging_spdlog::ThreadedSink>(
+    std::move(sink), writer_settings, allocator);
+  threaded_sink->set_level(sink_settings.level);
+  return threaded_sink;
 }
 
 }  // namespace
@@ -103,135 +370,491 @@ rcl_logging_ret_t rcl_logging_external_initialize(
   RCUTILS_CHECK_ALLOCATOR(&allocator, return RCL_LOGGING_RET_INVALID_ARGUMENT);
 
   std::lock_guard<std::mutex> lk(g_logger_mutex);
-  // It is possible for this to get called more than once in a process (some of
-  // the tests do this implicitly by calling rclcpp::init more than once).
-  // If the logger is already setup, don't do anything.
+  // It is possible for this to get called more than once in a process, e.g.
+  // by each rcl context. They all share the logger set up by the first one,
+  // and it is only shut down once all of them are.
   if (g_root_logger != nullptr) {
+    ++g_initialize_count;
     return RCL_LOGGING_RET_OK;
   }
 
+  // Settings come from the environment, and the config file if there is one
+  // overrides them.
+  rcl_logging_spdlog::Settings settings;
+  try {
+    rcl_logging_spdlog::load_settings_from_env(settings);
+  } catch (const std::runtime_error & error) {
+    RCUTILS_SET_ERROR_MSG(error.what());
+    return RCL_LOGGING_RET_ERROR;
+  }
   bool config_file_provided = (nullptr != config_file) && (config_file[0] != '\0');
   if (config_file_provided) {
-    // TODO(clalancette): implement support for an external configuration file.
-    RCUTILS_SET_ERROR_MSG(
-      "spdlog logging backend doesn't currently support external configuration");
-    return RCL_LOGGING_RET_ERROR;
-  } else {
-    // check RCL_LOGGING_SPDLOG_EXPERIMENTAL_OLD_FLUSHING_BEHAVIOR to see if we
-    // should change log file flushing behavior
-    bool should_use_old_flushing_behavior = false;
     try {
-      should_use_old_flushing_behavior = ::get_should_use_old_flushing_behavior();
-    } catch (const std::runtime_error & error) {
+      rcl_logging_spdlog::load_settings_from_config_file(settings, config_file);
+    } catch (const rcl_logging_spdlog::ConfigFileNotFoundError & error) {
       RCUTILS_SET_ERROR_MSG(error.what());
-      return RCL_LOGGING_RET_ERROR;
+      return RCL_LOGGING_RET_CONFIG_FILE_DOESNT_EXIST;
+    } catch (const rcl_logging_spdlog::InvalidConfigFileError & error) {
+      RCUTILS_SET_ERROR_MSG(error.what());
+      return RCL_LOGGING_RET_CONFIG_FILE_INVALID;
     }
+  }
 
-    // To be compatible with ROS 1, we construct a default filename of
-    // the form ~/.ros/log/<exe>_<pid>_<milliseconds-since-epoch>.log
+  // To be compatible with ROS 1, we construct a default filename of
+  // the form ~/.ros/log/<exe>_<pid>_<milliseconds-since-epoch>.log
+  // Binary logs use a .binlog extension instead, since they aren't text.
+
+  // The file name has to fit into the same space anyway.
+  char logdir[4096];
+  rcl_logging_ret_t dir_ret =
+    rcl_logging_get_logging_directory_to_buffer(logdir, sizeof(logdir), nullptr);
+  if (RCL_LOGGING_RET_OK != dir_ret) {
+    // We couldn't get the log directory, so get out of here without setting up
+    // logging.
+    RCUTILS_SET_ERROR_MSG("Failed to get logging directory");
+    // A directory too long for the buffer is no fault of the caller.
+    return RCL_LOGGING_RET_NOT_ENOUGH_SPACE == dir_ret ? RCL_LOGGING_RET_ERROR : dir_ret;
+  }
 
-    char * logdir = nullptr;
-    rcl_logging_ret_t dir_ret = rcl_logging_get_logging_directory(allocator, &logdir);
-    if (RCL_LOGGING_RET_OK != dir_ret) {
-      // We couldn't get the log directory, so get out of here without setting up
-      // logging.
-      RCUTILS_SET_ERROR_MSG("Failed to get logging directory");
-      return dir_ret;
+  // A lazy log directory is created along with the log file, see create_file_sink.
+  if (!settings.lazy_log_file || !settings.lazy_log_directory) {
+    try {
+      ::create_log_directory(logdir);
+    } catch (const spdlog::spdlog_ex & error) {
+      RCUTILS_SET_ERROR_MSG(error.what());
+      return RCL_LOGGING_RET_ERROR;
     }
-    RCPPUTILS_SCOPE_EXIT(
-    {
-      allocator.deallocate(logdir, allocator.state);
-    });
+  }
 
-    std::error_code ec;
-    std::filesystem::path logdir_path(logdir);
+  // Now get the milliseconds since the epoch in the local timezone.
+  rcutils_time_point_value_t now;
+  rcutils_ret_t ret = rcutils_system_time_now(&now);
+  if (ret != RCUTILS_RET_OK) {
+    // We couldn't get the system time, so get out of here without setting up
+    // logging.  We don't need to call RCUTILS_SET_ERROR_MSG either since
+    // rcutils_system_time_now() already did it.
+    return RCL_LOGGING_RET_ERROR;
+  }
+  int64_t ms_since_epoch = RCUTILS_NS_TO_MS(now);
+
+  bool file_name_provided = (nullptr != file_name_prefix) && (file_name_prefix[0] != '\0');
+  char * basec;
+  if (file_name_provided) {
+    basec = rcutils_strdup(file_name_prefix, allocator);
+  } else {  // otherwise, get the program name.
+    basec = rcutils_get_executable_name(allocator);
+  }
+  if (basec == nullptr) {
+    // We couldn't get the program name, so get out of here without setting up
+    // logging.
+    RCUTILS_SET_ERROR_MSG("Failed to get the executable name");
+    return RCL_LOGGING_RET_ERROR;
+  }
+  RCPPUTILS_SCOPE_EXIT(
+  {
+    allocator.deallocate(basec, allocator.state);
+  });
+  // Without the extension, which extra log files get their name inserted before.
+  char name_buffer[4096] = {0};
+  int print_ret = rcutils_snprintf(
+    name_buffer, sizeof(name_buffer),
+    "%s/%s_%i_%" PRId64, logdir,
+    basec, rcutils_get_pid(), ms_since_epoch);
+  if (print_ret < 0) {
+    RCUTILS_SET_ERROR_MSG("Failed to create log file name string");
+    return RCL_LOGGING_RET_ERROR;
+  }
+  const char * extension =
+    rcl_logging_spdlog::LogFileFormat::binary == settings.format ? ".binlog" : ".log";
 
-    std::filesystem::create_directories(logdir_path, ec);
-    // create_directories returns true if it created the directory, and false if it did not.
-    // This behavior is maintained regardless of whether an error occurred.  Since we don't
-    // actually care whether the directory was created, we only check for errors.
-    if (ec.value() != 0) {
+  std::shared_ptr<rcl_logging_spdlog::FileSink> sink;
+  try {
+    sink = ::create_file_sink(std::string(name_buffer) + extension, settings, settings.flush());
+  } catch (const spdlog::spdlog_ex & error) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("Failed to open log file: %s", error.what());
+    return RCL_LOGGING_RET_ERROR;
+  } catch (const std::system_error & error) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Failed to start the log segment archiver: %s", error.what());
+    return RCL_LOGGING_RET_ERROR;
+  }
+  std::vector<spdlog::sink_ptr> sinks{sink};
+  std::vector<std::shared_ptr<rcl_logging_spdlog::ThreadedSink>> extra_sinks;
+  for (const rcl_logging_spdlog::ExtraSinkSettings & sink_settings : settings.extra_sinks) {
+    try {
+      extra_sinks.push_back(
+        ::create_extra_sink(sink_settings, name_buffer, extension, settings, allocator));
+    } catch (const std::exception & error) {
+      // spdlog::spdlog_ex from the sink, std::bad_alloc from its queue or
+      // std::system_error from its thread.
       RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
-        "Failed to create log directory '%s': %d", logdir, ec.value());
+        "Failed to create the extra sink '%s': %s", sink_settings.target.c_str(), error.what());
       return RCL_LOGGING_RET_ERROR;
     }
-
-    // Now get the milliseconds since the epoch in the local timezone.
-    rcutils_time_point_value_t now;
-    rcutils_ret_t ret = rcutils_system_time_now(&now);
-    if (ret != RCUTILS_RET_OK) {
-      // We couldn't get the system time, so get out of here without setting up
-      // logging.  We don't need to call RCUTILS_SET_ERROR_MSG either since
-      // rcutils_system_time_now() already did it.
+    sinks.push_back(extra_sinks.back());
+  }
+  std::shared_ptr<rcl_logging_spdlog::Logger> logger;
+  if (settings.async) {
+    // The queue is bounded, so if the writer thread falls behind messages are
+    // dropped or the caller blocks, per async_overflow_policy, rather than the
+    // process growing without limit.
+    try {
+      logger = std::make_shared<rcl_logging_spdlog::Logger>(
+        sinks, settings.async_writer(), allocator);
+    } catch (const std::length_error & error) {
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "Invalid size of the async logging queue: %s", error.what());
       return RCL_LOGGING_RET_ERROR;
-    }
-    int64_t ms_since_epoch = RCUTILS_NS_TO_MS(now);
-
-    bool file_name_provided = (nullptr != file_name_prefix) && (file_name_prefix[0] != '\0');
-    char * basec;
-    if (file_name_provided) {
-      basec = rcutils_strdup(file_name_prefix, allocator);
-    } else {  // otherwise, get the program name.
-      basec = rcutils_get_executable_name(allocator);
-    }
-    if (basec == nullptr) {
-      // We couldn't get the program name, so get out of here without setting up
-      // logging.
-      RCUTILS_SET_ERROR_MSG("Failed to get the executable name");
+    } catch (const std::bad_alloc &) {
+      RCUTILS_SET_ERROR_MSG("Failed to allocate the async logging queue");
+      return RCL_LOGGING_RET_ERROR;
+    } catch (const std::system_error & error) {
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "Failed to start the async logging threads: %s", error.what());
       return RCL_LOGGING_RET_ERROR;
     }
-    RCPPUTILS_SCOPE_EXIT(
-    {
-      allocator.deallocate(basec, allocator.state);
-    });
-    char name_buffer[4096] = {0};
-    int print_ret = rcutils_snprintf(
-      name_buffer, sizeof(name_buffer),
-      "%s/%s_%i_%" PRId64 ".log", logdir,
-      basec, rcutils_get_pid(), ms_since_epoch);
-    if (print_ret < 0) {
-      RCUTILS_SET_ERROR_MSG("Failed to create log file name string");
+  } else {
+    logger = std::make_shared<rcl_logging_spdlog::Logger>(sinks);
+  }
+  // Filtering is done per logger name by g_logger_levels before reaching
+  // spdlog, so let everything through the spdlog logger itself.
+  logger->set_level(spdlog::level::trace);
+  // On each sink rather than through the logger, which would hand them a
+  // formatter and keep TextFileSink from writing messages as they are.
+  for (const spdlog::sink_ptr & target : logger->sinks()) {
+    target->set_pattern("%v");
+  }
+
+  // Flushing by size and severity is up to the sink, see FlushPolicy.
+  std::unique_ptr<rcl_logging_spdlog::Flusher> flusher;
+  if (settings.flush_interval.count() > 0) {
+    // The flusher is stopped before the logger is released in shutdown.
+    rcl_logging_spdlog::Logger * flushed = logger.get();
+    try {
+      flusher = std::make_unique<rcl_logging_spdlog::Flusher>(
+        [flushed]() {flushed->flush();}, [sink]() {return sink->write_stats().records;},
+        settings.flush_interval,
+        settings.flush_adaptive ? settings.flush_min_interval : std::chrono::milliseconds(0),
+        settings.threads());
+    } catch (const std::system_error & error) {
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "Failed to start the log flushing thread: %s", error.what());
       return RCL_LOGGING_RET_ERROR;
     }
+  }
 
-    auto sink = std::make_unique<spdlog::sinks::basic_file_sink_mt>(name_buffer, false);
-    g_root_logger = std::make_shared<spdlog::logger>("root", std::move(sink));
-    if (!should_use_old_flushing_behavior) {
-      // in this case we should do the new thing (until config files are supported)
-      // which is to configure the logger to flush periodically and on
-      // error level messages
-      spdlog::flush_every(std::chrono::seconds(5));
-      g_root_logger->flush_on(spdlog::level::err);
-    } else {
-      // the old behavior is to not configure the sink at all, so do nothing
+  std::unique_ptr<rcl_logging_spdlog::FlightRecorder> flight_recorder;
+  std::unique_ptr<rcl_logging_spdlog::SignalWatcher> dump_signal_watcher;
+  if (settings.flight_recorder_size > 0) {
+    try {
+      flight_recorder = std::make_unique<rcl_logging_spdlog::FlightRecorder>(
+        settings.flight_recorder_size);
+      if (0 != settings.flight_recorder_signal) {
+        // The signal may arrive before initialize is done, or after shutdown
+        // started, when there is nothing to dump yet.
+        dump_signal_watcher = std::make_unique<rcl_logging_spdlog::SignalWatcher>(
+          settings.flight_recorder_signal, []() {
+            rcl_logging_spdlog::ActiveCalls::Guard guard(g_active_calls);
+            if (guard) {
+              dump_flight_recorder();
+              g_root_logger->flush();
+            }
+          }, settings.threads());
+      }
+    } catch (const std::exception & error) {
+      // std::bad_alloc for a recorder too large, or std::system_error from the
+      // signal watcher.
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "Failed to set up the flight recorder: %s", error.what());
+      return RCL_LOGGING_RET_ERROR;
     }
+  }
 
-    spdlog::register_logger(g_root_logger);
+  std::unique_ptr<rcl_logging_spdlog::RecordFormatter> record_formatter;
+  if (rcl_logging_spdlog::LogFileFormat::text == settings.format) {
+    record_formatter = std::make_unique<rcl_logging_spdlog::RecordFormatter>(
+      settings.line_format);
+  }
 
-    g_root_logger->set_pattern("%v");
+  std::unique_ptr<rcl_logging_spdlog::MessageFilter> message_filter;
+  rcl_logging_spdlog::MessageFilterSettings message_filter_settings = settings.message_filter();
+  if (message_filter_settings.enabled()) {
+    message_filter = std::make_unique<rcl_logging_spdlog::MessageFilter>(
+      message_filter_settings);
   }
 
+  // Nothing can fail from here on. Everything the logging functions use is in
+  // place before g_active_calls lets them in.
+  g_logger_levels.reset(RCUTILS_LOG_SEVERITY_INFO);
+  g_flight_recorder_level = settings.flight_recorder_level;
+  g_flight_recorder_dump_level = settings.flight_recorder_dump_level;
+  g_flight_recorder = std::move(flight_recorder);
+  g_message_filter = std::move(message_filter);
+  g_record_formatter = std::move(record_formatter);
+  g_file_sink = std::move(sink);
+  g_extra_sinks = std::move(extra_sinks);
+  g_message_counters.reset();
+  g_latency_report_interval = settings.latency_report_interval;
+  g_next_latency_report_ns.store(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(
+      (spdlog::log_clock::now() + settings.latency_report_interval).time_since_epoch()).count(),
+    std::memory_order_relaxed);
+  g_root_logger = std::move(logger);
+  g_flusher = std::move(flusher);
+  g_dump_signal_watcher = std::move(dump_signal_watcher);
+  spdlog::register_logger(g_root_logger);
+  g_active_calls.open();
+  publish_severity_threshold();
+  g_initialize_count = 1;
   return RCL_LOGGING_RET_OK;
 }
 
 rcl_logging_ret_t rcl_logging_external_shutdown()
 {
+  std::lock_guard<std::mutex> lk(g_logger_mutex);
+  if (g_initialize_count > 1) {
+    --g_initialize_count;
+    return RCL_LOGGING_RET_OK;
+  }
+  g_initialize_count = 0;
+  // No logging function uses any of what is freed below from here on.
+  g_active_calls.close();
+  rcl_logging_external_set_severity_threshold(RCUTILS_LOG_SEVERITY_UNSET);
+  g_dump_signal_watcher = nullptr;
+  if (nullptr != g_message_filter) {
+    for (const auto & pending : g_message_filter->take_pending()) {
+      report_filtered(pending.name, pending.level, pending.repeated, pending.dropped);
+    }
+  }
+  g_flusher = nullptr;
   spdlog::drop("root");
+  // Destroying the logger writes out whatever is still queued and joins the
+  // writer thread, so nothing logged before shutdown is lost.
   g_root_logger = nullptr;
+  // Each extra sink writes out what it still has queued, once the logger
+  // above handed it everything.
+  g_extra_sinks.clear();
+  g_flight_recorder = nullptr;
+  g_message_filter = nullptr;
+  g_file_sink = nullptr;
+  g_record_formatter = nullptr;
+  g_latency_report_interval = std::chrono::nanoseconds(0);
   return RCL_LOGGING_RET_OK;
 }
 
 void rcl_logging_external_log(int severity, const char * name, const char * msg)
 {
-  (void)name;
-  g_root_logger->log(map_external_log_level_to_library_level(severity), msg);
+  rcl_logging_external_log_with_length(
+    severity, name, nullptr == name ? 0 : std::strlen(name), msg, std::strlen(msg));
 }
 
-rcl_logging_ret_t rcl_logging_external_set_logger_level(const char * name, int level)
+void rcl_logging_external_log_with_length(
+  int severity, const char * name, size_t name_length, const char * msg, size_t msg_length)
 {
-  (void)name;
+  rcl_logging_spdlog::ActiveCalls::Guard guard(g_active_calls);
+  if (!guard) {
+    return;
+  }
+  std::string_view name_view(nullptr == name ? "" : name, name_length);
+  spdlog::level::level_enum level = map_external_log_level_to_library_level(severity);
+  if (!should_log(severity, name_view)) {
+    g_message_counters.filtered(level);
+    if (should_record(level)) {
+      g_flight_recorder->record(
+        spdlog::log_clock::now(), spdlog::string_view_t(name_view.data(), name_view.size()),
+        level, spdlog::string_view_t(msg, msg_length));
+    }
+    return;
+  }
+  if (nullptr != g_message_filter) {
+    rcl_logging_spdlog::MessageFilter::Decision decision =
+      g_message_filter->check(name_view, level, std::string_view(msg, msg_length), true);
+    report_filtered(name_view, level, decision.repeated, decision.dropped);
+    if (!decision.log) {
+      g_message_counters.filtered(level);
+      return;
+    }
+  }
+  if (should_dump(level)) {
+    dump_flight_recorder();
+  }
+  g_message_counters.accepted(level);
+  g_root_logger->log(
+    spdlog::string_view_t(name_view.data(), name_view.size()), level,
+    spdlog::string_view_t(msg, msg_length));
+  maybe_report_latency();
+}
 
-  g_root_logger->set_level(map_external_log_level_to_library_level(level));
+void rcl_logging_external_log_batch(const rcl_logging_record_t * records, size_t count)
+{
+  rcl_logging_spdlog::ActiveCalls::Guard guard(g_active_calls);
+  if (!guard) {
+    return;
+  }
+  // Messages are handed over in chunks, so that any batch size works without
+  // allocating.
+  constexpr size_t kChunkSize = 64;
+  spdlog::details::log_msg msgs[kChunkSize];
+  size_t chunk_size = 0;
+  auto now = spdlog::log_clock::now();
+  for (size_t i = 0; i < count; ++i) {
+    const rcl_logging_record_t & record = records[i];
+    std::string_view name(nullptr == record.name ? "" : record.name, record.name_length);
+    spdlog::level::level_enum level = map_external_log_level_to_library_level(record.severity);
+    if (!should_log(record.severity, name) || !g_root_logger->should_log(level)) {
+      g_message_counters.filtered(level);
+      if (should_record(level)) {
+        g_flight_recorder->record(
+          now, spdlog::string_view_t(name.data(), name.size()), level,
+          spdlog::string_view_t(record.msg, record.msg_length));
+      }
+      continue;
+    }
+    if (nullptr != g_message_filter) {
+      rcl_logging_spdlog::MessageFilter::Decision decision = g_message_filter->check(
+        name, level, std::string_view(record.msg, record.msg_length), true);
+      if ((decision.repeated > 0 || decision.dropped > 0) && chunk_size > 0) {
+        g_root_logger->log_batch(msgs, chunk_size);
+        chunk_size = 0;
+      }
+      report_filtered(name, level, decision.repeated, decision.dropped);
+      if (!decision.log) {
+        g_message_counters.filtered(level);
+        continue;
+      }
+    }
+    if (should_dump(level)) {
+      // Whatever came before in the batch is older than what was recorded.
+      if (chunk_size > 0) {
+        g_root_logger->log_batch(msgs, chunk_size);
+        chunk_size = 0;
+      }
+      dump_flight_recorder();
+    }
+    g_message_counters.accepted(level);
+    msgs[chunk_size++] = spdlog::details::log_msg(
+      now, spdlog::source_loc(), spdlog::string_view_t(name.data(), name.size()), level,
+      spdlog::string_view_t(record.msg, record.msg_length));
+    if (kChunkSize == chunk_size) {
+      g_root_logger->log_batch(msgs, chunk_size);
+      chunk_size = 0;
+    }
+  }
+  if (chunk_size > 0) {
+    g_root_logger->log_batch(msgs, chunk_size);
+  }
+  maybe_report_latency();
+}
+
+void rcl_logging_external_log_structured(const rcl_logging_structured_record_t * record)
+{
+  if (nullptr == record) {
+    return;
+  }
+  rcl_logging_spdlog::ActiveCalls::Guard guard(g_active_calls);
+  if (!guard) {
+    return;
+  }
+  std::string_view name_view(nullptr == record->name ? "" : record->name, record->name_length);
+  spdlog::string_view_t name(name_view.data(), name_view.size());
+  spdlog::level::level_enum level = map_external_log_level_to_library_level(record->severity);
+  spdlog::log_clock::time_point time(
+    std::chrono::duration_cast<spdlog::log_clock::duration>(
+      std::chrono::nanoseconds(record->timestamp_ns)));
+  // Only now that the message passed the level check is it worth formatting.
+  if (!should_log(record->severity, name_view)) {
+    g_message_counters.filtered(level);
+    if (should_record(level)) {
+      g_flight_recorder->record(time, name, level, render(*record));
+    }
+    return;
+  }
+  if (nullptr != g_message_filter) {
+    rcl_logging_spdlog::MessageFilter::Decision decision = g_message_filter->check(
+      name_view, level, std::string_view(record->msg, record->msg_length), false);
+    report_filtered(name_view, level, decision.repeated, decision.dropped);
+    if (!decision.log) {
+      g_message_counters.filtered(level);
+      return;
+    }
+  }
+  if (should_dump(level)) {
+    dump_flight_recorder();
+  }
+  g_message_counters.accepted(level);
+  g_root_logger->log(time, name, level, render(*record));
+  maybe_report_latency();
+}
+
+rcl_logging_ret_t rcl_logging_external_dump_flight_recorder()
+{
+  rcl_logging_spdlog::ActiveCalls::Guard guard(g_active_calls);
+  if (!guard || nullptr == g_flight_recorder) {
+    return RCL_LOGGING_RET_OK;
+  }
+  dump_flight_recorder();
+  g_root_logger->flush();
+  return RCL_LOGGING_RET_OK;
+}
+
+rcl_logging_ret_t rcl_logging_external_get_stats(rcl_logging_stats_t * stats)
+{
+  if (nullptr == stats) {
+    RCUTILS_SET_ERROR_MSG("stats argument must not be null");
+    return RCL_LOGGING_RET_INVALID_ARGUMENT;
+  }
+  *stats = rcl_logging_stats_t();
+  g_message_counters.read(*stats);
+  rcl_logging_spdlog::ActiveCalls::Guard guard(g_active_calls);
+  if (!guard) {
+    return RCL_LOGGING_RET_OK;
+  }
+  rcl_logging_spdlog::WriteStats write_stats = g_file_sink->write_stats();
+  stats->bytes_written = write_stats.bytes;
+  stats->dropped = g_root_logger->dropped();
+  for (const auto & extra_sink : g_extra_sinks) {
+    stats->dropped += extra_sink->dropped();
+  }
+  stats->flush_count = write_stats.flushes;
+  stats->flush_time_ns = static_cast<uint64_t>(write_stats.flush_time.count());
+  stats->queue_depth = g_root_logger->queue_depth();
+  stats->peak_queue_depth = g_root_logger->peak_queue_depth();
+  return RCL_LOGGING_RET_OK;
+}
+
+rcl_logging_ret_t rcl_logging_external_get_latency_histograms(
+  rcl_logging_latency_histograms_t * histograms)
+{
+  if (nullptr == histograms) {
+    RCUTILS_SET_ERROR_MSG("histograms argument must not be null");
+    return RCL_LOGGING_RET_INVALID_ARGUMENT;
+  }
+  rcl_logging_spdlog::ActiveCalls::Guard guard(g_active_calls);
+  if (!guard) {
+    *histograms = rcl_logging_latency_histograms_t();
+    return RCL_LOGGING_RET_OK;
+  }
+  g_file_sink->read_latency(*histograms);
+  return RCL_LOGGING_RET_OK;
+}
+
+bool rcl_logging_external_is_enabled_for(const char * name, int severity)
+{
+  rcl_logging_spdlog::ActiveCalls::Guard guard(g_active_calls);
+  if (!guard) {
+    return false;
+  }
+  return should_log(severity, nullptr == name ? std::string_view() : std::string_view(name)) ||
+         should_record(map_external_log_level_to_library_level(severity));
+}
+
+rcl_logging_ret_t rcl_logging_external_set_logger_level(const char * name, int level)
+{
+  // Hold the lock so that concurrent calls publish their thresholds in the
+  // same order as they update the levels.
+  std::lock_guard<std::mutex> lk(g_logger_mutex);
+  g_logger_levels.set_level(name, level);
+  publish_severity_threshold();
 
   return RCL_LOGGING_RET_OK;
 }
@@ -0,0 +1,71 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+
+#include "rcl_logging_spdlog/active_calls.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+namespace
+{
+
+std::atomic<size_t> g_next_shard{0};
+
+}  // namespace
+
+ActiveCalls::Guard::Guard(ActiveCalls & calls)
+{
+  thread_local size_t index =
+    g_next_shard.fetch_add(1, std::memory_order_relaxed) % kShardCount;
+  std::atomic<size_t> & count = calls.shards_[index].count;
+  // Both sequentially consistent, like the store in close(): either close()
+  // sees this count, or this sees it closed.
+  count.fetch_add(1, std::memory_order_seq_cst);
+  if (calls.open_.load(std::memory_order_seq_cst)) {
+    count_ = &count;
+  } else {
+    count.fetch_sub(1, std::memory_order_release);
+    count_ = nullptr;
+  }
+}
+
+ActiveCalls::Guard::~Guard()
+{
+  if (nullptr != count_) {
+    count_->fetch_sub(1, std::memory_order_release);
+  }
+}
+
+void
+ActiveCalls::open()
+{
+  open_.store(true, std::memory_order_seq_cst);
+}
+
+void
+ActiveCalls::close()
+{
+  open_.store(false, std::memory_order_seq_cst);
+  for (Shard & shard : shards_) {
+    while (0 != shard.count.load(std::memory_order_acquire)) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+}  // namespace rcl_logging_spdlog
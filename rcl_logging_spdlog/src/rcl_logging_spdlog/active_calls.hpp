@@ -0,0 +1,89 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_LOGGING_SPDLOG__ACTIVE_CALLS_HPP_
+#define RCL_LOGGING_SPDLOG__ACTIVE_CALLS_HPP_
+
+#include <atomic>
+#include <cstddef>
+
+#include "rcl_logging_interface/visibility_control.h"
+
+namespace rcl_logging_spdlog
+{
+
+/// Lets calls into the backend in while it is set up, and waits for them to leave.
+/**
+ * Shutdown closes it before freeing what the calls use, which makes sure that
+ * no call still uses any of it: a call either sees it closed and turns back,
+ * or is waited for.
+ * Each thread counts its calls in one of a fixed number of shards, picked when
+ * it first calls, so that threads logging at once mostly don't write to the
+ * same cache line.
+ */
+class RCL_LOGGING_INTERFACE_LOCAL ActiveCalls final
+{
+public:
+  ActiveCalls() = default;
+
+  ActiveCalls(const ActiveCalls &) = delete;
+  ActiveCalls & operator=(const ActiveCalls &) = delete;
+
+  /// Counts a call for as long as it lives, if it was let in.
+  class Guard final
+  {
+public:
+    explicit Guard(ActiveCalls & calls);
+
+    ~Guard();
+
+    Guard(const Guard &) = delete;
+    Guard & operator=(const Guard &) = delete;
+
+    /// Whether the call was let in, and may use the state of the backend.
+    explicit operator bool() const
+    {
+      return nullptr != count_;
+    }
+
+private:
+    std::atomic<size_t> * count_;
+  };
+
+  /// Let calls in, once everything they use is in place.
+  void
+  open();
+
+  /// Turn new calls away, and wait until those already in have left.
+  /**
+   * This must not be called from within a call.
+   */
+  void
+  close();
+
+private:
+  static constexpr size_t kShardCount = 16;
+
+  struct alignas(64) Shard
+  {
+    std::atomic<size_t> count{0};
+  };
+
+  std::atomic<bool> open_{false};
+  Shard shards_[kShardCount];
+};
+
+}  // namespace rcl_logging_spdlog
+
+#endif  // RCL_LOGGING_SPDLOG__ACTIVE_CALLS_HPP_
@@ -0,0 +1,369 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "rcutils/allocator.h"
+
+#include "spdlog/common.h"
+#include "spdlog/details/log_msg.h"
+#include "spdlog/sinks/sink.h"
+
+#include "rcl_logging_spdlog/async_writer.hpp"
+#include "rcl_logging_spdlog/flight_recorder.hpp"
+#include "rcl_logging_spdlog/thread_settings.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+namespace
+{
+
+// How often a blocked caller yields before it starts sleeping.
+constexpr unsigned kBlockedYields = 64;
+constexpr std::chrono::microseconds kBlockedSleep{50};
+
+}  // namespace
+
+AsyncWriter::AsyncWriter(
+  std::vector<spdlog::sink_ptr> sinks, const AsyncWriterSettings & settings,
+  rcutils_allocator_t allocator, spdlog::err_handler error_handler)
+: sinks_(std::move(sinks)),
+  allocator_(allocator),
+  error_handler_(std::move(error_handler)),
+  overflow_policy_(settings.overflow_policy),
+  keep_level_(settings.keep_level),
+  capacity_(settings.queue_size),
+  record_size_(settings.record_size),
+  shed_size_(settings.queue_size - settings.queue_size / 4),
+  entries_(nullptr),
+  text_(nullptr),
+  enqueue_position_(0),
+  dequeue_position_(0),
+  peak_(0),
+  dropped_(0),
+  flush_requested_(false),
+  idle_(false),
+  stopping_(false)
+{
+  // So that none of the sizes below overflow.
+  if (0 == capacity_ || capacity_ > kMaxQueueSize) {
+    throw std::length_error(
+            "queue size must be between 1 and " + std::to_string(kMaxQueueSize) + ", not " +
+            std::to_string(capacity_));
+  }
+  if (record_size_ > kMaxRecordSize || capacity_ * record_size_ > kMaxQueueTextSize) {
+    throw std::length_error(
+            "record size must be at most " + std::to_string(kMaxRecordSize) +
+            ", and with the queue size at most " + std::to_string(kMaxQueueTextSize) +
+            " bytes in total, not " + std::to_string(capacity_) + " x " +
+            std::to_string(record_size_));
+  }
+  entries_ = static_cast<Entry *>(
+    allocator_.allocate(capacity_ * sizeof(Entry), allocator_.state));
+  if (nullptr == entries_) {
+    throw std::bad_alloc();
+  }
+  for (size_t i = 0; i < capacity_; ++i) {
+    new (&entries_[i]) Entry();
+    entries_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  text_ = static_cast<char *>(allocator_.allocate(capacity_ * record_size_, allocator_.state));
+  if (nullptr == text_) {
+    release();
+    throw std::bad_alloc();
+  }
+  // Fault the pages in now rather than on the first messages going there.
+  std::memset(text_, 0, capacity_ * record_size_);
+
+  try {
+    thread_ = std::thread(&AsyncWriter::run, this, settings.threads);
+  } catch (...) {
+    stop();
+    release();
+    throw;
+  }
+}
+
+AsyncWriter::~AsyncWriter()
+{
+  stop();
+  release();
+}
+
+void
+AsyncWriter::post(const spdlog::details::log_msg & msg)
+{
+  if (OverflowPolicy::shed_by_severity == overflow_policy_ &&
+    msg.level < keep_level_ && queue_depth() >= shed_size_)
+  {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  switch (overflow_policy_) {
+    case OverflowPolicy::block:
+      for (unsigned attempt = 0; !try_push(msg); ++attempt) {
+        if (attempt < kBlockedYields) {
+          std::this_thread::yield();
+        } else {
+          std::this_thread::sleep_for(kBlockedSleep);
+        }
+      }
+      return;
+    case OverflowPolicy::discard_new:
+      if (!try_push(msg)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+      }
+      return;
+    case OverflowPolicy::overrun_oldest:
+    case OverflowPolicy::shed_by_severity:
+      // Dropping the oldest message only hands its entry back, there is
+      // nothing to free.
+      while (!try_push(msg)) {
+        if (try_pop(false)) {
+          dropped_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+          // Every message in the queue is being written right now.
+          std::this_thread::yield();
+        }
+      }
+      return;
+  }
+}
+
+void
+AsyncWriter::post_flush()
+{
+  flush_requested_.store(true, std::memory_order_release);
+  wake();
+}
+
+uint64_t
+AsyncWriter::queue_depth() const
+{
+  // In this order, so that the result is never negative.
+  uint64_t dequeued = dequeue_position_.load(std::memory_order_relaxed);
+  uint64_t enqueued = enqueue_position_.load(std::memory_order_relaxed);
+  return std::min<uint64_t>(enqueued - dequeued, capacity_);
+}
+
+uint64_t
+AsyncWriter::peak_queue_depth() const
+{
+  return peak_.load(std::memory_order_relaxed);
+}
+
+uint64_t
+AsyncWriter::dropped() const
+{
+  return dropped_.load(std::memory_order_relaxed);
+}
+
+// Each entry is handed between producers and the writer thread through its
+// sequence, as in Dmitry Vyukov's bounded MPMC queue.
+bool
+AsyncWriter::try_push(const spdlog::details::log_msg & msg)
+{
+  uint64_t position = enqueue_position_.load(std::memory_order_relaxed);
+  Entry * entry;
+  for (;;) {
+    entry = &entries_[position % capacity_];
+    uint64_t sequence = entry->sequence.load(std::memory_order_acquire);
+    if (sequence == position) {
+      if (enqueue_position_.compare_exchange_weak(
+          position, position + 1, std::memory_order_relaxed))
+      {
+        break;
+      }
+    } else if (sequence < position) {
+      // Still holding the message from the previous round, the queue is full.
+      return false;
+    } else {
+      position = enqueue_position_.load(std::memory_order_relaxed);
+    }
+  }
+
+  entry->time = msg.time;
+  entry->level = msg.level;
+  entry->thread_id = msg.thread_id;
+  entry->replayed = is_replayed(msg);
+  entry->name_length = std::min(msg.logger_name.size(), record_size_);
+  entry->msg_length = std::min(msg.payload.size(), record_size_ - entry->name_length);
+  char * text = text_ + (position % capacity_) * record_size_;
+  std::memcpy(text, msg.logger_name.data(), entry->name_length);
+  std::memcpy(text + entry->name_length, msg.payload.data(), entry->msg_length);
+  entry->sequence.store(position + 1, std::memory_order_release);
+
+  // Once the queue was overrun this overestimates, but the peak was the full
+  // queue then anyway.
+  uint64_t depth = std::min<uint64_t>(
+    position + 1 - dequeue_position_.load(std::memory_order_relaxed), capacity_);
+  uint64_t peak = peak_.load(std::memory_order_relaxed);
+  while (depth > peak && !peak_.compare_exchange_weak(peak, depth, std::memory_order_relaxed)) {
+  }
+  wake();
+  return true;
+}
+
+bool
+AsyncWriter::try_pop(bool write)
+{
+  uint64_t position = dequeue_position_.load(std::memory_order_relaxed);
+  Entry * entry;
+  for (;;) {
+    entry = &entries_[position % capacity_];
+    uint64_t sequence = entry->sequence.load(std::memory_order_acquire);
+    if (sequence == position + 1) {
+      if (dequeue_position_.compare_exchange_weak(
+          position, position + 1, std::memory_order_relaxed))
+      {
+        break;
+      }
+    } else if (sequence < position + 1) {
+      // Empty, or the next message is still being copied in.
+      return false;
+    } else {
+      position = dequeue_position_.load(std::memory_order_relaxed);
+    }
+  }
+
+  if (write) {
+    this->write(*entry, text_ + (position % capacity_) * record_size_);
+  }
+  entry->sequence.store(position + capacity_, std::memory_order_release);
+  return true;
+}
+
+void
+AsyncWriter::write(const Entry & entry, const char * text)
+{
+  spdlog::details::log_msg msg(
+    entry.time,
+    entry.replayed ? spdlog::source_loc(kReplayedSourceFile, 0, "") : spdlog::source_loc(),
+    spdlog::string_view_t(text, entry.name_length),
+    entry.level, spdlog::string_view_t(text + entry.name_length, entry.msg_length));
+  msg.thread_id = entry.thread_id;
+  try {
+    for (const auto & sink : sinks_) {
+      if (sink->should_log(msg.level)) {
+        sink->log(msg);
+      }
+    }
+  } catch (const std::exception & ex) {
+    error_handler_(ex.what());
+  }
+}
+
+void
+AsyncWriter::wake()
+{
+  // Pairs with the fence in run(): either the writer thread sees the message
+  // or flush request, or this sees it idle.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (idle_.load(std::memory_order_relaxed)) {
+    // Once the mutex is free the thread either waits, or is yet to check for
+    // work and sees the message, so the notification can't get lost.
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+    }
+    condition_.notify_one();
+  }
+}
+
+void
+AsyncWriter::run(const ThreadSettings & thread_settings)
+{
+  apply_thread_settings(thread_settings);
+  bool stopping = false;
+  for (;;) {
+    // Taken before writing, so that everything posted before it is written
+    // before flushing.
+    bool flush = flush_requested_.exchange(false, std::memory_order_acq_rel);
+    bool wrote = false;
+    while (try_pop(true)) {
+      wrote = true;
+    }
+    if (flush) {
+      try {
+        for (const auto & sink : sinks_) {
+          sink->flush();
+        }
+      } catch (const std::exception & ex) {
+        error_handler_(ex.what());
+      }
+    }
+    // Nothing is posted anymore once stopping, so what was is written now.
+    if (stopping) {
+      return;
+    }
+    if (wrote || flush) {
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    condition_.wait(
+      lock, [this]() {
+        return stopping_ || 0 != queue_depth() ||
+        flush_requested_.load(std::memory_order_relaxed);
+      });
+    idle_.store(false, std::memory_order_relaxed);
+    stopping = stopping_;
+  }
+}
+
+void
+AsyncWriter::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  condition_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void
+AsyncWriter::release()
+{
+  if (nullptr != entries_) {
+    for (size_t i = 0; i < capacity_; ++i) {
+      entries_[i].~Entry();
+    }
+    allocator_.deallocate(entries_, allocator_.state);
+    entries_ = nullptr;
+  }
+  if (nullptr != text_) {
+    allocator_.deallocate(text_, allocator_.state);
+    text_ = nullptr;
+  }
+}
+
+}  // namespace rcl_logging_spdlog
@@ -0,0 +1,216 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_LOGGING_SPDLOG__ASYNC_WRITER_HPP_
+#define RCL_LOGGING_SPDLOG__ASYNC_WRITER_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rcutils/allocator.h"
+
+#include "spdlog/common.h"
+#include "spdlog/details/log_msg.h"
+
+#include "rcl_logging_interface/visibility_control.h"
+
+#include "rcl_logging_spdlog/thread_settings.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+/// What posting a message to the full queue of an AsyncWriter does.
+enum class OverflowPolicy
+{
+  /// Wait until there is room.
+  block,
+  /// Drop the message posted.
+  discard_new,
+  /// Drop the oldest message in the queue.
+  overrun_oldest,
+  /// Drop messages below AsyncWriterSettings::keep_level already once the
+  /// queue is three quarters full, keeping the rest of it for the others,
+  /// which drop the oldest message in the queue when it is full.
+  shed_by_severity,
+};
+
+/// How an AsyncWriter queues messages.
+struct AsyncWriterSettings
+{
+  /// The number of messages the queue holds.
+  size_t queue_size = 8192;
+  /// The room in each entry of the queue for the logger name and message.
+  size_t record_size = 512;
+  OverflowPolicy overflow_policy = OverflowPolicy::block;
+  /// The lowest level kept by OverflowPolicy::shed_by_severity.
+  spdlog::level::level_enum keep_level = spdlog::level::err;
+  /// Where and how the writer thread runs.
+  ThreadSettings threads;
+};
+
+/// Writes messages to a set of sinks from a background thread.
+/**
+ * Posting a message copies it into an entry of a bounded, lock-free queue, so
+ * whatever the overflow policy the caller never waits for the writer thread to
+ * write anything.
+ * The entries, with record_size bytes each for the name and message, are a
+ * pool allocated and written to up front, so posting doesn't allocate or
+ * fault in a page either.
+ * Messages larger than record_size are truncated to it, rather than
+ * allocating room for them on the calling thread.
+ * That makes posting safe for real-time threads, as long as the policy isn't
+ * OverflowPolicy::block.
+ *
+ * A single thread writes the messages out, so they reach the sinks in the
+ * order they were queued, and flushes after everything posted before.
+ *
+ * Waking up the writer thread is only needed when it is idle, and then takes
+ * its mutex, which it holds just to check for work before it waits, so that
+ * the wake up can't get lost in between.
+ *
+ * Destroying the writer writes out whatever is still queued.
+ */
+class RCL_LOGGING_INTERFACE_LOCAL AsyncWriter final
+{
+public:
+  /// The most messages the queue can hold.
+  static constexpr size_t kMaxQueueSize = size_t(1) << 24;
+  /// The most bytes of name and message an entry can hold.
+  static constexpr size_t kMaxRecordSize = size_t(1) << 20;
+  /// The most bytes of name and message all entries together can hold.
+  static constexpr size_t kMaxQueueTextSize = size_t(1) << 30;
+
+  /// Allocate the queue and start the writer thread.
+  /**
+   * \param allocator allocates the queue, and frees it once the writer is
+   *   destroyed.
+   * \param error_handler gets what sinks throw, on the writer thread.
+   * \throws std::length_error if the queue would be empty or larger than the
+   *   limits above, before allocating anything.
+   * \throws std::bad_alloc if the queue can't be allocated.
+   * \throws std::system_error if a thread can't be started.
+   */
+  AsyncWriter(
+    std::vector<spdlog::sink_ptr> sinks, const AsyncWriterSettings & settings,
+    rcutils_allocator_t allocator, spdlog::err_handler error_handler);
+
+  ~AsyncWriter();
+
+  AsyncWriter(const AsyncWriter &) = delete;
+  AsyncWriter & operator=(const AsyncWriter &) = delete;
+
+  /// Queue a message for the sinks which should log its level.
+  /**
+   * Only the first record_size bytes of the name and message are queued,
+   * the name first.
+   */
+  void
+  post(const spdlog::details::log_msg & msg);
+
+  /// Have the sinks flushed, once what was posted before is written.
+  /**
+   * This never counts against the queue, so it is never dropped.
+   */
+  void
+  post_flush();
+
+  /// The number of messages waiting in the queue.
+  uint64_t
+  queue_depth() const;
+
+  /// The largest queue_depth() seen when posting a message.
+  uint64_t
+  peak_queue_depth() const;
+
+  /// The number of messages dropped because the queue was full.
+  uint64_t
+  dropped() const;
+
+private:
+  struct Entry
+  {
+    // The position in the queue the entry is free for, or plus one the
+    // position of the message it holds.
+    std::atomic<uint64_t> sequence;
+    spdlog::log_clock::time_point time;
+    spdlog::level::level_enum level;
+    size_t thread_id;
+    // Replayed by the flight recorder, see is_replayed().
+    bool replayed;
+    size_t name_length;
+    size_t msg_length;
+  };
+
+  // Queue msg, truncated to record_size_.
+  bool
+  try_push(const spdlog::details::log_msg & msg);
+
+  // Take the oldest message off the queue, writing it to the sinks if write.
+  bool
+  try_pop(bool write);
+
+  void
+  write(const Entry & entry, const char * text);
+
+  void
+  wake();
+
+  void
+  run(const ThreadSettings & thread_settings);
+
+  void
+  stop();
+
+  // Free what the constructor allocated.
+  void
+  release();
+
+  std::vector<spdlog::sink_ptr> sinks_;
+  rcutils_allocator_t allocator_;
+  spdlog::err_handler error_handler_;
+  OverflowPolicy overflow_policy_;
+  spdlog::level::level_enum keep_level_;
+  size_t capacity_;
+  size_t record_size_;
+  // How full the queue may be for messages shed by OverflowPolicy::shed_by_severity.
+  size_t shed_size_;
+  Entry * entries_;
+  // capacity_ times record_size_ bytes.
+  char * text_;
+
+  // On lines of their own, as producers and the writer thread each update one.
+  alignas(64) std::atomic<uint64_t> enqueue_position_;
+  alignas(64) std::atomic<uint64_t> dequeue_position_;
+  alignas(64) std::atomic<uint64_t> peak_;
+  std::atomic<uint64_t> dropped_;
+  std::atomic<bool> flush_requested_;
+  // Whether the writer thread is about to wait, or waiting.
+  std::atomic<bool> idle_;
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  bool stopping_;
+  std::thread thread_;
+};
+
+}  // namespace rcl_logging_spdlog
+
+#endif  // RCL_LOGGING_SPDLOG__ASYNC_WRITER_HPP_
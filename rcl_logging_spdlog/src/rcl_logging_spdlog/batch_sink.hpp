@@ -0,0 +1,44 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_LOGGING_SPDLOG__BATCH_SINK_HPP_
+#define RCL_LOGGING_SPDLOG__BATCH_SINK_HPP_
+
+#include <cstddef>
+
+#include "spdlog/details/log_msg.h"
+
+#include "rcl_logging_interface/visibility_control.h"
+
+namespace rcl_logging_spdlog
+{
+
+/// A sink which can write several messages while taking its lock only once.
+/**
+ * Logger::log_batch() hands batches to the sinks which implement this, and
+ * falls back to one message at a time for those which don't.
+ */
+class RCL_LOGGING_INTERFACE_LOCAL BatchSink
+{
+public:
+  virtual ~BatchSink() = default;
+
+  /// Write those of the messages which are of at least the level of the sink, in order.
+  virtual void
+  log_batch(const spdlog::details::log_msg * msgs, size_t count) = 0;
+};
+
+}  // namespace rcl_logging_spdlog
+
+#endif  // RCL_LOGGING_SPDLOG__BATCH_SINK_HPP_
@@ -0,0 +1,158 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "rcutils/logging.h"
+
+#include "spdlog/details/log_msg.h"
+
+#include "rcl_logging_spdlog/binary_file_sink.hpp"
+#include "rcl_logging_spdlog/binary_log_format.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+namespace
+{
+
+uint8_t
+map_library_level_to_external_severity(spdlog::level::level_enum level)
+{
+  switch (level) {
+    case spdlog::level::level_enum::trace:
+    case spdlog::level::level_enum::debug:
+      return RCUTILS_LOG_SEVERITY_DEBUG;
+    case spdlog::level::level_enum::info:
+      return RCUTILS_LOG_SEVERITY_INFO;
+    case spdlog::level::level_enum::warn:
+      return RCUTILS_LOG_SEVERITY_WARN;
+    case spdlog::level::level_enum::err:
+      return RCUTILS_LOG_SEVERITY_ERROR;
+    default:
+      return RCUTILS_LOG_SEVERITY_FATAL;
+  }
+}
+
+}  // namespace
+
+BinaryFileSink::BinaryFileSink(
+  std::unique_ptr<FileWriter> writer, const FlushSettings & flush_settings)
+: FileSink(flush_settings),
+  writer_(std::move(writer)),
+  next_logger_name_id_(binary_log::kRootLoggerNameId + 1)
+{
+  // An existing file already has a header, and logger name definitions are
+  // simply repeated after it. A file which isn't open yet gets its header with
+  // the first record.
+  if (writer_->is_open() && 0 == writer_->size()) {
+    write_file_header();
+  }
+}
+
+void
+BinaryFileSink::sink_it_(const spdlog::details::log_msg & msg)
+{
+  // Every segment of a rotated log has to be decodable on its own, and a lazily
+  // opened file is still empty here for the first record.
+  size_t max_size = 2 * binary_log::kRecordHeaderSize + msg.logger_name.size() +
+    msg.payload.size();
+  if (writer_->rotate_if_needed(max_size) || 0 == writer_->size()) {
+    logger_name_ids_.clear();
+    next_logger_name_id_ = binary_log::kRootLoggerNameId + 1;
+    write_file_header();
+  }
+
+  int64_t timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    msg.time.time_since_epoch()).count();
+  uint32_t name_id = intern_logger_name(
+    std::string_view(msg.logger_name.data(), msg.logger_name.size()), timestamp_ns);
+  write_record(
+    timestamp_ns, name_id, map_library_level_to_external_severity(msg.level),
+    binary_log::RecordType::message,
+    std::string_view(msg.payload.data(), msg.payload.size()));
+  flush_policy().record_written(
+    *writer_, msg, binary_log::kRecordHeaderSize + msg.payload.size());
+}
+
+void
+BinaryFileSink::log_batch(const spdlog::details::log_msg * msgs, size_t count)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (size_t i = 0; i < count; ++i) {
+    if (should_log(msgs[i].level)) {
+      sink_it_(msgs[i]);
+    }
+  }
+}
+
+void
+BinaryFileSink::flush_()
+{
+  flush_policy().flush(*writer_);
+}
+
+void
+BinaryFileSink::write_file_header()
+{
+  char header[binary_log::kFileHeaderSize];
+  binary_log::encode_file_header(header);
+  writer_->write(header, sizeof(header));
+}
+
+uint32_t
+BinaryFileSink::intern_logger_name(std::string_view name, int64_t timestamp_ns)
+{
+  if (name.empty()) {
+    return binary_log::kRootLoggerNameId;
+  }
+  auto it = logger_name_ids_.find(name);
+  if (it != logger_name_ids_.end()) {
+    return it->second;
+  }
+  uint32_t name_id = next_logger_name_id_++;
+  logger_name_ids_.emplace(std::string(name), name_id);
+  write_record(
+    timestamp_ns, name_id, 0, binary_log::RecordType::logger_name, name);
+  return name_id;
+}
+
+void
+BinaryFileSink::write_record(
+  int64_t timestamp_ns, uint32_t name_id, uint8_t severity,
+  binary_log::RecordType type, std::string_view payload)
+{
+  binary_log::RecordHeader header;
+  header.timestamp_ns = timestamp_ns;
+  header.name_id = name_id;
+  header.length = static_cast<uint32_t>(payload.size());
+  header.severity = severity;
+  header.type = type;
+
+  char encoded_header[binary_log::kRecordHeaderSize];
+  binary_log::encode_record_header(header, encoded_header);
+  buffer_.clear();
+  buffer_.append(encoded_header, encoded_header + sizeof(encoded_header));
+  buffer_.append(payload.data(), payload.data() + payload.size());
+  writer_->write(buffer_.data(), buffer_.size());
+}
+
+}  // namespace rcl_logging_spdlog
@@ -0,0 +1,83 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_LOGGING_SPDLOG__BINARY_FILE_SINK_HPP_
+#define RCL_LOGGING_SPDLOG__BINARY_FILE_SINK_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "spdlog/details/log_msg.h"
+
+#include "rcl_logging_interface/visibility_control.h"
+
+#include "rcl_logging_spdlog/binary_log_format.hpp"
+#include "rcl_logging_spdlog/file_sink.hpp"
+#include "rcl_logging_spdlog/file_writer.hpp"
+#include "rcl_logging_spdlog/flush_policy.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+/// An spdlog sink which writes records in the binary log format.
+/**
+ * No pattern formatting happens: each message is written as a fixed size
+ * header followed by the raw payload, and logger names are interned.
+ * See binary_log_format.hpp for the layout, and the decode_binary_log tool to
+ * turn the file back into text.
+ */
+class RCL_LOGGING_INTERFACE_LOCAL BinaryFileSink final : public FileSink
+{
+public:
+  /// Create a sink writing a binary log through the given writer.
+  BinaryFileSink(std::unique_ptr<FileWriter> writer, const FlushSettings & flush_settings);
+
+  void
+  log_batch(const spdlog::details::log_msg * msgs, size_t count) override;
+
+protected:
+  void
+  sink_it_(const spdlog::details::log_msg & msg) override;
+
+  void
+  flush_() override;
+
+private:
+  void
+  write_file_header();
+
+  uint32_t
+  intern_logger_name(std::string_view name, int64_t timestamp_ns);
+
+  void
+  write_record(
+    int64_t timestamp_ns, uint32_t name_id, uint8_t severity,
+    binary_log::RecordType type, std::string_view payload);
+
+  std::unique_ptr<FileWriter> writer_;
+  std::map<std::string, uint32_t, std::less<>> logger_name_ids_;
+  uint32_t next_logger_name_id_;
+  // Reused for every record so that steady state logging doesn't allocate.
+  spdlog::memory_buf_t buffer_;
+};
+
+}  // namespace rcl_logging_spdlog
+
+#endif  // RCL_LOGGING_SPDLOG__BINARY_FILE_SINK_HPP_
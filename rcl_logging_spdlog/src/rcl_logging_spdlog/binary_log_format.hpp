@@ -0,0 +1,188 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_LOGGING_SPDLOG__BINARY_LOG_FORMAT_HPP_
+#define RCL_LOGGING_SPDLOG__BINARY_LOG_FORMAT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// The binary log file format.
+//
+// A file starts with a file header:
+//   8 bytes   magic, "RCLBLOG\0"
+//   4 bytes   format version
+//   4 bytes   reserved, zero
+// followed by records, each made of a record header:
+//   8 bytes   timestamp, signed nanoseconds since the epoch
+//   4 bytes   logger name id
+//   4 bytes   payload length in bytes
+//   1 byte    severity, as an rcutils severity level
+//   1 byte    record type
+//   2 bytes   reserved, zero
+// followed by the payload.
+//
+// All integers are little endian.
+// Logger names are interned: the first time a logger name shows up in a file,
+// a logger_name record with the new id and the name as its payload comes
+// before the message record.  Id 0 is the root logger and is never defined.
+// Message records carry the message exactly as it would have been written by
+// the "%v" text pattern, without the trailing newline.
+
+namespace rcl_logging_spdlog
+{
+namespace binary_log
+{
+
+constexpr char kMagic[8] = {'R', 'C', 'L', 'B', 'L', 'O', 'G', '\0'};
+constexpr uint32_t kVersion = 1;
+constexpr size_t kFileHeaderSize = 16;
+constexpr size_t kRecordHeaderSize = 20;
+constexpr uint32_t kRootLoggerNameId = 0;
+
+enum class RecordType : uint8_t
+{
+  message = 0,
+  logger_name = 1,
+};
+
+struct RecordHeader
+{
+  int64_t timestamp_ns = 0;
+  uint32_t name_id = 0;
+  uint32_t length = 0;
+  uint8_t severity = 0;
+  RecordType type = RecordType::message;
+};
+
+inline void
+store_le(char * out, uint64_t value, size_t size)
+{
+  for (size_t i = 0; i < size; ++i) {
+    out[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+  }
+}
+
+inline uint64_t
+load_le(const char * in, size_t size)
+{
+  uint64_t value = 0;
+  for (size_t i = 0; i < size; ++i) {
+    value |= static_cast<uint64_t>(static_cast<unsigned char>(in[i])) << (8 * i);
+  }
+  return value;
+}
+
+inline void
+encode_file_header(char (& out)[kFileHeaderSize])
+{
+  std::memcpy(out, kMagic, sizeof(kMagic));
+  store_le(out + 8, kVersion, 4);
+  store_le(out + 12, 0, 4);
+}
+
+inline void
+encode_record_header(const RecordHeader & header, char (& out)[kRecordHeaderSize])
+{
+  store_le(out, static_cast<uint64_t>(header.timestamp_ns), 8);
+  store_le(out + 8, header.name_id, 4);
+  store_le(out + 12, header.length, 4);
+  store_le(out + 16, header.severity, 1);
+  store_le(out + 17, static_cast<uint8_t>(header.type), 1);
+  store_le(out + 18, 0, 2);
+}
+
+inline RecordHeader
+decode_record_header(const char (& in)[kRecordHeaderSize])
+{
+  RecordHeader header;
+  header.timestamp_ns = static_cast<int64_t>(load_le(in, 8));
+  header.name_id = static_cast<uint32_t>(load_le(in + 8, 4));
+  header.length = static_cast<uint32_t>(load_le(in + 12, 4));
+  header.severity = static_cast<uint8_t>(load_le(in + 16, 1));
+  header.type = static_cast<RecordType>(load_le(in + 17, 1));
+  return header;
+}
+
+/// Decode a binary log into the text the "%v" pattern would have produced.
+/**
+ * \param[in] in The binary log.
+ * \param[out] out Where to write one line per message record.
+ * \param[out] error A description of the problem if decoding fails.
+ * \return true if the whole input was decoded, false otherwise.
+ */
+inline bool
+decode_to_text(std::istream & in, std::ostream & out, std::string & error)
+{
+  char file_header[kFileHeaderSize];
+  if (!in.read(file_header, sizeof(file_header))) {
+    error = "file is too short for a binary log header";
+    return false;
+  }
+  if (std::memcmp(file_header, kMagic, sizeof(kMagic)) != 0) {
+    error = "file is not a binary log";
+    return false;
+  }
+  uint32_t version = static_cast<uint32_t>(load_le(file_header + 8, 4));
+  if (version != kVersion) {
+    error = "unsupported binary log version " + std::to_string(version);
+    return false;
+  }
+
+  std::unordered_map<uint32_t, std::string> logger_names;
+  std::vector<char> payload;
+  char record_header[kRecordHeaderSize];
+  while (in.read(record_header, sizeof(record_header))) {
+    RecordHeader header = decode_record_header(record_header);
+    payload.resize(header.length);
+    if (header.length > 0 && !in.read(payload.data(), header.length)) {
+      error = "truncated record payload";
+      return false;
+    }
+    switch (header.type) {
+      case RecordType::message:
+        if (header.name_id != kRootLoggerNameId &&
+          logger_names.find(header.name_id) == logger_names.end())
+        {
+          error = "message refers to undefined logger name id " + std::to_string(header.name_id);
+          return false;
+        }
+        out.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+        out.put('\n');
+        break;
+      case RecordType::logger_name:
+        logger_names[header.name_id] = std::string(payload.data(), payload.size());
+        break;
+      default:
+        error = "unknown record type " + std::to_string(static_cast<int>(header.type));
+        return false;
+    }
+  }
+  if (in.gcount() != 0) {
+    error = "truncated record header";
+    return false;
+  }
+  return true;
+}
+
+}  // namespace binary_log
+}  // namespace rcl_logging_spdlog
+
+#endif  // RCL_LOGGING_SPDLOG__BINARY_LOG_FORMAT_HPP_
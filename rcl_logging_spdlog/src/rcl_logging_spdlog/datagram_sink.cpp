@@ -0,0 +1,125 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <string>
+
+#include "spdlog/common.h"
+#include "spdlog/details/log_msg.h"
+
+#include "rcl_logging_spdlog/datagram_sink.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+DatagramSink::DatagramSink(Protocol protocol, const std::string & address)
+: fd_(-1)
+{
+#ifdef _WIN32
+  (void)protocol;
+  (void)address;
+  spdlog::throw_spdlog_ex("Datagram sinks are not supported on this platform");
+#else
+  int family = AF_UNIX;
+  if (Protocol::udp == protocol) {
+    size_t separator = address.rfind(':');
+    if (std::string::npos == separator) {
+      spdlog::throw_spdlog_ex("Expected '<host>:<port>', got '" + address + "'");
+    }
+    std::string host = address.substr(0, separator);
+    // IPv6 addresses are put in brackets to set them apart from the port.
+    if (host.size() >= 2 && '[' == host.front() && ']' == host.back()) {
+      host = host.substr(1, host.size() - 2);
+    }
+    std::string port = address.substr(separator + 1);
+    struct addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+    hints.ai_flags = AI_NUMERICSERV;
+    struct addrinfo * found = nullptr;
+    int error = ::getaddrinfo(host.c_str(), port.c_str(), &hints, &found);
+    if (0 != error) {
+      spdlog::throw_spdlog_ex(
+        "Failed resolving address '" + address + "': " + ::gai_strerror(error));
+    }
+    family = found->ai_family;
+    address_.assign(reinterpret_cast<const char *>(found->ai_addr), found->ai_addrlen);
+    ::freeaddrinfo(found);
+  } else {
+    struct sockaddr_un socket_address;
+    std::memset(&socket_address, 0, sizeof(socket_address));
+    if (address.empty() || address.size() >= sizeof(socket_address.sun_path)) {
+      spdlog::throw_spdlog_ex("Invalid Unix domain socket path '" + address + "'");
+    }
+    socket_address.sun_family = AF_UNIX;
+    std::memcpy(socket_address.sun_path, address.data(), address.size());
+    address_.assign(reinterpret_cast<const char *>(&socket_address), sizeof(socket_address));
+  }
+
+  fd_ = ::socket(family, SOCK_DGRAM, 0);
+  if (fd_ < 0) {
+    spdlog::throw_spdlog_ex("Failed creating a socket for '" + address + "'", errno);
+  }
+  if (0 != ::fcntl(fd_, F_SETFD, FD_CLOEXEC) ||
+    0 != ::fcntl(fd_, F_SETFL, ::fcntl(fd_, F_GETFL) | O_NONBLOCK))
+  {
+    int error = errno;
+    ::close(fd_);
+    spdlog::throw_spdlog_ex("Failed setting up the socket for '" + address + "'", error);
+  }
+#endif
+}
+
+DatagramSink::~DatagramSink()
+{
+#ifndef _WIN32
+  if (fd_ >= 0) {
+    ::close(fd_);
+  }
+#endif
+}
+
+void
+DatagramSink::sink_it_(const spdlog::details::log_msg & msg)
+{
+  buffer_.clear();
+  formatter_->format(msg, buffer_);
+#ifndef _WIN32
+  // A message which can't be sent is lost either way, and there is nowhere to
+  // report it from here.
+  static_cast<void>(::sendto(
+    fd_, buffer_.data(), buffer_.size(), 0,
+    reinterpret_cast<const struct sockaddr *>(address_.data()),
+    static_cast<socklen_t>(address_.size())));
+#endif
+}
+
+void
+DatagramSink::flush_()
+{
+  // Every message is sent right away.
+}
+
+}  // namespace rcl_logging_spdlog
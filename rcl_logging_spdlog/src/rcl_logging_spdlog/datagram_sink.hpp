@@ -0,0 +1,78 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_LOGGING_SPDLOG__DATAGRAM_SINK_HPP_
+#define RCL_LOGGING_SPDLOG__DATAGRAM_SINK_HPP_
+
+#include <mutex>
+#include <string>
+
+#include "spdlog/details/log_msg.h"
+#include "spdlog/sinks/base_sink.h"
+
+#include "rcl_logging_interface/visibility_control.h"
+
+namespace rcl_logging_spdlog
+{
+
+/// An spdlog sink which sends each message as a datagram, to a local or remote listener.
+/**
+ * Messages are formatted like for a text log, one per datagram.
+ * Sending never waits: messages which the socket can't take right away, which
+ * don't fit into a datagram, or which nothing is listening for are dropped.
+ *
+ * This is only available on POSIX systems.
+ */
+class RCL_LOGGING_INTERFACE_LOCAL DatagramSink final
+  : public spdlog::sinks::base_sink<std::mutex>
+{
+public:
+  enum class Protocol
+  {
+    /// Over UDP, to an address of the form "<host>:<port>".
+    udp,
+    /// Over a Unix domain socket, to an address which is the path of the socket.
+    unix_socket,
+  };
+
+  /// Create a sink sending to address.
+  /**
+   * \throws spdlog::spdlog_ex if the address can't be resolved, or the socket
+   *   can't be created.
+   */
+  DatagramSink(Protocol protocol, const std::string & address);
+
+  ~DatagramSink() override;
+
+  DatagramSink(const DatagramSink &) = delete;
+  DatagramSink & operator=(const DatagramSink &) = delete;
+
+protected:
+  void
+  sink_it_(const spdlog::details::log_msg & msg) override;
+
+  void
+  flush_() override;
+
+private:
+  int fd_;
+  // The struct sockaddr to send to, as raw bytes.
+  std::string address_;
+  // Reused for every message so that steady state logging doesn't allocate.
+  spdlog::memory_buf_t buffer_;
+};
+
+}  // namespace rcl_logging_spdlog
+
+#endif  // RCL_LOGGING_SPDLOG__DATAGRAM_SINK_HPP_
@@ -0,0 +1,46 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rcl_logging_interface/rcl_logging_interface.h"
+
+#include "rcl_logging_spdlog/file_sink.hpp"
+#include "rcl_logging_spdlog/flush_policy.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+FileSink::FileSink(const FlushSettings & flush_settings)
+: flush_policy_(flush_settings)
+{
+}
+
+WriteStats
+FileSink::write_stats() const
+{
+  return flush_policy_.stats();
+}
+
+void
+FileSink::read_latency(rcl_logging_latency_histograms_t & histograms) const
+{
+  flush_policy_.read_latency(histograms);
+}
+
+FlushPolicy &
+FileSink::flush_policy()
+{
+  return flush_policy_;
+}
+
+}  // namespace rcl_logging_spdlog
@@ -0,0 +1,61 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_LOGGING_SPDLOG__FILE_SINK_HPP_
+#define RCL_LOGGING_SPDLOG__FILE_SINK_HPP_
+
+#include <mutex>
+
+#include "spdlog/sinks/base_sink.h"
+
+#include "rcl_logging_interface/rcl_logging_interface.h"
+#include "rcl_logging_interface/visibility_control.h"
+
+#include "rcl_logging_spdlog/batch_sink.hpp"
+#include "rcl_logging_spdlog/flush_policy.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+/// What the sinks writing the log file have in common.
+/**
+ * They flush according to a FlushPolicy, which also keeps track of what they
+ * wrote.
+ */
+class RCL_LOGGING_INTERFACE_LOCAL FileSink
+  : public spdlog::sinks::base_sink<std::mutex>, public BatchSink
+{
+public:
+  explicit FileSink(const FlushSettings & flush_settings);
+
+  /// What was written so far, safe to call from any thread.
+  WriteStats
+  write_stats() const;
+
+  /// Fill in how long messages took, safe to call from any thread.
+  void
+  read_latency(rcl_logging_latency_histograms_t & histograms) const;
+
+protected:
+  /// The policy, only to be used with the sink's lock held.
+  FlushPolicy &
+  flush_policy();
+
+private:
+  FlushPolicy flush_policy_;
+};
+
+}  // namespace rcl_logging_spdlog
+
+#endif  // RCL_LOGGING_SPDLOG__FILE_SINK_HPP_
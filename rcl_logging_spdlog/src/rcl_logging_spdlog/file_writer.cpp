@@ -0,0 +1,92 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstdio>
+#include <string>
+
+#include "spdlog/common.h"
+#include "spdlog/details/os.h"
+
+#include "rcl_logging_spdlog/file_writer.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+StdioFileWriter::StdioFileWriter(const std::string & filename, size_t buffer_size)
+: filename_(filename),
+  file_(nullptr),
+  size_(0)
+{
+  if (spdlog::details::os::fopen_s(&file_, filename_, SPDLOG_FILENAME_T("ab"))) {
+    spdlog::throw_spdlog_ex("Failed opening file " + filename_ + " for writing", errno);
+  }
+  if (buffer_size > 0 && std::setvbuf(file_, nullptr, _IOFBF, buffer_size) != 0) {
+    std::fclose(file_);
+    spdlog::throw_spdlog_ex("Failed setting the buffer size of file " + filename_);
+  }
+  size_ = spdlog::details::os::filesize(file_);
+}
+
+StdioFileWriter::~StdioFileWriter()
+{
+  std::fclose(file_);
+}
+
+void
+StdioFileWriter::write(const char * data, size_t size)
+{
+  if (std::fwrite(data, 1, size, file_) != size) {
+    spdlog::throw_spdlog_ex("Failed writing to file " + filename_, errno);
+  }
+  size_ += size;
+}
+
+void
+StdioFileWriter::flush()
+{
+  if (std::fflush(file_) != 0) {
+    spdlog::throw_spdlog_ex("Failed flushing file " + filename_, errno);
+  }
+}
+
+void
+StdioFileWriter::sync()
+{
+  flush();
+#ifdef _WIN32
+  int ret = _commit(_fileno(file_));
+#elif defined(__linux__)
+  int ret = ::fdatasync(fileno(file_));
+#else
+  int ret = ::fsync(fileno(file_));
+#endif
+  if (ret != 0) {
+    spdlog::throw_spdlog_ex("Failed syncing file " + filename_, errno);
+  }
+}
+
+size_t
+StdioFileWriter::size() const
+{
+  return size_;
+}
+
+}  // namespace rcl_logging_spdlog
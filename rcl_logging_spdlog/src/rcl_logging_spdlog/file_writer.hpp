@@ -0,0 +1,109 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_LOGGING_SPDLOG__FILE_WRITER_HPP_
+#define RCL_LOGGING_SPDLOG__FILE_WRITER_HPP_
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+
+#include "rcl_logging_interface/visibility_control.h"
+
+namespace rcl_logging_spdlog
+{
+
+/// Where the sinks of this package put the bytes of a log file.
+/**
+ * Implementations are not thread safe, the sink owning a writer serializes
+ * calls to it.
+ * Errors are reported by throwing spdlog::spdlog_ex, like spdlog's own sinks.
+ */
+class RCL_LOGGING_INTERFACE_LOCAL FileWriter
+{
+public:
+  virtual ~FileWriter() = default;
+
+  /// Append data to the log file.
+  virtual void
+  write(const char * data, size_t size) = 0;
+
+  /// Hand anything buffered in the process over to the operating system.
+  virtual void
+  flush() = 0;
+
+  /// Flush, and wait until the data has reached the storage device.
+  virtual void
+  sync() = 0;
+
+  /// The number of bytes in the file currently being written.
+  virtual size_t
+  size() const = 0;
+
+  /// Whether the file was opened yet, writers which don't open lazily always are.
+  virtual bool
+  is_open() const
+  {
+    return true;
+  }
+
+  /// Move on to a new file if it is time to, before writing a record.
+  /**
+   * Sinks call this once per record, with the number of bytes they are about
+   * to write.
+   * \return true if a new, empty file was started, so the sink has to write
+   *   its file header again; writers which don't rotate always return false.
+   */
+  virtual bool
+  rotate_if_needed(size_t size)
+  {
+    (void)size;
+    return false;
+  }
+};
+
+/// Writes through a buffered stdio stream, like spdlog::sinks::basic_file_sink.
+class RCL_LOGGING_INTERFACE_LOCAL StdioFileWriter final : public FileWriter
+{
+public:
+  /// Open a file for appending.
+  /**
+   * \param buffer_size the size of the stdio buffer, 0 for the default.
+   */
+  explicit StdioFileWriter(const std::string & filename, size_t buffer_size = 0);
+
+  ~StdioFileWriter() override;
+
+  void
+  write(const char * data, size_t size) override;
+
+  void
+  flush() override;
+
+  void
+  sync() override;
+
+  size_t
+  size() const override;
+
+private:
+  std::string filename_;
+  std::FILE * file_;
+  // Tracked here, since the file on disk lags behind the stdio buffer.
+  size_t size_;
+};
+
+}  // namespace rcl_logging_spdlog
+
+#endif  // RCL_LOGGING_SPDLOG__FILE_WRITER_HPP_
@@ -0,0 +1,146 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "spdlog/common.h"
+#include "spdlog/details/log_msg.h"
+#include "spdlog/details/os.h"
+
+#include "rcl_logging_spdlog/flight_recorder.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+FlightRecorder::FlightRecorder(size_t capacity)
+: capacity_(capacity),
+  slots_(std::make_unique<Slot[]>(capacity))
+{
+}
+
+void
+FlightRecorder::lock(Slot & slot)
+{
+  while (slot.busy.test_and_set(std::memory_order_acquire)) {
+    std::this_thread::yield();
+  }
+}
+
+void
+FlightRecorder::unlock(Slot & slot)
+{
+  slot.busy.clear(std::memory_order_release);
+}
+
+void
+FlightRecorder::record(
+  spdlog::log_clock::time_point time, spdlog::string_view_t name,
+  spdlog::level::level_enum level, spdlog::string_view_t msg)
+{
+  constexpr size_t kMarkerSize = sizeof(kTruncatedMarker) - 1;
+  bool truncated = name.size() + msg.size() > kMaxMessageSize;
+  size_t room = truncated ? kMaxMessageSize - kMarkerSize : kMaxMessageSize;
+  size_t name_length = std::min(name.size(), room);
+  size_t msg_length = std::min(msg.size(), room - name_length);
+  // Outside of the lock, spdlog caches it per thread anyway.
+  size_t thread_id = spdlog::details::os::thread_id();
+
+  uint64_t number = next_.fetch_add(1, std::memory_order_relaxed);
+  Slot & slot = slots_[number % capacity_];
+  lock(slot);
+  // Unless a thread which came a whole ring later got here first.
+  if (slot.written.load(std::memory_order_relaxed) <= number) {
+    Entry & entry = slot.entry;
+    entry.time = time;
+    entry.level = level;
+    entry.thread_id = thread_id;
+    entry.name_length = name_length;
+    std::memcpy(entry.text, name.data(), name_length);
+    std::memcpy(entry.text + name_length, msg.data(), msg_length);
+    if (truncated) {
+      std::memcpy(entry.text + name_length + msg_length, kTruncatedMarker, kMarkerSize);
+      msg_length += kMarkerSize;
+    }
+    entry.msg_length = msg_length;
+    slot.written.store(number + 1, std::memory_order_release);
+  }
+  unlock(slot);
+}
+
+size_t
+FlightRecorder::dump(
+  const std::function<void(const spdlog::details::log_msg *, size_t)> & write)
+{
+  constexpr uint64_t kChunkSize = 64;
+  spdlog::details::log_msg msgs[kChunkSize];
+
+  std::lock_guard<std::mutex> dump_lock(dump_mutex_);
+  uint64_t end = next_.load(std::memory_order_relaxed);
+  uint64_t number = std::max(
+    forgotten_.load(std::memory_order_relaxed), end - std::min<uint64_t>(end, capacity_));
+  std::vector<Entry> entries(std::min(end - number, kChunkSize));
+  size_t dumped = 0;
+  while (number < end) {
+    uint64_t chunk_end = std::min(end, number + kChunkSize);
+    size_t chunk_size = 0;
+    for (; number < chunk_end; ++number) {
+      Slot & slot = slots_[number % capacity_];
+      // The thread recording it already has its number, wait for the message.
+      while (slot.written.load(std::memory_order_acquire) <= number) {
+        std::this_thread::yield();
+      }
+      lock(slot);
+      bool replaced = slot.written.load(std::memory_order_relaxed) != number + 1;
+      if (!replaced) {
+        entries[chunk_size] = slot.entry;
+      }
+      unlock(slot);
+      if (replaced) {
+        continue;
+      }
+      const Entry & entry = entries[chunk_size];
+      msgs[chunk_size] = spdlog::details::log_msg(
+        entry.time, spdlog::source_loc(kReplayedSourceFile, 0, ""),
+        spdlog::string_view_t(entry.text, entry.name_length), entry.level,
+        spdlog::string_view_t(entry.text + entry.name_length, entry.msg_length));
+      msgs[chunk_size].thread_id = entry.thread_id;
+      ++chunk_size;
+    }
+    // Forget them first, so that they aren't written twice if write throws.
+    forgotten_.store(number, std::memory_order_release);
+    if (chunk_size > 0) {
+      write(msgs, chunk_size);
+      dumped += chunk_size;
+    }
+  }
+  return dumped;
+}
+
+size_t
+FlightRecorder::size() const
+{
+  uint64_t forgotten = forgotten_.load(std::memory_order_acquire);
+  uint64_t end = next_.load(std::memory_order_relaxed);
+  return static_cast<size_t>(std::min<uint64_t>(end - forgotten, capacity_));
+}
+
+}  // namespace rcl_logging_spdlog
@@ -0,0 +1,131 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_LOGGING_SPDLOG__FLIGHT_RECORDER_HPP_
+#define RCL_LOGGING_SPDLOG__FLIGHT_RECORDER_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "spdlog/common.h"
+#include "spdlog/details/log_msg.h"
+
+#include "rcl_logging_interface/visibility_control.h"
+
+namespace rcl_logging_spdlog
+{
+
+/// The source file of messages replayed by FlightRecorder::dump().
+/**
+ * These were logged well before they are written, so they are left out of the
+ * latency histograms.
+ * Their line is 0, so formatters still treat the location as empty.
+ */
+inline constexpr char kReplayedSourceFile[] = "flight recorder";
+
+/// Whether a message is one replayed by FlightRecorder::dump().
+inline bool
+is_replayed(const spdlog::details::log_msg & msg)
+{
+  return kReplayedSourceFile == msg.source.filename;
+}
+
+/// Keeps the most recent messages in memory, to be written out later if need be.
+/**
+ * Messages are copied into a ring of preallocated entries, so recording one
+ * neither formats nor allocates anything, and once the ring is full each new
+ * message replaces the oldest one.
+ * Recording takes no lock shared with other threads: each message gets its
+ * entry from an atomic counter, and only waits for another thread if that one
+ * is still copying into the same entry a whole ring earlier.
+ * The name and the message of each are cut to kMaxMessageSize bytes in total,
+ * ending with kTruncatedMarker if anything was left out.
+ */
+class RCL_LOGGING_INTERFACE_LOCAL FlightRecorder final
+{
+public:
+  static constexpr size_t kMaxMessageSize = 512;
+  static constexpr char kTruncatedMarker[] = " [truncated]";
+
+  /// Create a recorder which keeps up to capacity messages, which must not be 0.
+  explicit FlightRecorder(size_t capacity);
+
+  FlightRecorder(const FlightRecorder &) = delete;
+  FlightRecorder & operator=(const FlightRecorder &) = delete;
+
+  /// Record a message, replacing the oldest one if full.
+  void
+  record(
+    spdlog::log_clock::time_point time, spdlog::string_view_t name,
+    spdlog::level::level_enum level, spdlog::string_view_t msg);
+
+  /// Hand the recorded messages, oldest first, to write, and forget them.
+  /**
+   * write may be called several times with consecutive parts of the messages.
+   * Messages recorded meanwhile are left for the next dump, and those replaced
+   * before they could be handed over are left out.
+   *
+   * \return the number of messages handed to write.
+   */
+  size_t
+  dump(const std::function<void(const spdlog::details::log_msg *, size_t)> & write);
+
+  /// The number of messages currently recorded.
+  size_t
+  size() const;
+
+private:
+  struct Entry
+  {
+    spdlog::log_clock::time_point time;
+    spdlog::level::level_enum level;
+    size_t thread_id;
+    size_t name_length;
+    size_t msg_length;
+    char text[kMaxMessageSize];
+  };
+
+  struct Slot
+  {
+    // Held while the entry is copied in or out.
+    std::atomic_flag busy = ATOMIC_FLAG_INIT;
+    // One more than the number of the message in entry, 0 while there is none.
+    std::atomic<uint64_t> written{0};
+    Entry entry;
+  };
+
+  static void
+  lock(Slot & slot);
+
+  static void
+  unlock(Slot & slot);
+
+  const size_t capacity_;
+  std::unique_ptr<Slot[]> slots_;
+  // The number of the next message recorded, which goes to the slot at that
+  // number modulo capacity_.
+  std::atomic<uint64_t> next_{0};
+  // The messages numbered below this were dumped already, or dropped.
+  std::atomic<uint64_t> forgotten_{0};
+  // Keeps dumps apart, recording doesn't take it.
+  std::mutex dump_mutex_;
+};
+
+}  // namespace rcl_logging_spdlog
+
+#endif  // RCL_LOGGING_SPDLOG__FLIGHT_RECORDER_HPP_
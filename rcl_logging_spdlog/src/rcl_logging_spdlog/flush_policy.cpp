@@ -0,0 +1,169 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "spdlog/common.h"
+#include "spdlog/details/log_msg.h"
+
+#include "rcl_logging_interface/rcl_logging_interface.h"
+
+#include "rcl_logging_spdlog/flight_recorder.hpp"
+#include "rcl_logging_spdlog/flush_policy.hpp"
+#include "rcl_logging_spdlog/latency_histogram.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+namespace
+{
+
+constexpr size_t kMaxUnflushedTimes = 1024;
+
+void
+add_relaxed(std::atomic<uint64_t> & counter, uint64_t value)
+{
+  counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+}  // namespace
+
+FlushPolicy::FlushPolicy(const FlushSettings & settings)
+: settings_(settings),
+  unflushed_bytes_(0),
+  unflushed_records_(0),
+  records_written_(0),
+  bytes_written_(0),
+  flushes_(0),
+  flush_time_ns_(0),
+  unflushed_stride_(1),
+  unflushed_skipped_(0)
+{
+  if (settings_.record_latency) {
+    written_latency_ = std::make_unique<LatencyHistogram>();
+    flushed_latency_ = std::make_unique<LatencyHistogram>();
+    unflushed_times_.reserve(kMaxUnflushedTimes);
+  }
+}
+
+void
+FlushPolicy::record_written(FileWriter & writer, const spdlog::details::log_msg & msg, size_t size)
+{
+  if (nullptr != written_latency_ && !is_replayed(msg)) {
+    written_latency_->record(spdlog::log_clock::now() - msg.time);
+    remember_unflushed(msg.time);
+  }
+  unflushed_bytes_ += size;
+  ++unflushed_records_;
+  add_relaxed(records_written_, 1);
+  add_relaxed(bytes_written_, size);
+
+  spdlog::level::level_enum level = msg.level;
+  if (level >= settings_.sync_level && spdlog::level::off != settings_.sync_level) {
+    flush_writer(writer, true);
+  } else if (
+    (level >= settings_.flush_level && spdlog::level::off != settings_.flush_level) ||
+    (settings_.max_unflushed_bytes > 0 && unflushed_bytes_ >= settings_.max_unflushed_bytes) ||
+    (settings_.max_unflushed_records > 0 &&
+    unflushed_records_ >= settings_.max_unflushed_records))
+  {
+    flush_writer(writer, false);
+  } else {
+    return;
+  }
+  unflushed_bytes_ = 0;
+  unflushed_records_ = 0;
+}
+
+void
+FlushPolicy::flush(FileWriter & writer)
+{
+  if (0 == unflushed_records_) {
+    return;
+  }
+  flush_writer(writer, false);
+  unflushed_bytes_ = 0;
+  unflushed_records_ = 0;
+}
+
+WriteStats
+FlushPolicy::stats() const
+{
+  WriteStats stats;
+  stats.records = records_written_.load(std::memory_order_relaxed);
+  stats.bytes = bytes_written_.load(std::memory_order_relaxed);
+  stats.flushes = flushes_.load(std::memory_order_relaxed);
+  stats.flush_time = std::chrono::nanoseconds(flush_time_ns_.load(std::memory_order_relaxed));
+  return stats;
+}
+
+void
+FlushPolicy::flush_writer(FileWriter & writer, bool sync)
+{
+  auto start = std::chrono::steady_clock::now();
+  if (sync) {
+    writer.sync();
+  } else {
+    writer.flush();
+  }
+  auto duration = std::chrono::steady_clock::now() - start;
+  if (nullptr != flushed_latency_) {
+    auto now = spdlog::log_clock::now();
+    for (auto unflushed_time : unflushed_times_) {
+      flushed_latency_->record(now - unflushed_time, unflushed_stride_);
+    }
+    unflushed_times_.clear();
+    unflushed_stride_ = 1;
+    unflushed_skipped_ = 0;
+  }
+  add_relaxed(flushes_, 1);
+  add_relaxed(
+    flush_time_ns_,
+    static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()));
+}
+
+void
+FlushPolicy::read_latency(rcl_logging_latency_histograms_t & histograms) const
+{
+  histograms = rcl_logging_latency_histograms_t();
+  if (nullptr != written_latency_) {
+    written_latency_->read(histograms.written);
+    flushed_latency_->read(histograms.flushed);
+  }
+}
+
+void
+FlushPolicy::remember_unflushed(spdlog::log_clock::time_point time)
+{
+  if (++unflushed_skipped_ < unflushed_stride_) {
+    return;
+  }
+  unflushed_skipped_ = 0;
+  // Once full, keep every other time, each now standing for twice as many
+  // messages, and keep only every other message from then on.
+  if (kMaxUnflushedTimes == unflushed_times_.size()) {
+    for (size_t i = 0; i < kMaxUnflushedTimes / 2; ++i) {
+      unflushed_times_[i] = unflushed_times_[2 * i + 1];
+    }
+    unflushed_times_.resize(kMaxUnflushedTimes / 2);
+    unflushed_stride_ *= 2;
+  }
+  unflushed_times_.push_back(time);
+}
+
+}  // namespace rcl_logging_spdlog
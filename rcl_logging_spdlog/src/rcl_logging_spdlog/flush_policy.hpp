@@ -0,0 +1,126 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_LOGGING_SPDLOG__FLUSH_POLICY_HPP_
+#define RCL_LOGGING_SPDLOG__FLUSH_POLICY_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "spdlog/common.h"
+#include "spdlog/details/log_msg.h"
+
+#include "rcl_logging_interface/rcl_logging_interface.h"
+#include "rcl_logging_interface/visibility_control.h"
+
+#include "rcl_logging_spdlog/file_writer.hpp"
+#include "rcl_logging_spdlog/latency_histogram.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+/// When a sink flushes its file writer, regardless of the time.
+struct FlushSettings
+{
+  /// Flush once this many bytes were written since the last flush, 0 for never.
+  size_t max_unflushed_bytes = 0;
+  /// Flush once this many records were written since the last flush, 0 for never.
+  size_t max_unflushed_records = 0;
+  /// Flush after every record of at least this level.
+  spdlog::level::level_enum flush_level = spdlog::level::off;
+  /// Flush and wait for the data to reach the disk after every record of at
+  /// least this level.
+  spdlog::level::level_enum sync_level = spdlog::level::off;
+  /// Measure how long messages take to be written and flushed.
+  bool record_latency = false;
+};
+
+/// What a sink has written so far.
+struct WriteStats
+{
+  uint64_t records = 0;
+  uint64_t bytes = 0;
+  /// The number of times the writer was flushed or synced.
+  uint64_t flushes = 0;
+  /// The total time spent flushing or syncing the writer.
+  std::chrono::nanoseconds flush_time{0};
+};
+
+/// Decides when a sink flushes, and keeps track of what it has written.
+/**
+ * Except for stats(), the methods must be called with the sink's
+ * lock held.
+ */
+class RCL_LOGGING_INTERFACE_LOCAL FlushPolicy final
+{
+public:
+  explicit FlushPolicy(const FlushSettings & settings);
+
+  /// Account for a record just written through the writer, flushing if due.
+  /**
+   * Messages replayed by the flight recorder don't count towards the latency.
+   */
+  void
+  record_written(FileWriter & writer, const spdlog::details::log_msg & msg, size_t size);
+
+  /// Flush the writer, unless nothing was written since the last flush.
+  void
+  flush(FileWriter & writer);
+
+  /// What was written so far, safe to call from any thread.
+  WriteStats
+  stats() const;
+
+  /// Fill in how long messages took, safe to call from any thread.
+  /**
+   * The histograms are empty unless FlushSettings::record_latency is set.
+   * Messages are only counted as flushed by flushes of the policy, not when the
+   * writer flushes by itself, as its buffer fills up for instance.
+   */
+  void
+  read_latency(rcl_logging_latency_histograms_t & histograms) const;
+
+private:
+  void
+  flush_writer(FileWriter & writer, bool sync);
+
+  void
+  remember_unflushed(spdlog::log_clock::time_point time);
+
+  FlushSettings settings_;
+  size_t unflushed_bytes_;
+  size_t unflushed_records_;
+  // Only ever written with the sink's lock held, so these needn't be updated
+  // atomically, only stored atomically for stats().
+  std::atomic<uint64_t> records_written_;
+  std::atomic<uint64_t> bytes_written_;
+  std::atomic<uint64_t> flushes_;
+  std::atomic<uint64_t> flush_time_ns_;
+  // Only with FlushSettings::record_latency.
+  std::unique_ptr<LatencyHistogram> written_latency_;
+  std::unique_ptr<LatencyHistogram> flushed_latency_;
+  // When the messages written since the last flush were logged, one in
+  // unflushed_stride_ of them so that their number stays bounded.
+  std::vector<spdlog::log_clock::time_point> unflushed_times_;
+  uint64_t unflushed_stride_;
+  uint64_t unflushed_skipped_;
+};
+
+}  // namespace rcl_logging_spdlog
+
+#endif  // RCL_LOGGING_SPDLOG__FLUSH_POLICY_HPP_
@@ -0,0 +1,99 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <utility>
+
+#include "rcl_logging_spdlog/flusher.hpp"
+#include "rcl_logging_spdlog/thread_settings.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+Flusher::Flusher(
+  std::function<void()> flush,
+  std::function<uint64_t()> records_written,
+  std::chrono::milliseconds interval,
+  std::chrono::milliseconds min_interval,
+  const ThreadSettings & thread_settings)
+: flush_(std::move(flush)),
+  records_written_(std::move(records_written)),
+  interval_(interval),
+  min_interval_(min_interval),
+  stopping_(false),
+  // Read here rather than in the thread, so that nothing logged between
+  // construction and the thread starting is mistaken for already flushed.
+  initial_records_(records_written_())
+{
+  thread_ = std::thread(&Flusher::run, this, thread_settings);
+}
+
+Flusher::~Flusher()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  condition_.notify_one();
+  thread_.join();
+}
+
+void
+Flusher::run(const ThreadSettings & thread_settings)
+{
+  apply_thread_settings(thread_settings);
+
+  using clock = std::chrono::steady_clock;
+
+  bool adaptive = min_interval_.count() > 0;
+  std::chrono::milliseconds tick = adaptive ? std::min(min_interval_, interval_) : interval_;
+  std::chrono::milliseconds backoff = tick;
+  uint64_t flushed_records = initial_records_;
+  uint64_t last_records = flushed_records;
+  clock::time_point last_flush = clock::now();
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!condition_.wait_for(lock, tick, [this] {return stopping_;})) {
+    lock.unlock();
+
+    uint64_t records = records_written_();
+    clock::time_point now = clock::now();
+    bool flush = false;
+    if (records != flushed_records) {
+      if (!adaptive || records == last_records) {
+        // Fixed interval, or idle since the last tick.
+        flush = true;
+        backoff = tick;
+      } else if (now - last_flush >= backoff) {
+        // Busy, flush but back off further.
+        flush = true;
+        backoff = std::min(backoff * 2, interval_);
+      }
+    }
+    last_records = records;
+    if (flush) {
+      flush_();
+      flushed_records = records;
+      last_flush = now;
+    }
+
+    lock.lock();
+  }
+}
+
+}  // namespace rcl_logging_spdlog
@@ -0,0 +1,88 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_LOGGING_SPDLOG__FLUSHER_HPP_
+#define RCL_LOGGING_SPDLOG__FLUSHER_HPP_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "rcl_logging_interface/visibility_control.h"
+
+#include "rcl_logging_spdlog/thread_settings.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+/// Flushes a logger from a background thread as time passes.
+/**
+ * This replaces spdlog::flush_every(), which flushes every registered logger
+ * from a process wide thread and can't adapt to the load.
+ *
+ * With a fixed interval the logger is flushed every interval, if anything was
+ * logged since the last flush.
+ *
+ * In adaptive mode the thread wakes up every min_interval instead.
+ * When nothing was logged since it last woke up, the logger has gone idle and
+ * is flushed right away.
+ * While messages keep coming, flushes are spaced out further and further, up
+ * to the interval, so that a busy logger isn't slowed down by flushing.
+ */
+class RCL_LOGGING_INTERFACE_LOCAL Flusher final
+{
+public:
+  /// Start the background thread.
+  /**
+   * \param flush flushes the logger.
+   * \param records_written returns the number of messages written so far.
+   * \param interval the time between flushes, or the maximum in adaptive mode.
+   * \param min_interval the minimum time between flushes in adaptive mode, or
+   *   zero for a fixed interval.
+   * \param thread_settings where and how the thread runs.
+   */
+  Flusher(
+    std::function<void()> flush,
+    std::function<uint64_t()> records_written,
+    std::chrono::milliseconds interval,
+    std::chrono::milliseconds min_interval,
+    const ThreadSettings & thread_settings);
+
+  /// Stop the background thread.
+  ~Flusher();
+
+  Flusher(const Flusher &) = delete;
+  Flusher & operator=(const Flusher &) = delete;
+
+private:
+  void
+  run(const ThreadSettings & thread_settings);
+
+  std::function<void()> flush_;
+  std::function<uint64_t()> records_written_;
+  std::chrono::milliseconds interval_;
+  std::chrono::milliseconds min_interval_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  bool stopping_;
+  uint64_t initial_records_;
+  std::thread thread_;
+};
+
+}  // namespace rcl_logging_spdlog
+
+#endif  // RCL_LOGGING_SPDLOG__FLUSHER_HPP_
@@ -0,0 +1,146 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "rcl_logging_interface/rcl_logging_interface.h"
+
+#include "rcl_logging_spdlog/latency_histogram.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+namespace
+{
+
+void
+add_relaxed(std::atomic<uint64_t> & counter, uint64_t value)
+{
+  counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+// The index of the highest bit set, 0 for 0.
+size_t
+highest_bit(uint64_t value)
+{
+  if (0 == value) {
+    return 0;
+  }
+#if defined(_MSC_VER)
+  unsigned long bit;  // NOLINT(runtime/int)
+  _BitScanReverse64(&bit, value);
+  return static_cast<size_t>(bit);
+#else
+  return static_cast<size_t>(63 - __builtin_clzll(value));
+#endif
+}
+
+}  // namespace
+
+LatencyHistogram::LatencyHistogram()
+: max_(0)
+{
+  for (auto & count : counts_) {
+    count.store(0, std::memory_order_relaxed);
+  }
+}
+
+void
+LatencyHistogram::record(std::chrono::nanoseconds latency, uint64_t count)
+{
+  uint64_t value = latency.count() > 0 ? static_cast<uint64_t>(latency.count()) : 0;
+  add_relaxed(counts_[bucket_index(value)], count);
+  if (value > max_.load(std::memory_order_relaxed)) {
+    max_.store(value, std::memory_order_relaxed);
+  }
+}
+
+void
+LatencyHistogram::read(rcl_logging_latency_histogram_t & histogram) const
+{
+  histogram = rcl_logging_latency_histogram_t();
+  uint64_t counts[kBucketCount];
+  for (size_t i = 0; i < kBucketCount; ++i) {
+    counts[i] = counts_[i].load(std::memory_order_relaxed);
+    histogram.count += counts[i];
+  }
+  histogram.max_ns = max_.load(std::memory_order_relaxed);
+
+  struct Percentile
+  {
+    double fraction;
+    uint64_t * value;
+  };
+  Percentile percentiles[] = {
+    {0.5, &histogram.p50_ns},
+    {0.9, &histogram.p90_ns},
+    {0.99, &histogram.p99_ns},
+    {0.999, &histogram.p999_ns},
+  };
+  uint64_t seen = 0;
+  size_t next_percentile = 0;
+  for (size_t i = 0; i < kBucketCount && histogram.count > 0; ++i) {
+    seen += counts[i];
+    uint64_t upper_bound = std::min(bucket_upper_bound(i), histogram.max_ns);
+    while (next_percentile < sizeof(percentiles) / sizeof(percentiles[0]) &&
+      static_cast<double>(seen) >=
+      percentiles[next_percentile].fraction * static_cast<double>(histogram.count))
+    {
+      *percentiles[next_percentile++].value = upper_bound;
+    }
+    if (counts[i] > 0) {
+      // Every sub-bucket lies within one power of two.
+      uint64_t lower_bound = i < kSubBucketCount ? i : bucket_upper_bound(i - 1) + 1;
+      histogram.buckets[std::min<size_t>(
+          highest_bit(lower_bound), RCL_LOGGING_LATENCY_HISTOGRAM_BUCKET_COUNT - 1)] += counts[i];
+    }
+  }
+}
+
+size_t
+LatencyHistogram::bucket_index(uint64_t value)
+{
+  if (value < kSubBucketCount) {
+    return static_cast<size_t>(value);
+  }
+  size_t magnitude = highest_bit(value);
+  size_t shift = magnitude - kSubBucketBits;
+  return (magnitude - kSubBucketBits + 1) * kSubBucketCount +
+         static_cast<size_t>((value >> shift) - kSubBucketCount);
+}
+
+uint64_t
+LatencyHistogram::bucket_upper_bound(size_t index)
+{
+  if (index < kSubBucketCount) {
+    return index;
+  }
+  size_t shift = index / kSubBucketCount - 1;
+  uint64_t sub_bucket = kSubBucketCount + index % kSubBucketCount;
+  // The top bucket ends at the largest value there is.
+  if (shift + kSubBucketBits >= 63 && sub_bucket == 2 * kSubBucketCount - 1) {
+    return UINT64_MAX;
+  }
+  return ((sub_bucket + 1) << shift) - 1;
+}
+
+}  // namespace rcl_logging_spdlog
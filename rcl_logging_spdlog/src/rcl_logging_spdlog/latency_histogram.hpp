@@ -0,0 +1,77 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_LOGGING_SPDLOG__LATENCY_HISTOGRAM_HPP_
+#define RCL_LOGGING_SPDLOG__LATENCY_HISTOGRAM_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "rcl_logging_interface/rcl_logging_interface.h"
+#include "rcl_logging_interface/visibility_control.h"
+
+namespace rcl_logging_spdlog
+{
+
+/// A histogram of latencies, bucketed like an HDR histogram.
+/**
+ * Each power of two is split into 16 buckets, so recorded values keep about
+ * 6% of precision over the whole range of nanoseconds, in a fixed 8 KiB.
+ *
+ * Only one thread may record at a time, while any thread may read.
+ */
+class RCL_LOGGING_INTERFACE_LOCAL LatencyHistogram final
+{
+public:
+  LatencyHistogram();
+
+  LatencyHistogram(const LatencyHistogram &) = delete;
+  LatencyHistogram & operator=(const LatencyHistogram &) = delete;
+
+  /// Record a latency, count times.
+  /**
+   * Negative latencies, from the clock going back, are recorded as 0.
+   */
+  void
+  record(std::chrono::nanoseconds latency, uint64_t count = 1);
+
+  /// Fill in the counts, percentiles and buckets of histogram.
+  /**
+   * Percentiles are the upper bounds of the buckets they fall in.
+   */
+  void
+  read(rcl_logging_latency_histogram_t & histogram) const;
+
+private:
+  static constexpr size_t kSubBucketBits = 4;
+  static constexpr size_t kSubBucketCount = size_t(1) << kSubBucketBits;
+  static constexpr size_t kBucketCount = (64 - kSubBucketBits + 1) * kSubBucketCount;
+
+  static size_t
+  bucket_index(uint64_t value);
+
+  static uint64_t
+  bucket_upper_bound(size_t index);
+
+  // Only ever written by the recording thread, so these needn't be updated
+  // atomically, only stored atomically for read().
+  std::atomic<uint64_t> counts_[kBucketCount];
+  std::atomic<uint64_t> max_;
+};
+
+}  // namespace rcl_logging_spdlog
+
+#endif  // RCL_LOGGING_SPDLOG__LATENCY_HISTOGRAM_HPP_
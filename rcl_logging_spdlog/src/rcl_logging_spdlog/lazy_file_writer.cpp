@@ -0,0 +1,80 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "rcl_logging_spdlog/lazy_file_writer.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+LazyFileWriter::LazyFileWriter(Opener opener)
+: opener_(std::move(opener))
+{
+}
+
+LazyFileWriter::~LazyFileWriter() = default;
+
+void
+LazyFileWriter::write(const char * data, size_t size)
+{
+  writer().write(data, size);
+}
+
+void
+LazyFileWriter::flush()
+{
+  if (nullptr != writer_) {
+    writer_->flush();
+  }
+}
+
+void
+LazyFileWriter::sync()
+{
+  if (nullptr != writer_) {
+    writer_->sync();
+  }
+}
+
+size_t
+LazyFileWriter::size() const
+{
+  return nullptr == writer_ ? 0 : writer_->size();
+}
+
+bool
+LazyFileWriter::is_open() const
+{
+  return nullptr != writer_;
+}
+
+bool
+LazyFileWriter::rotate_if_needed(size_t size)
+{
+  return writer().rotate_if_needed(size);
+}
+
+FileWriter &
+LazyFileWriter::writer()
+{
+  if (nullptr == writer_) {
+    writer_ = opener_();
+  }
+  return *writer_;
+}
+
+}  // namespace rcl_logging_spdlog
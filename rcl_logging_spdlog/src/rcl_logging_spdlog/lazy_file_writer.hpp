@@ -0,0 +1,84 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_LOGGING_SPDLOG__LAZY_FILE_WRITER_HPP_
+#define RCL_LOGGING_SPDLOG__LAZY_FILE_WRITER_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+#include "rcl_logging_interface/visibility_control.h"
+
+#include "rcl_logging_spdlog/file_writer.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+/// Opens the log file only once something is written to it.
+/**
+ * Processes which never log anything then leave no empty file behind, and
+ * starting many of them at once doesn't cost a file creation each.
+ * Like any FileWriter this is not thread safe, so the sink's lock is what
+ * makes concurrent first messages open the file only once.
+ *
+ * If opening the file fails, the error is thrown from the write, and the next
+ * write tries again.
+ */
+class RCL_LOGGING_INTERFACE_LOCAL LazyFileWriter final : public FileWriter
+{
+public:
+  using Opener = std::function<std::unique_ptr<FileWriter>()>;
+
+  /// Don't open anything yet.
+  /**
+   * \param opener creates the writer of the file, the first time it is needed.
+   */
+  explicit LazyFileWriter(Opener opener);
+
+  ~LazyFileWriter() override;
+
+  void
+  write(const char * data, size_t size) override;
+
+  /// Flush the file, if it was opened.
+  void
+  flush() override;
+
+  /// Sync the file, if it was opened.
+  void
+  sync() override;
+
+  /// The size of the file, 0 until it is opened.
+  size_t
+  size() const override;
+
+  bool
+  is_open() const override;
+
+  /// Open the file if it isn't yet, and then ask its writer.
+  bool
+  rotate_if_needed(size_t size) override;
+
+private:
+  FileWriter &
+  writer();
+
+  Opener opener_;
+  std::unique_ptr<FileWriter> writer_;
+};
+
+}  // namespace rcl_logging_spdlog
+
+#endif  // RCL_LOGGING_SPDLOG__LAZY_FILE_WRITER_HPP_
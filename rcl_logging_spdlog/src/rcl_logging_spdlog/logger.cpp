@@ -0,0 +1,170 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rcutils/allocator.h"
+
+#include "spdlog/details/log_msg.h"
+#include "spdlog/logger.h"
+#include "spdlog/sinks/sink.h"
+
+#include "rcl_logging_spdlog/async_writer.hpp"
+#include "rcl_logging_spdlog/batch_sink.hpp"
+#include "rcl_logging_spdlog/logger.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+namespace
+{
+
+std::vector<BatchSink *>
+find_batch_sinks(const std::vector<spdlog::sink_ptr> & sinks)
+{
+  std::vector<BatchSink *> batch_sinks;
+  for (const auto & sink : sinks) {
+    batch_sinks.push_back(dynamic_cast<BatchSink *>(sink.get()));
+  }
+  return batch_sinks;
+}
+
+}  // namespace
+
+Logger::Logger(std::vector<spdlog::sink_ptr> sinks)
+: spdlog::logger("root", sinks.begin(), sinks.end()),
+  batch_sinks_(find_batch_sinks(sinks))
+{
+}
+
+Logger::Logger(
+  std::vector<spdlog::sink_ptr> sinks, const AsyncWriterSettings & settings,
+  rcutils_allocator_t allocator)
+: spdlog::logger("root", sinks.begin(), sinks.end()),
+  batch_sinks_(find_batch_sinks(sinks))
+{
+  // Reported like spdlog::logger does for messages written synchronously.
+  async_writer_ = std::make_unique<AsyncWriter>(
+    std::move(sinks), settings, allocator, [this](const std::string & msg) {err_handler_(msg);});
+}
+
+void
+Logger::log(
+  spdlog::string_view_t name, spdlog::level::level_enum level, spdlog::string_view_t msg)
+{
+  bool log_enabled = should_log(level);
+  bool traceback_enabled = tracer_.enabled();
+  if (!log_enabled && !traceback_enabled) {
+    return;
+  }
+  spdlog::details::log_msg log_msg(name, level, msg);
+  log_it_(log_msg, log_enabled, traceback_enabled);
+}
+
+void
+Logger::log(
+  spdlog::log_clock::time_point time, spdlog::string_view_t name,
+  spdlog::level::level_enum level, spdlog::string_view_t msg)
+{
+  bool log_enabled = should_log(level);
+  bool traceback_enabled = tracer_.enabled();
+  if (!log_enabled && !traceback_enabled) {
+    return;
+  }
+  spdlog::details::log_msg log_msg(time, spdlog::source_loc(), name, level, msg);
+  log_it_(log_msg, log_enabled, traceback_enabled);
+}
+
+void
+Logger::log_batch(const spdlog::details::log_msg * msgs, size_t count)
+{
+  bool traceback_enabled = tracer_.enabled();
+  if (nullptr != async_writer_ || traceback_enabled) {
+    for (size_t i = 0; i < count; ++i) {
+      log_it_(msgs[i], should_log(msgs[i].level), traceback_enabled);
+    }
+    return;
+  }
+
+  try {
+    for (size_t sink_index = 0; sink_index < sinks_.size(); ++sink_index) {
+      if (nullptr != batch_sinks_[sink_index]) {
+        batch_sinks_[sink_index]->log_batch(msgs, count);
+        continue;
+      }
+      const spdlog::sink_ptr & sink = sinks_[sink_index];
+      for (size_t i = 0; i < count; ++i) {
+        if (sink->should_log(msgs[i].level)) {
+          sink->log(msgs[i]);
+        }
+      }
+    }
+  } catch (const std::exception & ex) {
+    // Reported like spdlog::logger does for single messages.
+    err_handler_(ex.what());
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    if (should_flush_(msgs[i])) {
+      flush_();
+      break;
+    }
+  }
+}
+
+uint64_t
+Logger::queue_depth() const
+{
+  return nullptr == async_writer_ ? 0 : async_writer_->queue_depth();
+}
+
+uint64_t
+Logger::peak_queue_depth() const
+{
+  return nullptr == async_writer_ ? 0 : async_writer_->peak_queue_depth();
+}
+
+uint64_t
+Logger::dropped() const
+{
+  return nullptr == async_writer_ ? 0 : async_writer_->dropped();
+}
+
+void
+Logger::sink_it_(const spdlog::details::log_msg & msg)
+{
+  if (nullptr == async_writer_) {
+    spdlog::logger::sink_it_(msg);
+    return;
+  }
+  async_writer_->post(msg);
+}
+
+void
+Logger::flush_()
+{
+  if (nullptr == async_writer_) {
+    spdlog::logger::flush_();
+    return;
+  }
+  async_writer_->post_flush();
+}
+
+}  // namespace rcl_logging_spdlog
@@ -0,0 +1,115 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_LOGGING_SPDLOG__LOGGER_HPP_
+#define RCL_LOGGING_SPDLOG__LOGGER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "rcutils/allocator.h"
+
+#include "spdlog/logger.h"
+
+#include "rcl_logging_interface/visibility_control.h"
+
+#include "rcl_logging_spdlog/async_writer.hpp"
+#include "rcl_logging_spdlog/batch_sink.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+/// An spdlog logger which records the name of the rcl logger in each message.
+/**
+ * spdlog fills in log_msg::logger_name with the name of the spdlog logger,
+ * but every rcl logger goes through this single instance, so this logger takes
+ * the name from the caller instead.
+ * That lets sinks (the binary sink for instance) tell rcl loggers apart.
+ *
+ * When asynchronous, messages are handed over to an AsyncWriter instead of
+ * being written on the calling thread, like spdlog::async_logger does with
+ * its thread pool.
+ */
+class RCL_LOGGING_INTERFACE_LOCAL Logger final : public spdlog::logger
+{
+public:
+  /// Create a logger which writes to its sinks synchronously.
+  explicit Logger(std::vector<spdlog::sink_ptr> sinks);
+
+  /// Create a logger which writes to its sinks from background threads.
+  /**
+   * \param allocator allocates the queue of the threads, see AsyncWriter.
+   * \throws std::bad_alloc if the queue can't be allocated.
+   * \throws std::system_error if a thread can't be started.
+   */
+  Logger(
+    std::vector<spdlog::sink_ptr> sinks, const AsyncWriterSettings & settings,
+    rcutils_allocator_t allocator);
+
+  /// Log a message on behalf of the named rcl logger.
+  /**
+   * \param[in] name The name of the rcl logger, empty for the root logger.
+   */
+  void
+  log(spdlog::string_view_t name, spdlog::level::level_enum level, spdlog::string_view_t msg);
+
+  /// Log a message on behalf of the named rcl logger, with the time it was logged at.
+  void
+  log(
+    spdlog::log_clock::time_point time, spdlog::string_view_t name,
+    spdlog::level::level_enum level, spdlog::string_view_t msg);
+
+  /// Log several messages, each already naming its rcl logger.
+  /**
+   * Unlike log(), this doesn't check the messages against the level of the
+   * logger, that is up to the caller.
+   * Sinks implementing BatchSink get the whole batch at once.
+   * Handing messages over to the background threads still happens one at a
+   * time.
+   */
+  void
+  log_batch(const spdlog::details::log_msg * msgs, size_t count);
+
+  /// The number of messages waiting for the background threads, 0 without them.
+  uint64_t
+  queue_depth() const;
+
+  /// The largest queue_depth() seen when handing over a message.
+  uint64_t
+  peak_queue_depth() const;
+
+  /// The number of messages dropped because the queue of the background threads was full.
+  uint64_t
+  dropped() const;
+
+protected:
+  void
+  sink_it_(const spdlog::details::log_msg & msg) override;
+
+  void
+  flush_() override;
+
+private:
+  // For each of sinks_, the sink as a BatchSink, or nullptr if it isn't one.
+  std::vector<BatchSink *> batch_sinks_;
+  // Only when asynchronous. Destroyed first, so that it writes out what it
+  // still has queued while the rest of the logger is around.
+  std::unique_ptr<AsyncWriter> async_writer_;
+};
+
+}  // namespace rcl_logging_spdlog
+
+#endif  // RCL_LOGGING_SPDLOG__LOGGER_HPP_
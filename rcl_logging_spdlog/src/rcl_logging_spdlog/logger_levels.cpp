@@ -0,0 +1,285 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "rcutils/logging.h"
+
+#include "rcl_logging_spdlog/logger_levels.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+namespace
+{
+
+// Generations are unique across all LoggerLevels instances, so that a cache
+// entry can never be mistaken for one filled from a different trie.
+std::atomic<uint64_t> g_next_generation{1};
+
+struct CacheEntry
+{
+  const char * name = nullptr;
+  size_t name_length = 0;
+  uint64_t generation = 0;
+  int level = 0;
+  // A copy of the name guards against a different logger name later being
+  // passed at the same address.  Longer names are simply not cached.
+  char name_copy[64] = {0};
+};
+
+constexpr size_t kCacheSize = 64;
+
+thread_local CacheEntry t_cache[kCacheSize];
+
+// A pointer to a trie which a reader is walking, which must not be freed.
+struct HazardPointer
+{
+  std::atomic<const void *> pointer{nullptr};
+  std::atomic<bool> in_use{false};
+  HazardPointer * next = nullptr;
+};
+
+// Every hazard pointer ever used, handed from exiting threads to new ones
+// rather than freed, so the list only grows to the most threads at once.
+std::atomic<HazardPointer *> g_hazard_pointers{nullptr};
+
+HazardPointer *
+acquire_hazard_pointer()
+{
+  for (HazardPointer * hazard = g_hazard_pointers.load(std::memory_order_acquire);
+    nullptr != hazard; hazard = hazard->next)
+  {
+    bool in_use = false;
+    if (!hazard->in_use.load(std::memory_order_relaxed) &&
+      hazard->in_use.compare_exchange_strong(in_use, true, std::memory_order_acquire))
+    {
+      return hazard;
+    }
+  }
+  auto hazard = new HazardPointer();
+  hazard->in_use.store(true, std::memory_order_relaxed);
+  HazardPointer * head = g_hazard_pointers.load(std::memory_order_relaxed);
+  do {
+    hazard->next = head;
+  } while (!g_hazard_pointers.compare_exchange_weak(
+    head, hazard, std::memory_order_release, std::memory_order_relaxed));
+  return hazard;
+}
+
+// The hazard pointer of this thread, taken on its first lookup.
+struct ThreadHazardPointer
+{
+  HazardPointer * hazard = acquire_hazard_pointer();
+
+  ~ThreadHazardPointer()
+  {
+    hazard->pointer.store(nullptr, std::memory_order_release);
+    hazard->in_use.store(false, std::memory_order_release);
+  }
+};
+
+thread_local ThreadHazardPointer t_hazard_pointer;
+
+size_t
+cache_index(const void * name)
+{
+  // The low bits are mostly alignment, so skip them.
+  return (reinterpret_cast<uintptr_t>(name) >> 4) % kCacheSize;
+}
+
+}  // namespace
+
+LoggerLevels::LoggerLevels(int root_level)
+: root_level_(root_level)
+{
+  publish();
+}
+
+LoggerLevels::~LoggerLevels() = default;
+
+void
+LoggerLevels::set_level(const char * name, int level)
+{
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  if (nullptr == name || '\0' == name[0]) {
+    root_level_ = level;
+  } else if (RCUTILS_LOG_SEVERITY_UNSET == level) {
+    explicit_levels_.erase(name);
+  } else {
+    explicit_levels_[name] = level;
+  }
+  publish();
+}
+
+int
+LoggerLevels::get_effective_level(std::string_view name) const
+{
+  // Announce the trie before walking it, and check that it is still current
+  // afterwards, so that publish() either sees the announcement or the reader
+  // sees the newer trie.
+  std::atomic<const void *> & hazard = t_hazard_pointer.hazard->pointer;
+  const Snapshot * snapshot = current_.load(std::memory_order_relaxed);
+  while (true) {
+    hazard.store(snapshot, std::memory_order_seq_cst);
+    const Snapshot * current = current_.load(std::memory_order_seq_cst);
+    if (current == snapshot) {
+      break;
+    }
+    snapshot = current;
+  }
+  int level = lookup(*snapshot, name);
+  hazard.store(nullptr, std::memory_order_release);
+  return level;
+}
+
+int
+LoggerLevels::lookup(const Snapshot & snapshot, std::string_view name)
+{
+  if (name.empty() || snapshot.root.children.empty()) {
+    return snapshot.root.level;
+  }
+
+  CacheEntry & entry = t_cache[cache_index(name.data())];
+  if (entry.name == name.data() && entry.name_length == name.size() &&
+    entry.generation == snapshot.generation &&
+    std::memcmp(entry.name_copy, name.data(), name.size()) == 0)
+  {
+    return entry.level;
+  }
+
+  // Walk down the trie one '.' separated component at a time, remembering the
+  // deepest explicitly set level seen along the way.
+  int level = snapshot.root.level;
+  const Node * node = &snapshot.root;
+  std::string_view remaining(name);
+  while (nullptr != node) {
+    size_t separator = remaining.find('.');
+    std::string_view component = remaining.substr(0, separator);
+    const Node * child = nullptr;
+    for (const auto & candidate : node->children) {
+      if (candidate.first == component) {
+        child = candidate.second.get();
+        break;
+      }
+    }
+    if (nullptr == child) {
+      break;
+    }
+    if (child->has_level) {
+      level = child->level;
+    }
+    if (std::string_view::npos == separator) {
+      break;
+    }
+    remaining.remove_prefix(separator + 1);
+    node = child;
+  }
+
+  if (name.size() <= sizeof(entry.name_copy)) {
+    std::memcpy(entry.name_copy, name.data(), name.size());
+    entry.name = name.data();
+    entry.name_length = name.size();
+    entry.generation = snapshot.generation;
+    entry.level = level;
+  }
+  return level;
+}
+
+int
+LoggerLevels::get_minimum_level() const
+{
+  return minimum_level_.load(std::memory_order_relaxed);
+}
+
+void
+LoggerLevels::reset(int root_level)
+{
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  root_level_ = root_level;
+  explicit_levels_.clear();
+  publish();
+}
+
+void
+LoggerLevels::publish()
+{
+  auto snapshot = std::make_unique<Snapshot>();
+  snapshot->generation = g_next_generation.fetch_add(1, std::memory_order_relaxed);
+  snapshot->root.level = root_level_;
+  snapshot->root.has_level = true;
+  int minimum_level = root_level_;
+
+  for (const auto & explicit_level : explicit_levels_) {
+    Node * node = &snapshot->root;
+    std::string_view remaining(explicit_level.first);
+    while (true) {
+      size_t separator = remaining.find('.');
+      std::string_view component = remaining.substr(0, separator);
+      Node * child = nullptr;
+      for (auto & candidate : node->children) {
+        if (candidate.first == component) {
+          child = candidate.second.get();
+          break;
+        }
+      }
+      if (nullptr == child) {
+        node->children.emplace_back(std::string(component), std::make_unique<Node>());
+        child = node->children.back().second.get();
+      }
+      node = child;
+      if (std::string_view::npos == separator) {
+        break;
+      }
+      remaining.remove_prefix(separator + 1);
+    }
+    node->level = explicit_level.second;
+    node->has_level = true;
+    minimum_level = std::min(minimum_level, explicit_level.second);
+  }
+
+  current_.store(snapshot.get(), std::memory_order_seq_cst);
+  minimum_level_.store(minimum_level, std::memory_order_relaxed);
+  snapshots_.push_back(std::move(snapshot));
+
+  // Pairs with the announcement in get_effective_level(): a reader which
+  // isn't seen here anymore has seen the new trie.
+  std::vector<const void *> hazards;
+  for (HazardPointer * hazard = g_hazard_pointers.load(std::memory_order_acquire);
+    nullptr != hazard; hazard = hazard->next)
+  {
+    const void * pointer = hazard->pointer.load(std::memory_order_seq_cst);
+    if (nullptr != pointer) {
+      hazards.push_back(pointer);
+    }
+  }
+  snapshots_.erase(
+    std::remove_if(
+      snapshots_.begin(), snapshots_.end() - 1,
+      [&hazards](const std::unique_ptr<Snapshot> & superseded) {
+        return std::find(hazards.begin(), hazards.end(), superseded.get()) == hazards.end();
+      }),
+    snapshots_.end() - 1);
+}
+
+}  // namespace rcl_logging_spdlog
@@ -0,0 +1,122 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_LOGGING_SPDLOG__LOGGER_LEVELS_HPP_
+#define RCL_LOGGING_SPDLOG__LOGGER_LEVELS_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "rcl_logging_interface/visibility_control.h"
+
+namespace rcl_logging_spdlog
+{
+
+/// Severity thresholds for named loggers, with hierarchical inheritance.
+/**
+ * Logger names are split on '.', and a logger without an explicit level
+ * inherits the level of its closest ancestor, falling back to the root logger.
+ * So setting the level of "a.b" also applies to "a.b.c", but not to "a.bc".
+ *
+ * Writers serialize on a mutex and publish an immutable trie through an atomic
+ * pointer, so get_effective_level() never takes a lock.
+ * Readers announce the trie they walk in a hazard pointer of their thread, and
+ * writers free superseded tries as soon as no hazard pointer refers to them,
+ * so changing levels at runtime doesn't keep adding to the memory used.
+ */
+class RCL_LOGGING_INTERFACE_LOCAL LoggerLevels final
+{
+public:
+  explicit LoggerLevels(int root_level);
+
+  ~LoggerLevels();
+
+  LoggerLevels(const LoggerLevels &) = delete;
+  LoggerLevels & operator=(const LoggerLevels &) = delete;
+
+  /// Set the level of a logger.
+  /**
+   * A NULL or empty name sets the level of the root logger.
+   * Setting a named logger to RCUTILS_LOG_SEVERITY_UNSET removes its explicit
+   * level, so that it inherits from its ancestors again.
+   */
+  void
+  set_level(const char * name, int level);
+
+  /// Get the level that applies to a logger, taking inheritance into account.
+  /**
+   * This is safe to call concurrently with set_level().
+   * Results are cached per thread by name pointer, so repeated lookups of the
+   * same logger don't walk the trie.
+   */
+  int
+  get_effective_level(std::string_view name) const;
+
+  /// Same as above, for a NULL terminated name, or NULL for the root logger.
+  int
+  get_effective_level(const char * name) const
+  {
+    return get_effective_level(nullptr == name ? std::string_view() : std::string_view(name));
+  }
+
+  /// Get the lowest level set on any logger, including the root logger.
+  int
+  get_minimum_level() const;
+
+  /// Drop all per-logger levels and set the root level.
+  void
+  reset(int root_level);
+
+private:
+  struct Node
+  {
+    int level = 0;
+    bool has_level = false;
+    std::vector<std::pair<std::string, std::unique_ptr<Node>>> children;
+  };
+
+  struct Snapshot
+  {
+    uint64_t generation = 0;
+    Node root;
+  };
+
+  // get_effective_level() for a trie already safe to walk.
+  static int
+  lookup(const Snapshot & snapshot, std::string_view name);
+
+  // Publish a trie of the current levels, and free the superseded ones no
+  // reader is walking any more.
+  void
+  publish();
+
+  mutable std::mutex write_mutex_;
+  int root_level_;
+  std::map<std::string, int> explicit_levels_;
+  // The current trie, and those superseded but maybe still being walked.
+  std::vector<std::unique_ptr<Snapshot>> snapshots_;
+  std::atomic<const Snapshot *> current_{nullptr};
+  std::atomic<int> minimum_level_{0};
+};
+
+}  // namespace rcl_logging_spdlog
+
+#endif  // RCL_LOGGING_SPDLOG__LOGGER_LEVELS_HPP_
@@ -0,0 +1,163 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#include "spdlog/common.h"
+
+#include "rcl_logging_spdlog/mapped_file_writer.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+MappedFileWriter::MappedFileWriter(const std::string & filename, size_t window_size)
+: filename_(filename),
+  window_size_(window_size),
+  fd_(-1),
+  mapping_(nullptr),
+  window_offset_(0),
+  window_length_(0),
+  offset_(0)
+{
+#ifdef _WIN32
+  spdlog::throw_spdlog_ex("Memory-mapped log files are not supported on this platform");
+#else
+  if (0 == window_size_) {
+    spdlog::throw_spdlog_ex("The window size of memory-mapped log files must not be 0");
+  }
+  fd_ = ::open(filename_.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if (fd_ < 0) {
+    spdlog::throw_spdlog_ex("Failed opening file " + filename_ + " for writing", errno);
+  }
+  struct stat file_status;
+  if (0 != ::fstat(fd_, &file_status)) {
+    int error = errno;
+    ::close(fd_);
+    spdlog::throw_spdlog_ex("Failed getting the size of file " + filename_, error);
+  }
+  offset_ = static_cast<size_t>(file_status.st_size);
+  try {
+    map_window(0);
+  } catch (const spdlog::spdlog_ex &) {
+    ::close(fd_);
+    throw;
+  }
+#endif
+}
+
+MappedFileWriter::~MappedFileWriter()
+{
+#ifndef _WIN32
+  unmap_window();
+  // Drop the unused, preallocated tail.  There is nowhere to report an error
+  // from here, and the data is there either way.
+  (void)::ftruncate(fd_, static_cast<off_t>(offset_));
+  ::close(fd_);
+#endif
+}
+
+void
+MappedFileWriter::write(const char * data, size_t size)
+{
+  if (nullptr == mapping_ || offset_ + size > window_offset_ + window_length_) {
+    map_window(size);
+  }
+  std::memcpy(mapping_ + (offset_ - window_offset_), data, size);
+  offset_ += size;
+}
+
+void
+MappedFileWriter::flush()
+{
+}
+
+void
+MappedFileWriter::sync()
+{
+#ifndef _WIN32
+  if (nullptr != mapping_ &&
+    0 != ::msync(mapping_, offset_ - window_offset_, MS_SYNC))
+  {
+    spdlog::throw_spdlog_ex("Failed syncing file " + filename_, errno);
+  }
+#endif
+}
+
+size_t
+MappedFileWriter::size() const
+{
+  return offset_;
+}
+
+void
+MappedFileWriter::map_window(size_t size)
+{
+#ifdef _WIN32
+  (void)size;
+#else
+  unmap_window();
+
+  // Mappings have to start on a page boundary.
+  static const size_t page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+  size_t window_offset = offset_ - offset_ % page_size;
+  size_t window_length = std::max(window_size_, offset_ - window_offset + size);
+
+  int ret = -1;
+#ifdef __linux__
+  // Allocate the blocks now, so that writing to the mapping never has to.
+  ret = ::fallocate(
+    fd_, 0, static_cast<off_t>(window_offset), static_cast<off_t>(window_length));
+#endif
+  if (0 != ret) {
+    // Not available on this system or file system, at least set the size.
+    ret = ::ftruncate(fd_, static_cast<off_t>(window_offset + window_length));
+  }
+  if (0 != ret) {
+    spdlog::throw_spdlog_ex("Failed allocating file " + filename_, errno);
+  }
+
+  void * mapping = ::mmap(
+    nullptr, window_length, PROT_WRITE, MAP_SHARED, fd_, static_cast<off_t>(window_offset));
+  if (MAP_FAILED == mapping) {
+    spdlog::throw_spdlog_ex("Failed mapping file " + filename_, errno);
+  }
+  mapping_ = static_cast<char *>(mapping);
+  window_offset_ = window_offset;
+  window_length_ = window_length;
+  ::madvise(mapping_, window_length_, MADV_SEQUENTIAL);
+#endif
+}
+
+void
+MappedFileWriter::unmap_window()
+{
+#ifndef _WIN32
+  if (nullptr != mapping_) {
+    ::munmap(mapping_, window_length_);
+    mapping_ = nullptr;
+  }
+#endif
+}
+
+}  // namespace rcl_logging_spdlog
@@ -0,0 +1,82 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_LOGGING_SPDLOG__MAPPED_FILE_WRITER_HPP_
+#define RCL_LOGGING_SPDLOG__MAPPED_FILE_WRITER_HPP_
+
+#include <cstddef>
+#include <string>
+
+#include "rcl_logging_interface/visibility_control.h"
+
+#include "rcl_logging_spdlog/file_writer.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+/// Writes a file through preallocated, memory-mapped windows.
+/**
+ * The file is allocated a window at a time and the window is mapped into
+ * memory, so an append is a memcpy into the mapping: no system call and no
+ * file size or block allocation changes, until the window is full and the next
+ * one is mapped.
+ * A write never straddles two windows, a window is made large enough for it.
+ *
+ * Like other log files, an existing file is appended to.
+ * When the writer is destroyed the file is truncated to the bytes actually
+ * written.  If the process dies before that, the rest of the last window reads
+ * as NUL bytes.
+ *
+ * This is only supported on POSIX systems; on others construction throws.
+ */
+class RCL_LOGGING_INTERFACE_LOCAL MappedFileWriter final : public FileWriter
+{
+public:
+  MappedFileWriter(const std::string & filename, size_t window_size);
+
+  ~MappedFileWriter() override;
+
+  void
+  write(const char * data, size_t size) override;
+
+  /// The data is in the page cache as soon as it is written, so this does nothing.
+  void
+  flush() override;
+
+  void
+  sync() override;
+
+  size_t
+  size() const override;
+
+private:
+  void
+  map_window(size_t size);
+
+  void
+  unmap_window();
+
+  std::string filename_;
+  size_t window_size_;
+  int fd_;
+  char * mapping_;
+  // The file offset and length of the current mapping.
+  size_t window_offset_;
+  size_t window_length_;
+  size_t offset_;
+};
+
+}  // namespace rcl_logging_spdlog
+
+#endif  // RCL_LOGGING_SPDLOG__MAPPED_FILE_WRITER_HPP_
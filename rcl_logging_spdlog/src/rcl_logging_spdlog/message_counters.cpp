@@ -0,0 +1,94 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "spdlog/common.h"
+
+#include "rcl_logging_interface/rcl_logging_interface.h"
+
+#include "rcl_logging_spdlog/message_counters.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+namespace
+{
+
+std::atomic<size_t> g_next_shard{0};
+
+size_t
+severity_index(spdlog::level::level_enum level)
+{
+  // Messages are mapped to debug through critical, off for those above fatal.
+  level = std::clamp(level, spdlog::level::debug, spdlog::level::critical);
+  return static_cast<size_t>(level - spdlog::level::debug);
+}
+
+}  // namespace
+
+MessageCounters::MessageCounters()
+{
+  reset();
+}
+
+void
+MessageCounters::accepted(spdlog::level::level_enum level)
+{
+  shard().accepted[severity_index(level)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void
+MessageCounters::filtered(spdlog::level::level_enum level)
+{
+  shard().filtered[severity_index(level)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void
+MessageCounters::read(rcl_logging_stats_t & stats) const
+{
+  for (size_t i = 0; i < RCL_LOGGING_STATS_SEVERITY_COUNT; ++i) {
+    stats.accepted[i] = 0;
+    stats.filtered[i] = 0;
+    for (const Shard & shard : shards_) {
+      stats.accepted[i] += shard.accepted[i].load(std::memory_order_relaxed);
+      stats.filtered[i] += shard.filtered[i].load(std::memory_order_relaxed);
+    }
+  }
+}
+
+void
+MessageCounters::reset()
+{
+  for (Shard & shard : shards_) {
+    for (size_t i = 0; i < RCL_LOGGING_STATS_SEVERITY_COUNT; ++i) {
+      shard.accepted[i].store(0, std::memory_order_relaxed);
+      shard.filtered[i].store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+MessageCounters::Shard &
+MessageCounters::shard()
+{
+  // Threads are spread over the shards in the order they first count, the
+  // same shard for a thread whatever the instance.
+  thread_local size_t t_shard = g_next_shard.fetch_add(1, std::memory_order_relaxed) % kShardCount;
+  return shards_[t_shard];
+}
+
+}  // namespace rcl_logging_spdlog
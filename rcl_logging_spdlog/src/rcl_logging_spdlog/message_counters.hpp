@@ -0,0 +1,81 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_LOGGING_SPDLOG__MESSAGE_COUNTERS_HPP_
+#define RCL_LOGGING_SPDLOG__MESSAGE_COUNTERS_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "spdlog/common.h"
+
+#include "rcl_logging_interface/rcl_logging_interface.h"
+#include "rcl_logging_interface/visibility_control.h"
+
+namespace rcl_logging_spdlog
+{
+
+/// Counts the messages accepted and filtered per level, from any number of threads.
+/**
+ * Each thread counts in one of a fixed number of shards, picked when it first
+ * counts, so that threads logging at once mostly don't write to the same cache
+ * line.
+ * Reading sums up the shards, without synchronizing with the threads counting.
+ */
+class RCL_LOGGING_INTERFACE_LOCAL MessageCounters final
+{
+public:
+  MessageCounters();
+
+  MessageCounters(const MessageCounters &) = delete;
+  MessageCounters & operator=(const MessageCounters &) = delete;
+
+  /// Count a message passed on to the sinks.
+  void
+  accepted(spdlog::level::level_enum level);
+
+  /// Count a message which isn't written.
+  void
+  filtered(spdlog::level::level_enum level);
+
+  /// Fill in stats.accepted and stats.filtered.
+  void
+  read(rcl_logging_stats_t & stats) const;
+
+  /// Start counting from zero again.
+  /**
+   * Messages counted concurrently may or may not be counted afterwards.
+   */
+  void
+  reset();
+
+private:
+  static constexpr size_t kShardCount = 16;
+
+  struct alignas(64) Shard
+  {
+    std::atomic<uint64_t> accepted[RCL_LOGGING_STATS_SEVERITY_COUNT];
+    std::atomic<uint64_t> filtered[RCL_LOGGING_STATS_SEVERITY_COUNT];
+  };
+
+  Shard &
+  shard();
+
+  Shard shards_[kShardCount];
+};
+
+}  // namespace rcl_logging_spdlog
+
+#endif  // RCL_LOGGING_SPDLOG__MESSAGE_COUNTERS_HPP_
@@ -0,0 +1,178 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "spdlog/common.h"
+
+#include "rcl_logging_spdlog/message_filter.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+namespace
+{
+
+// How far into a message to look for the end of the rcutils prefix.
+constexpr size_t kMaxPrefixLength = 256;
+
+std::string_view
+strip_prefix(std::string_view msg)
+{
+  size_t end = msg.substr(0, kMaxPrefixLength).find("]: ");
+  return std::string_view::npos == end ? msg : msg.substr(end + 3);
+}
+
+std::string
+describe_logger(std::string_view name)
+{
+  return name.empty() ? "the root logger" : "logger '" + std::string(name) + "'";
+}
+
+}  // namespace
+
+MessageFilter::MessageFilter(const MessageFilterSettings & settings)
+: settings_(settings),
+  burst_(static_cast<double>(
+      0 == settings.rate_limit_burst ? settings.rate_limit : settings.rate_limit_burst))
+{
+  for (Shard & shard : shards_) {
+    shard.entries.resize(kCapacity / kShardCount);
+  }
+}
+
+MessageFilter::Decision
+MessageFilter::check(
+  std::string_view name, spdlog::level::level_enum level, std::string_view msg,
+  bool formatted)
+{
+  Decision decision{true, 0, 0};
+  std::string_view compared = settings_.suppress_duplicates && formatted ? strip_prefix(msg) : msg;
+  Clock::time_point now = Clock::now();
+
+  size_t hash = std::hash<std::string_view>()(name) ^ static_cast<size_t>(level);
+  Shard & shard = shards_[hash % kShardCount];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  Entry * entry = find(shard, hash, name, level, now);
+  if (nullptr == entry) {
+    return decision;
+  }
+
+  if (settings_.suppress_duplicates && entry->has_last_message &&
+    entry->last_message == compared)
+  {
+    ++entry->repeated;
+    decision.log = false;
+    if (settings_.duplicate_report_interval.count() > 0 &&
+      now - entry->repeated_reported >= settings_.duplicate_report_interval)
+    {
+      decision.repeated = std::exchange(entry->repeated, 0);
+      entry->repeated_reported = now;
+    }
+    return decision;
+  }
+
+  if (settings_.rate_limit > 0) {
+    std::chrono::duration<double> elapsed = now - entry->last_refill;
+    entry->tokens = std::min(
+      burst_, entry->tokens + elapsed.count() * static_cast<double>(settings_.rate_limit));
+    entry->last_refill = now;
+    if (entry->tokens < 1.0) {
+      ++entry->dropped;
+      decision.log = false;
+      return decision;
+    }
+    entry->tokens -= 1.0;
+    decision.dropped = std::exchange(entry->dropped, 0);
+  }
+
+  if (settings_.suppress_duplicates) {
+    decision.repeated = std::exchange(entry->repeated, 0);
+    entry->has_last_message = true;
+    // Only allocates when the message is longer than any before.
+    entry->last_message.assign(compared.data(), compared.size());
+    entry->repeated_reported = now;
+  }
+  return decision;
+}
+
+std::vector<MessageFilter::Pending>
+MessageFilter::take_pending()
+{
+  std::vector<Pending> pending;
+  for (Shard & shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    for (Entry & entry : shard.entries) {
+      if (entry.used && (entry.repeated > 0 || entry.dropped > 0)) {
+        pending.push_back(
+          {entry.name, entry.level, std::exchange(entry.repeated, 0),
+            std::exchange(entry.dropped, 0)});
+      }
+    }
+  }
+  return pending;
+}
+
+std::string
+MessageFilter::repeated_message(std::string_view name, uint64_t repeated)
+{
+  return "--- The previous message of " + describe_logger(name) + " was repeated " +
+         std::to_string(repeated) + " times ---";
+}
+
+std::string
+MessageFilter::dropped_message(std::string_view name, uint64_t dropped)
+{
+  return "--- " + std::to_string(dropped) + " messages of " + describe_logger(name) +
+         " were dropped by the rate limit ---";
+}
+
+MessageFilter::Entry *
+MessageFilter::find(
+  Shard & shard, size_t hash, std::string_view name, spdlog::level::level_enum level,
+  Clock::time_point now)
+{
+  // Open addressing with linear probing, entries are never removed.  The low
+  // bits of the hash picked the shard, so the probing starts from the others.
+  size_t start = hash / kShardCount;
+  size_t size = shard.entries.size();
+  for (size_t probe = 0; probe < size; ++probe) {
+    Entry & entry = shard.entries[(start + probe) % size];
+    if (!entry.used) {
+      entry.used = true;
+      entry.hash = hash;
+      entry.name = std::string(name);
+      entry.level = level;
+      // Starts out full.
+      entry.tokens = burst_;
+      entry.last_refill = now;
+      return &entry;
+    }
+    if (entry.hash == hash && entry.level == level && entry.name == name) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace rcl_logging_spdlog
@@ -0,0 +1,170 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_LOGGING_SPDLOG__MESSAGE_FILTER_HPP_
+#define RCL_LOGGING_SPDLOG__MESSAGE_FILTER_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "spdlog/common.h"
+
+#include "rcl_logging_interface/visibility_control.h"
+
+namespace rcl_logging_spdlog
+{
+
+/// What a MessageFilter lets through.
+struct MessageFilterSettings
+{
+  /// The messages per second let through for each logger and level, 0 for unlimited.
+  size_t rate_limit = 0;
+  /// How many messages can be let through at once after a quiet period, 0
+  /// for rate_limit.
+  size_t rate_limit_burst = 0;
+  /// Suppress messages identical to the previous one of the same logger and level.
+  bool suppress_duplicates = false;
+  /// How often to report a run of duplicates while it lasts, 0 for only once
+  /// it ends.
+  std::chrono::seconds duplicate_report_interval{10};
+
+  bool
+  enabled() const
+  {
+    return rate_limit > 0 || suppress_duplicates;
+  }
+};
+
+/// Keeps a misbehaving logger from flooding the log file.
+/**
+ * Each logger name and level gets a token bucket, refilled at rate_limit
+ * tokens per second up to rate_limit_burst, and each message takes a token.
+ * Messages arriving to an empty bucket are dropped.
+ *
+ * With suppress_duplicates, a message identical to the previous one let
+ * through for the same logger name and level is dropped too.
+ * Messages formatted by rcutils are compared from the first "]: " on, if
+ * there is one early on, so that the time stamp which rcutils puts in front
+ * of them with the default output format doesn't make every message unique.
+ *
+ * What was dropped is reported once the next message is let through, see
+ * Decision, so the log still says what happened.
+ *
+ * The logger name and level pairs are spread over kShardCount shards by
+ * their hash, each with a lock and kCapacity / kShardCount entries of its
+ * own, so that loggers only contend with the others of the same shard.
+ * Once the entries of a shard are all taken, messages of any further pairs
+ * hashed to it are always let through.
+ *
+ * This is not real-time safe: check() takes the lock of a shard, and may
+ * allocate to track a new pair or to keep a message longer than any before.
+ */
+class RCL_LOGGING_INTERFACE_LOCAL MessageFilter final
+{
+public:
+  static constexpr size_t kCapacity = 1024;
+  static constexpr size_t kShardCount = 16;
+
+  /// What to do with a message.
+  struct Decision
+  {
+    /// Whether to log the message.
+    bool log;
+    /// Report first that the previous message was repeated this many times.
+    uint64_t repeated;
+    /// Report first that this many messages were dropped by the rate limit.
+    uint64_t dropped;
+  };
+
+  /// Suppressed messages not reported yet.
+  struct Pending
+  {
+    std::string name;
+    spdlog::level::level_enum level;
+    uint64_t repeated;
+    uint64_t dropped;
+  };
+
+  explicit MessageFilter(const MessageFilterSettings & settings);
+
+  MessageFilter(const MessageFilter &) = delete;
+  MessageFilter & operator=(const MessageFilter &) = delete;
+
+  /// Decide whether to log a message, and what to report before it.
+  /**
+   * \param[in] formatted Whether msg was formatted by rcutils, and so may
+   *   start with a prefix to leave out of the comparison.
+   */
+  Decision
+  check(
+    std::string_view name, spdlog::level::level_enum level, std::string_view msg,
+    bool formatted);
+
+  /// Take what wasn't reported yet, to be reported before shutting down.
+  std::vector<Pending>
+  take_pending();
+
+  /// The text reporting that a message was repeated.
+  static std::string
+  repeated_message(std::string_view name, uint64_t repeated);
+
+  /// The text reporting that messages were dropped by the rate limit.
+  static std::string
+  dropped_message(std::string_view name, uint64_t dropped);
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Entry
+  {
+    bool used = false;
+    size_t hash = 0;
+    std::string name;
+    spdlog::level::level_enum level = spdlog::level::off;
+
+    double tokens = 0.0;
+    Clock::time_point last_refill;
+    uint64_t dropped = 0;
+
+    bool has_last_message = false;
+    std::string last_message;
+    uint64_t repeated = 0;
+    Clock::time_point repeated_reported;
+  };
+
+  struct alignas(64) Shard
+  {
+    std::mutex mutex;
+    std::vector<Entry> entries;
+  };
+
+  /// Find the entry of a logger name and level in its shard, whose lock must be held.
+  Entry *
+  find(
+    Shard & shard, size_t hash, std::string_view name, spdlog::level::level_enum level,
+    Clock::time_point now);
+
+  MessageFilterSettings settings_;
+  double burst_;
+  Shard shards_[kShardCount];
+};
+
+}  // namespace rcl_logging_spdlog
+
+#endif  // RCL_LOGGING_SPDLOG__MESSAGE_FILTER_HPP_
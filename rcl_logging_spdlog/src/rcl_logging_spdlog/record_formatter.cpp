@@ -0,0 +1,264 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "rcutils/logging.h"
+
+#include "spdlog/common.h"
+#include "spdlog/details/os.h"
+
+#include "rcl_logging_interface/rcl_logging_interface.h"
+
+#include "rcl_logging_spdlog/record_formatter.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+namespace
+{
+
+constexpr int64_t kNanosecondsPerSecond = 1000 * 1000 * 1000;
+// The most any token rendering a number takes, like
+// "-9223372036854775808.999999999" for {time}.
+constexpr size_t kMaxNumberSize = 32;
+
+// The names rcutils gives the severities, those in between counted with the
+// next higher one like everywhere else in the backend.
+std::string_view
+severity_name(int severity)
+{
+  if (severity <= RCUTILS_LOG_SEVERITY_UNSET) {
+    return "UNSET";
+  } else if (severity <= RCUTILS_LOG_SEVERITY_DEBUG) {
+    return "DEBUG";
+  } else if (severity <= RCUTILS_LOG_SEVERITY_INFO) {
+    return "INFO";
+  } else if (severity <= RCUTILS_LOG_SEVERITY_WARN) {
+    return "WARN";
+  } else if (severity <= RCUTILS_LOG_SEVERITY_ERROR) {
+    return "ERROR";
+  }
+  return "FATAL";
+}
+
+// Division rounding towards negative infinity, so that times before the
+// epoch still get a fraction between 0 and the divisor.
+int64_t
+floor_divide(int64_t value, int64_t divisor)
+{
+  int64_t quotient = value / divisor;
+  return quotient * divisor > value ? quotient - 1 : quotient;
+}
+
+size_t
+length_of(const char * text)
+{
+  return nullptr == text ? 0 : std::strlen(text);
+}
+
+char *
+write(char * out, const char * text, size_t length)
+{
+  if (length > 0) {
+    std::memcpy(out, text, length);
+  }
+  return out + length;
+}
+
+// Write the decimal digits of value, padded with zeros to at least min_digits.
+char *
+write_unsigned(char * out, uint64_t value, size_t min_digits = 1)
+{
+  char digits[20];
+  size_t count = 0;
+  do {
+    digits[sizeof(digits) - ++count] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value > 0);
+  while (count < min_digits) {
+    digits[sizeof(digits) - ++count] = '0';
+  }
+  return write(out, digits + sizeof(digits) - count, count);
+}
+
+char *
+write_signed(char * out, int64_t value)
+{
+  if (value < 0) {
+    *out++ = '-';
+    return write_unsigned(out, 0 - static_cast<uint64_t>(value));
+  }
+  return write_unsigned(out, static_cast<uint64_t>(value));
+}
+
+}  // namespace
+
+RecordFormatter::RecordFormatter(const std::string & format)
+{
+  static const std::pair<std::string_view, TokenType> kTokens[] = {
+    {"severity", TokenType::severity},
+    {"name", TokenType::name},
+    {"message", TokenType::message},
+    {"function_name", TokenType::function_name},
+    {"file_name", TokenType::file_name},
+    {"line_number", TokenType::line_number},
+    {"time", TokenType::time},
+    {"time_as_nanoseconds", TokenType::time_as_nanoseconds},
+    {"date_time_with_ms", TokenType::date_time_with_ms},
+  };
+
+  std::string literal;
+  size_t i = 0;
+  while (i < format.size()) {
+    size_t end = '{' == format[i] ? format.find('}', i) : std::string::npos;
+    if (std::string::npos != end) {
+      std::string_view name(format.data() + i + 1, end - i - 1);
+      auto found = std::find_if(
+        std::begin(kTokens), std::end(kTokens),
+        [name](const std::pair<std::string_view, TokenType> & token) {
+          return token.first == name;
+        });
+      if (found != std::end(kTokens)) {
+        if (!literal.empty()) {
+          tokens_.push_back({TokenType::literal, std::move(literal)});
+          literal.clear();
+        }
+        tokens_.push_back({found->second, std::string()});
+        i = end + 1;
+        continue;
+      }
+    }
+    literal += format[i++];
+  }
+  if (!literal.empty()) {
+    tokens_.push_back({TokenType::literal, std::move(literal)});
+  }
+}
+
+void
+RecordFormatter::format(
+  const rcl_logging_structured_record_t & record, TimeCache & cache,
+  spdlog::memory_buf_t & dest) const
+{
+  // Make room for the whole line first, so that each token is then copied
+  // straight in without checking for room again.
+  size_t file_name_length = 0;
+  size_t function_name_length = 0;
+  size_t size = 0;
+  for (const Token & token : tokens_) {
+    switch (token.type) {
+      case TokenType::literal:
+        size += token.text.size();
+        break;
+      case TokenType::name:
+        size += record.name_length;
+        break;
+      case TokenType::message:
+        size += record.msg_length;
+        break;
+      case TokenType::function_name:
+        function_name_length = length_of(record.function_name);
+        size += function_name_length;
+        break;
+      case TokenType::file_name:
+        file_name_length = length_of(record.file_name);
+        size += file_name_length;
+        break;
+      default:
+        size += kMaxNumberSize;
+        break;
+    }
+  }
+  size_t start = dest.size();
+  dest.resize(start + size);
+  char * out = dest.data() + start;
+
+  for (const Token & token : tokens_) {
+    switch (token.type) {
+      case TokenType::literal:
+        out = write(out, token.text.data(), token.text.size());
+        break;
+      case TokenType::severity:
+        {
+          std::string_view name = severity_name(record.severity);
+          out = write(out, name.data(), name.size());
+        }
+        break;
+      case TokenType::name:
+        out = write(out, record.name, record.name_length);
+        break;
+      case TokenType::message:
+        out = write(out, record.msg, record.msg_length);
+        break;
+      case TokenType::function_name:
+        out = write(out, record.function_name, function_name_length);
+        break;
+      case TokenType::file_name:
+        out = write(out, record.file_name, file_name_length);
+        break;
+      case TokenType::line_number:
+        out = write_unsigned(out, record.line_number);
+        break;
+      case TokenType::time:
+        {
+          int64_t seconds = floor_divide(record.timestamp_ns, kNanosecondsPerSecond);
+          if (seconds != cache.seconds) {
+            char * end = write_signed(cache.seconds_text, seconds);
+            *end++ = '.';
+            cache.seconds_length = static_cast<size_t>(end - cache.seconds_text);
+            cache.seconds = seconds;
+          }
+          out = write(out, cache.seconds_text, cache.seconds_length);
+          out = write_unsigned(
+            out, static_cast<uint64_t>(record.timestamp_ns - seconds * kNanosecondsPerSecond), 9);
+        }
+        break;
+      case TokenType::time_as_nanoseconds:
+        out = write_signed(out, record.timestamp_ns);
+        break;
+      case TokenType::date_time_with_ms:
+        {
+          int64_t milliseconds = floor_divide(record.timestamp_ns, 1000 * 1000);
+          if (milliseconds != cache.date_time_milliseconds) {
+            int64_t seconds = floor_divide(milliseconds, 1000);
+            if (seconds != cache.date_time_seconds) {
+              std::tm tm = spdlog::details::os::localtime(static_cast<std::time_t>(seconds));
+              // Leave room for the milliseconds.
+              cache.date_time_length = std::strftime(
+                cache.date_time_text, sizeof(cache.date_time_text) - 4, "%Y-%m-%d %H:%M:%S", &tm);
+              cache.date_time_seconds = seconds;
+            }
+            char * fraction = cache.date_time_text + cache.date_time_length;
+            *fraction++ = '.';
+            write_unsigned(fraction, static_cast<uint64_t>(milliseconds - seconds * 1000), 3);
+            cache.date_time_milliseconds = milliseconds;
+          }
+          out = write(out, cache.date_time_text, cache.date_time_length + 4);
+        }
+        break;
+    }
+  }
+  dest.resize(static_cast<size_t>(out - dest.data()));
+}
+
+}  // namespace rcl_logging_spdlog
@@ -0,0 +1,101 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_LOGGING_SPDLOG__RECORD_FORMATTER_HPP_
+#define RCL_LOGGING_SPDLOG__RECORD_FORMATTER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "spdlog/common.h"
+
+#include "rcl_logging_interface/rcl_logging_interface.h"
+#include "rcl_logging_interface/visibility_control.h"
+
+namespace rcl_logging_spdlog
+{
+
+/// Formats structured records into lines of text, like rcutils formats messages.
+/**
+ * The format takes the same tokens as RCUTILS_CONSOLE_OUTPUT_FORMAT:
+ * {severity}, {name}, {message}, {function_name}, {file_name}, {line_number},
+ * {time}, {time_as_nanoseconds} and {date_time_with_ms}.
+ * Anything else, unknown tokens included, is copied as it is.
+ *
+ * The format is parsed once, up front.
+ * Rendering the time is the expensive part of a line, so it is kept in a
+ * TimeCache and only redone when the second, or for {date_time_with_ms} the
+ * millisecond, changes.
+ */
+class RCL_LOGGING_INTERFACE_LOCAL RecordFormatter final
+{
+public:
+  /// The rendered time of the last record formatted with it.
+  /**
+   * Formatting only reads and writes the cache it is given, so each thread
+   * keeps one of its own instead of sharing one under a lock.
+   * Its members are only meant to be used by the formatter.
+   */
+  struct TimeCache
+  {
+    // "<seconds>." for {time}.
+    int64_t seconds = INT64_MIN;
+    char seconds_text[24] = {};
+    size_t seconds_length = 0;
+    // "YYYY-MM-DD HH:MM:SS.mmm" in local time for {date_time_with_ms}, of
+    // which the date and time are only redone when the second changes.
+    int64_t date_time_seconds = INT64_MIN;
+    int64_t date_time_milliseconds = INT64_MIN;
+    char date_time_text[32] = {};
+    size_t date_time_length = 0;
+  };
+
+  explicit RecordFormatter(const std::string & format);
+
+  /// Append the formatted record to dest, without a line ending.
+  void
+  format(
+    const rcl_logging_structured_record_t & record, TimeCache & cache,
+    spdlog::memory_buf_t & dest) const;
+
+private:
+  enum class TokenType
+  {
+    literal,
+    severity,
+    name,
+    message,
+    function_name,
+    file_name,
+    line_number,
+    time,
+    time_as_nanoseconds,
+    date_time_with_ms,
+  };
+
+  struct Token
+  {
+    TokenType type;
+    // Only for literal tokens.
+    std::string text;
+  };
+
+  std::vector<Token> tokens_;
+};
+
+}  // namespace rcl_logging_spdlog
+
+#endif  // RCL_LOGGING_SPDLOG__RECORD_FORMATTER_HPP_
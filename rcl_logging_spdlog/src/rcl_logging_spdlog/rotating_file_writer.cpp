@@ -0,0 +1,116 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include "spdlog/details/file_helper.h"
+
+#include "rcl_logging_spdlog/rotating_file_writer.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+RotatingFileWriter::RotatingFileWriter(
+  const std::string & filename, Factory factory, const RotationSettings & settings)
+: filename_(filename),
+  factory_(std::move(factory)),
+  settings_(settings),
+  archiver_(settings.compress, settings.archiver_thread),
+  writer_(factory_(filename)),
+  segment_index_(0),
+  next_rotation_(std::chrono::steady_clock::now() + settings.interval)
+{
+}
+
+RotatingFileWriter::~RotatingFileWriter() = default;
+
+void
+RotatingFileWriter::write(const char * data, size_t size)
+{
+  writer_->write(data, size);
+}
+
+void
+RotatingFileWriter::flush()
+{
+  writer_->flush();
+}
+
+void
+RotatingFileWriter::sync()
+{
+  writer_->sync();
+}
+
+size_t
+RotatingFileWriter::size() const
+{
+  return writer_->size();
+}
+
+bool
+RotatingFileWriter::rotate_if_needed(size_t size)
+{
+  size_t current_size = writer_->size();
+  bool rotate = settings_.max_size > 0 && current_size > 0 &&
+    current_size + size > settings_.max_size;
+  if (settings_.interval.count() > 0) {
+    auto now = std::chrono::steady_clock::now();
+    if (now >= next_rotation_) {
+      // Don't leave empty segments behind for idle periods.
+      rotate = rotate || current_size > 0;
+      next_rotation_ = now + settings_.interval;
+    }
+  }
+  if (!rotate) {
+    return false;
+  }
+
+  // Open the next segment first, so that if that fails logging carries on in
+  // the current one.
+  std::unique_ptr<FileWriter> next_writer =
+    factory_(segment_filename(filename_, segment_index_ + 1));
+  std::swap(writer_, next_writer);
+  next_writer.reset();
+
+  std::string closed_segment = segment_filename(filename_, segment_index_);
+  ++segment_index_;
+  next_rotation_ = std::chrono::steady_clock::now() + settings_.interval;
+  archiver_.archive(closed_segment);
+  closed_segments_.push_back(std::move(closed_segment));
+  if (settings_.max_files > 0) {
+    while (closed_segments_.size() + 1 > settings_.max_files) {
+      archiver_.remove(closed_segments_.front());
+      closed_segments_.pop_front();
+    }
+  }
+  return true;
+}
+
+std::string
+RotatingFileWriter::segment_filename(const std::string & filename, size_t segment_index)
+{
+  if (0 == segment_index) {
+    return filename;
+  }
+  std::string basename, extension;
+  std::tie(basename, extension) = spdlog::details::file_helper::split_by_extension(filename);
+  return basename + "." + std::to_string(segment_index) + extension;
+}
+
+}  // namespace rcl_logging_spdlog
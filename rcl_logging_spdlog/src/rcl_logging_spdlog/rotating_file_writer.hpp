@@ -0,0 +1,118 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_LOGGING_SPDLOG__ROTATING_FILE_WRITER_HPP_
+#define RCL_LOGGING_SPDLOG__ROTATING_FILE_WRITER_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "rcl_logging_interface/visibility_control.h"
+
+#include "rcl_logging_spdlog/file_writer.hpp"
+#include "rcl_logging_spdlog/segment_archiver.hpp"
+#include "rcl_logging_spdlog/thread_settings.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+/// When a log file is split into segments, and what happens to the old ones.
+struct RotationSettings
+{
+  /// Start a new segment before one would grow past this many bytes, 0 for never.
+  size_t max_size = 0;
+  /// Start a new segment once one has been written to for this long, 0 for never.
+  std::chrono::seconds interval{0};
+  /// How many segments to keep, including the one being written, 0 for all.
+  size_t max_files = 0;
+  /// Whether to gzip segments once they are closed.
+  bool compress = false;
+  /// Where and how the thread archiving closed segments runs.
+  ThreadSettings archiver_thread;
+
+  bool
+  enabled() const
+  {
+    return max_size > 0 || interval.count() > 0;
+  }
+};
+
+/// Splits a log file into segments by size and/or age.
+/**
+ * The first segment uses the given file name, the following ones get the
+ * segment number inserted before the extension, i.e. "name.log",
+ * "name.1.log", "name.2.log" and so on.
+ * Each segment is written by its own FileWriter, and records are never split
+ * across segments, so a record larger than the maximum size gets a segment of
+ * its own.
+ *
+ * Closed segments are handed to a SegmentArchiver, which compresses them and
+ * deletes the oldest ones beyond the limit without blocking the logging thread.
+ */
+class RCL_LOGGING_INTERFACE_LOCAL RotatingFileWriter final : public FileWriter
+{
+public:
+  using Factory = std::function<std::unique_ptr<FileWriter>(const std::string & filename)>;
+
+  /// Open the first segment.
+  /**
+   * \param filename the name of the first segment.
+   * \param factory creates the writer for each segment.
+   * \param settings must have rotation enabled.
+   */
+  RotatingFileWriter(
+    const std::string & filename, Factory factory, const RotationSettings & settings);
+
+  ~RotatingFileWriter() override;
+
+  void
+  write(const char * data, size_t size) override;
+
+  void
+  flush() override;
+
+  void
+  sync() override;
+
+  /// The number of bytes in the current segment.
+  size_t
+  size() const override;
+
+  bool
+  rotate_if_needed(size_t size) override;
+
+  /// Get the name of a segment file.
+  static std::string
+  segment_filename(const std::string & filename, size_t segment_index);
+
+private:
+  std::string filename_;
+  Factory factory_;
+  RotationSettings settings_;
+  // Declared before the writer, so the current segment is closed before the
+  // archiver finishes its queue.
+  SegmentArchiver archiver_;
+  std::unique_ptr<FileWriter> writer_;
+  size_t segment_index_;
+  std::chrono::steady_clock::time_point next_rotation_;
+  std::deque<std::string> closed_segments_;
+};
+
+}  // namespace rcl_logging_spdlog
+
+#endif  // RCL_LOGGING_SPDLOG__ROTATING_FILE_WRITER_HPP_
@@ -0,0 +1,142 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <zlib.h>
+
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include "rcl_logging_spdlog/segment_archiver.hpp"
+#include "rcl_logging_spdlog/thread_settings.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+namespace
+{
+
+bool
+compress_file(const std::string & filename, const std::string & compressed_filename)
+{
+  std::ifstream input(filename, std::ios::binary);
+  if (!input) {
+    return false;
+  }
+  gzFile output = gzopen(compressed_filename.c_str(), "wb");
+  if (nullptr == output) {
+    return false;
+  }
+
+  bool ok = true;
+  char buffer[64 * 1024];
+  while (ok && input) {
+    input.read(buffer, sizeof(buffer));
+    auto count = static_cast<unsigned>(input.gcount());
+    if (count > 0 && gzwrite(output, buffer, count) != static_cast<int>(count)) {
+      ok = false;
+    }
+  }
+  ok = gzclose(output) == Z_OK && ok && input.eof();
+  if (!ok) {
+    std::remove(compressed_filename.c_str());
+  }
+  return ok;
+}
+
+}  // namespace
+
+SegmentArchiver::SegmentArchiver(bool compress, const ThreadSettings & thread_settings)
+: compress_(compress),
+  stopping_(false)
+{
+  thread_ = std::thread(&SegmentArchiver::run, this, thread_settings);
+}
+
+SegmentArchiver::~SegmentArchiver()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  condition_.notify_one();
+  thread_.join();
+}
+
+void
+SegmentArchiver::archive(const std::string & filename)
+{
+  if (compress_) {
+    push(Task{Task::Type::archive, filename});
+  }
+}
+
+void
+SegmentArchiver::remove(const std::string & filename)
+{
+  push(Task{Task::Type::remove, filename});
+}
+
+std::string
+SegmentArchiver::compressed_filename(const std::string & filename)
+{
+  return filename + ".gz";
+}
+
+void
+SegmentArchiver::push(Task task)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(task));
+  }
+  condition_.notify_one();
+}
+
+void
+SegmentArchiver::run(ThreadSettings thread_settings)
+{
+  if (!thread_settings.nice) {
+    thread_settings.nice = 19;
+  }
+  apply_thread_settings(thread_settings);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    condition_.wait(lock, [this] {return stopping_ || !tasks_.empty();});
+    if (tasks_.empty()) {
+      return;
+    }
+    Task task = std::move(tasks_.front());
+    tasks_.pop_front();
+    lock.unlock();
+
+    std::string compressed = compressed_filename(task.filename);
+    if (Task::Type::archive == task.type) {
+      if (compress_file(task.filename, compressed)) {
+        std::remove(task.filename.c_str());
+      }
+    } else {
+      std::remove(task.filename.c_str());
+      std::remove(compressed.c_str());
+    }
+
+    lock.lock();
+  }
+}
+
+}  // namespace rcl_logging_spdlog
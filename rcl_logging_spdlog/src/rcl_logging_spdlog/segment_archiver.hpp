@@ -0,0 +1,100 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_LOGGING_SPDLOG__SEGMENT_ARCHIVER_HPP_
+#define RCL_LOGGING_SPDLOG__SEGMENT_ARCHIVER_HPP_
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "rcl_logging_interface/visibility_control.h"
+
+#include "rcl_logging_spdlog/thread_settings.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+/// Compresses and removes closed log file segments on a background thread.
+/**
+ * Compressing a segment takes far longer than logging a message, so it is done
+ * here, by default at the lowest scheduling priority, instead of on the
+ * logging thread.
+ * Tasks are run one at a time, in the order they were queued, so a segment
+ * queued for removal after being queued for compression is never left behind.
+ *
+ * Failures are not reported anywhere, since there is no caller to report them
+ * to; a segment which couldn't be compressed is simply kept as it is.
+ */
+class RCL_LOGGING_INTERFACE_LOCAL SegmentArchiver final
+{
+public:
+  /// Start the background thread.
+  /**
+   * \param compress whether archive() compresses segments, or leaves them be.
+   * \param thread_settings where and how the thread runs, with a nice value
+   *   of 19 unless it sets one.
+   */
+  SegmentArchiver(bool compress, const ThreadSettings & thread_settings);
+
+  /// Finish all the queued tasks and stop the background thread.
+  ~SegmentArchiver();
+
+  SegmentArchiver(const SegmentArchiver &) = delete;
+  SegmentArchiver & operator=(const SegmentArchiver &) = delete;
+
+  /// Queue a closed segment to be compressed into a gzip file next to it.
+  void
+  archive(const std::string & filename);
+
+  /// Queue a closed segment to be deleted, whether compressed already or not.
+  void
+  remove(const std::string & filename);
+
+  /// Get the name of the compressed version of a segment.
+  static std::string
+  compressed_filename(const std::string & filename);
+
+private:
+  struct Task
+  {
+    enum class Type
+    {
+      archive,
+      remove,
+    };
+
+    Type type;
+    std::string filename;
+  };
+
+  void
+  push(Task task);
+
+  void
+  run(ThreadSettings thread_settings);
+
+  bool compress_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::deque<Task> tasks_;
+  bool stopping_;
+  std::thread thread_;
+};
+
+}  // namespace rcl_logging_spdlog
+
+#endif  // RCL_LOGGING_SPDLOG__SEGMENT_ARCHIVER_HPP_
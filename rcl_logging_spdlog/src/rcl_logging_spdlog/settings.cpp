@@ -0,0 +1,560 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _WIN32
+#include <signal.h>
+#endif
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rcpputils/env.hpp"
+
+#include "spdlog/common.h"
+
+#include "rcl_logging_spdlog/settings.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+namespace
+{
+
+bool
+parse_bool(const std::string & value)
+{
+  if ("0" == value) {
+    return false;
+  }
+  if ("1" == value) {
+    return true;
+  }
+  throw std::runtime_error("unrecognized value: " + value);
+}
+
+size_t
+parse_size(const std::string & value, bool allow_zero)
+{
+  // std::stoull silently negates values with a leading '-'
+  if (value.empty() || !std::isdigit(static_cast<unsigned char>(value[0]))) {
+    throw std::runtime_error("unrecognized value: " + value);
+  }
+  size_t pos = 0;
+  unsigned long long parsed = 0;  // NOLINT(runtime/int)
+  try {
+    parsed = std::stoull(value, &pos);
+  } catch (const std::logic_error &) {
+    // std::stoull throws std::invalid_argument or std::out_of_range
+    throw std::runtime_error("unrecognized value: " + value);
+  }
+  if (pos != value.size() || (0 == parsed && !allow_zero) || parsed > SIZE_MAX) {
+    throw std::runtime_error("unrecognized value: " + value);
+  }
+  return static_cast<size_t>(parsed);
+}
+
+size_t
+parse_size_at_most(const std::string & value, size_t max)
+{
+  size_t parsed = parse_size(value, false);
+  if (parsed > max) {
+    throw std::runtime_error("more than " + std::to_string(max) + ": " + value);
+  }
+  return parsed;
+}
+
+std::chrono::seconds
+parse_seconds(const std::string & value)
+{
+  return std::chrono::seconds(static_cast<std::chrono::seconds::rep>(parse_size(value, true)));
+}
+
+std::chrono::milliseconds
+parse_milliseconds(const std::string & value)
+{
+  return std::chrono::milliseconds(
+    static_cast<std::chrono::milliseconds::rep>(parse_size(value, false)));
+}
+
+template<typename T>
+T
+parse_choice(const std::string & value, std::initializer_list<std::pair<const char *, T>> choices)
+{
+  for (const auto & choice : choices) {
+    if (value == choice.first) {
+      return choice.second;
+    }
+  }
+  throw std::runtime_error("unrecognized value: " + value);
+}
+
+spdlog::level::level_enum
+parse_level(const std::string & value)
+{
+  return parse_choice<spdlog::level::level_enum>(
+    value, {
+      {"debug", spdlog::level::debug},
+      {"info", spdlog::level::info},
+      {"warn", spdlog::level::warn},
+      {"error", spdlog::level::err},
+      {"fatal", spdlog::level::critical},
+      {"none", spdlog::level::off},
+    });
+}
+
+std::string
+trim(const std::string & str)
+{
+  size_t begin = str.find_first_not_of(" \t\r");
+  if (std::string::npos == begin) {
+    return "";
+  }
+  size_t end = str.find_last_not_of(" \t\r");
+  return str.substr(begin, end - begin + 1);
+}
+
+// Get the value of a setting from what follows the '=' on its line.
+// Unquoted, a '#' starts a comment. In double quotes the value may hold a '#'
+// too, with '\"' and '\\' for a quote and a backslash.
+std::string
+parse_config_value(const std::string & text)
+{
+  std::string value = trim(text);
+  if (value.empty() || '"' != value[0]) {
+    return trim(value.substr(0, value.find('#')));
+  }
+  std::string unquoted;
+  for (size_t i = 1; i < value.size(); ++i) {
+    char c = value[i];
+    if ('"' == c) {
+      std::string rest = trim(value.substr(i + 1));
+      if (!rest.empty() && '#' != rest[0]) {
+        throw std::runtime_error("unexpected text after the closing quote: " + rest);
+      }
+      return unquoted;
+    }
+    if ('\\' == c && i + 1 < value.size() && ('"' == value[i + 1] || '\\' == value[i + 1])) {
+      c = value[++i];
+    }
+    unquoted.push_back(c);
+  }
+  throw std::runtime_error("missing closing quote: " + value);
+}
+
+// The CPUs a cpu_set_t has room for on Linux.
+constexpr unsigned kMaxCpus = 1024;
+
+// Parse "<cpu>, <first cpu>-<last cpu>, ...".
+std::vector<unsigned>
+parse_cpus(const std::string & value)
+{
+  std::vector<unsigned> cpus;
+  // Empty for any, so that a config file can turn off those of the environment.
+  if (trim(value).empty()) {
+    return cpus;
+  }
+  size_t begin = 0;
+  while (begin <= value.size()) {
+    size_t end = std::min(value.find(',', begin), value.size());
+    std::string range = trim(value.substr(begin, end - begin));
+    begin = end + 1;
+    size_t separator = range.find('-');
+    size_t first = parse_size(trim(range.substr(0, separator)), true);
+    size_t last = std::string::npos == separator ?
+      first : parse_size(trim(range.substr(separator + 1)), true);
+    if (last < first || last >= kMaxCpus) {
+      throw std::runtime_error("unrecognized CPUs: " + range);
+    }
+    for (size_t cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(static_cast<unsigned>(cpu));
+    }
+  }
+  return cpus;
+}
+
+int
+parse_nice(const std::string & value)
+{
+  bool negative = !value.empty() && '-' == value[0];
+  size_t magnitude = parse_size(negative ? value.substr(1) : value, true);
+  if (magnitude > (negative ? 20u : 19u)) {
+    throw std::runtime_error("unrecognized value: " + value);
+  }
+  return negative ? -static_cast<int>(magnitude) : static_cast<int>(magnitude);
+}
+
+// Parse "<level>:<type>:<target>, ...".
+std::vector<ExtraSinkSettings>
+parse_extra_sinks(const std::string & value)
+{
+  std::vector<ExtraSinkSettings> sinks;
+  // Empty for none, so that a config file can turn off those of the environment.
+  if (trim(value).empty()) {
+    return sinks;
+  }
+  size_t begin = 0;
+  while (begin <= value.size()) {
+    size_t end = std::min(value.find(',', begin), value.size());
+    std::string spec = trim(value.substr(begin, end - begin));
+    begin = end + 1;
+    size_t level_end = spec.find(':');
+    size_t type_end = std::string::npos == level_end ? level_end : spec.find(':', level_end + 1);
+    if (std::string::npos == type_end) {
+      throw std::runtime_error("expected '<level>:<type>:<target>', got '" + spec + "'");
+    }
+    ExtraSinkSettings sink;
+    sink.level = parse_level(spec.substr(0, level_end));
+    sink.type = parse_choice<ExtraSinkType>(
+      spec.substr(level_end + 1, type_end - level_end - 1), {
+        {"file", ExtraSinkType::file},
+        {"udp", ExtraSinkType::udp},
+        {"unix", ExtraSinkType::unix_socket},
+      });
+    sink.target = spec.substr(type_end + 1);
+    // A file name which starts with a digit could be taken for a segment of
+    // the main log.
+    if (sink.target.empty() ||
+      (ExtraSinkType::file == sink.type &&
+      (!std::isalpha(static_cast<unsigned char>(sink.target[0])) ||
+      std::string::npos != sink.target.find_first_not_of(
+        "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_-"))))
+    {
+      throw std::runtime_error("unrecognized target: " + sink.target);
+    }
+    sinks.push_back(sink);
+  }
+  return sinks;
+}
+
+struct Option
+{
+  const char * key;
+  void (* apply)(Settings & settings, const std::string & value);
+};
+
+const Option kOptions[] = {
+  {"format", [](Settings & settings, const std::string & value) {
+      settings.format = parse_choice<LogFileFormat>(
+        value, {{"text", LogFileFormat::text}, {"binary", LogFileFormat::binary}});
+    }},
+  {"line_format", [](Settings & settings, const std::string & value) {
+      settings.line_format = value;
+    }},
+  {"file_writer", [](Settings & settings, const std::string & value) {
+      settings.file_writer = parse_choice<FileWriterType>(
+        value, {{"stdio", FileWriterType::stdio}, {"mmap", FileWriterType::mmap},
+          {"io_uring", FileWriterType::io_uring}});
+    }},
+  {"mmap_segment_size", [](Settings & settings, const std::string & value) {
+      settings.mmap_segment_size = parse_size(value, false);
+    }},
+  {"buffer_size", [](Settings & settings, const std::string & value) {
+      settings.buffer_size = parse_size(value, true);
+    }},
+  {"io_uring_buffers", [](Settings & settings, const std::string & value) {
+      settings.io_uring_buffers = parse_size(value, false);
+    }},
+  {"lazy_log_file", [](Settings & settings, const std::string & value) {
+      settings.lazy_log_file = parse_bool(value);
+    }},
+  {"lazy_log_directory", [](Settings & settings, const std::string & value) {
+      settings.lazy_log_directory = parse_bool(value);
+    }},
+  {"rotate_size", [](Settings & settings, const std::string & value) {
+      settings.rotate_size = parse_size(value, true);
+    }},
+  {"rotate_interval", [](Settings & settings, const std::string & value) {
+      settings.rotate_interval = parse_seconds(value);
+    }},
+  {"max_files", [](Settings & settings, const std::string & value) {
+      settings.max_files = parse_size(value, true);
+    }},
+  {"compress", [](Settings & settings, const std::string & value) {
+      settings.compress = parse_bool(value);
+    }},
+  {"extra_sinks", [](Settings & settings, const std::string & value) {
+      settings.extra_sinks = parse_extra_sinks(value);
+    }},
+  {"extra_sink_queue_size", [](Settings & settings, const std::string & value) {
+      settings.extra_sink_queue_size = parse_size_at_most(
+        value, AsyncWriter::kMaxQueueSize);
+    }},
+  {"async", [](Settings & settings, const std::string & value) {
+      settings.async = parse_bool(value);
+    }},
+  {"async_queue_size", [](Settings & settings, const std::string & value) {
+      settings.async_queue_size = parse_size_at_most(value, AsyncWriter::kMaxQueueSize);
+    }},
+  {"async_thread_count", [](Settings &, const std::string & value) {
+      // Only one writer thread is supported, more would write messages and
+      // flushes out of order, see Settings::async.
+      if (1 != parse_size(value, false)) {
+        throw std::runtime_error("only 1 is supported: " + value);
+      }
+    }},
+  {"async_overflow_policy", [](Settings & settings, const std::string & value) {
+      settings.async_overflow_policy = parse_choice<OverflowPolicy>(
+        value, {
+          {"block", OverflowPolicy::block},
+          {"discard_new", OverflowPolicy::discard_new},
+          {"overrun_oldest", OverflowPolicy::overrun_oldest},
+          {"shed_by_severity", OverflowPolicy::shed_by_severity},
+        });
+    }},
+  {"async_keep_level", [](Settings & settings, const std::string & value) {
+      settings.async_keep_level = parse_level(value);
+    }},
+  {"async_record_size", [](Settings & settings, const std::string & value) {
+      settings.async_record_size = parse_size_at_most(value, AsyncWriter::kMaxRecordSize);
+    }},
+  {"flush_interval", [](Settings & settings, const std::string & value) {
+      settings.flush_interval = parse_seconds(value);
+    }},
+  {"flush_adaptive", [](Settings & settings, const std::string & value) {
+      settings.flush_adaptive = parse_bool(value);
+    }},
+  {"flush_min_interval_ms", [](Settings & settings, const std::string & value) {
+      settings.flush_min_interval = parse_milliseconds(value);
+    }},
+  {"flush_bytes", [](Settings & settings, const std::string & value) {
+      settings.flush_bytes = parse_size(value, true);
+    }},
+  {"flush_records", [](Settings & settings, const std::string & value) {
+      settings.flush_records = parse_size(value, true);
+    }},
+  {"flush_level", [](Settings & settings, const std::string & value) {
+      settings.flush_level = parse_level(value);
+    }},
+  {"sync_level", [](Settings & settings, const std::string & value) {
+      settings.sync_level = parse_level(value);
+    }},
+  {"latency_histograms", [](Settings & settings, const std::string & value) {
+      settings.latency_histograms = parse_bool(value);
+    }},
+  {"latency_report_interval", [](Settings & settings, const std::string & value) {
+      settings.latency_report_interval = parse_seconds(value);
+    }},
+  {"rate_limit", [](Settings & settings, const std::string & value) {
+      settings.rate_limit = parse_size(value, true);
+    }},
+  {"rate_limit_burst", [](Settings & settings, const std::string & value) {
+      settings.rate_limit_burst = parse_size(value, true);
+    }},
+  {"suppress_duplicates", [](Settings & settings, const std::string & value) {
+      settings.suppress_duplicates = parse_bool(value);
+    }},
+  {"duplicate_report_interval", [](Settings & settings, const std::string & value) {
+      settings.duplicate_report_interval = parse_seconds(value);
+    }},
+  {"thread_cpus", [](Settings & settings, const std::string & value) {
+      settings.thread_cpus = parse_cpus(value);
+    }},
+  {"thread_scheduling_policy", [](Settings & settings, const std::string & value) {
+      settings.thread_scheduling_policy = parse_choice<SchedulingPolicy>(
+        value, {
+          {"other", SchedulingPolicy::other},
+          {"batch", SchedulingPolicy::batch},
+          {"idle", SchedulingPolicy::idle},
+        });
+    }},
+  {"thread_nice", [](Settings & settings, const std::string & value) {
+      settings.thread_nice = parse_nice(value);
+    }},
+  {"flight_recorder_size", [](Settings & settings, const std::string & value) {
+      settings.flight_recorder_size = parse_size(value, true);
+    }},
+  {"flight_recorder_level", [](Settings & settings, const std::string & value) {
+      settings.flight_recorder_level = parse_level(value);
+    }},
+  {"flight_recorder_dump_level", [](Settings & settings, const std::string & value) {
+      settings.flight_recorder_dump_level = parse_level(value);
+    }},
+  {"flight_recorder_signal", [](Settings & settings, const std::string & value) {
+      settings.flight_recorder_signal = parse_choice<int>(
+        value, {
+          {"none", 0},
+#ifndef _WIN32
+          {"SIGUSR1", SIGUSR1},
+          {"SIGUSR2", SIGUSR2},
+#endif
+        });
+    }},
+};
+
+std::string
+env_var_name(const char * key)
+{
+  std::string name = "RCL_LOGGING_SPDLOG_";
+  for (const char * c = key; *c != '\0'; ++c) {
+    name += static_cast<char>(std::toupper(static_cast<unsigned char>(*c)));
+  }
+  return name;
+}
+
+}  // namespace
+
+RotationSettings
+Settings::rotation() const
+{
+  RotationSettings settings;
+  settings.max_size = rotate_size;
+  // Memory-mapped logs have always been split into segments.
+  if (0 == settings.max_size && FileWriterType::mmap == file_writer) {
+    settings.max_size = mmap_segment_size;
+  }
+  settings.interval = rotate_interval;
+  settings.max_files = max_files;
+  settings.compress = compress;
+  settings.archiver_thread = threads();
+  return settings;
+}
+
+FlushSettings
+Settings::flush() const
+{
+  FlushSettings settings;
+  settings.max_unflushed_bytes = flush_bytes;
+  settings.max_unflushed_records = flush_records;
+  settings.flush_level = flush_level;
+  settings.sync_level = sync_level;
+  settings.record_latency = latency_histograms || latency_report_interval.count() > 0;
+  return settings;
+}
+
+AsyncWriterSettings
+Settings::async_writer() const
+{
+  AsyncWriterSettings settings;
+  settings.queue_size = async_queue_size;
+  settings.record_size = async_record_size;
+  settings.overflow_policy = async_overflow_policy;
+  settings.keep_level = async_keep_level;
+  settings.threads = threads();
+  return settings;
+}
+
+MessageFilterSettings
+Settings::message_filter() const
+{
+  MessageFilterSettings settings;
+  settings.rate_limit = rate_limit;
+  settings.rate_limit_burst = rate_limit_burst;
+  settings.suppress_duplicates = suppress_duplicates;
+  settings.duplicate_report_interval = duplicate_report_interval;
+  return settings;
+}
+
+ThreadSettings
+Settings::threads() const
+{
+  ThreadSettings settings;
+  settings.cpus = thread_cpus;
+  settings.policy = thread_scheduling_policy;
+  settings.nice = thread_nice;
+  return settings;
+}
+
+void
+load_settings_from_env(Settings & settings)
+{
+  // Older, predating the other settings: 1 turns off all flushing.
+  const char * old_flushing_env_var_name = "RCL_LOGGING_SPDLOG_EXPERIMENTAL_OLD_FLUSHING_BEHAVIOR";
+  try {
+    std::string value = rcpputils::get_env_var(old_flushing_env_var_name);
+    if (!value.empty() && parse_bool(value)) {
+      settings.flush_interval = std::chrono::seconds(0);
+      settings.flush_level = spdlog::level::off;
+    }
+  } catch (const std::runtime_error & error) {
+    throw std::runtime_error(
+            std::string("failed to get env var '") + old_flushing_env_var_name + "': " +
+            error.what());
+  }
+
+  const char * console_format_env_var_name = "RCUTILS_CONSOLE_OUTPUT_FORMAT";
+  try {
+    std::string value = rcpputils::get_env_var(console_format_env_var_name);
+    if (!value.empty()) {
+      settings.line_format = value;
+    }
+  } catch (const std::runtime_error & error) {
+    throw std::runtime_error(
+            std::string("failed to get env var '") + console_format_env_var_name + "': " +
+            error.what());
+  }
+
+  for (const Option & option : kOptions) {
+    std::string name = env_var_name(option.key);
+    try {
+      std::string value = rcpputils::get_env_var(name.c_str());
+      if (!value.empty()) {
+        option.apply(settings, value);
+      }
+    } catch (const std::runtime_error & error) {
+      throw std::runtime_error("failed to get env var '" + name + "': " + error.what());
+    }
+  }
+}
+
+void
+load_settings_from_config_file(Settings & settings, const std::string & filename)
+{
+  std::ifstream file(filename);
+  if (!file) {
+    throw ConfigFileNotFoundError("failed to open config file '" + filename + "'");
+  }
+
+  std::string line;
+  for (size_t line_number = 1; std::getline(file, line); ++line_number) {
+    std::string location = "config file '" + filename + "' line " + std::to_string(line_number);
+    line = trim(line);
+    if (line.empty() || '#' == line[0]) {
+      continue;
+    }
+    size_t separator = line.find('=');
+    if (std::string::npos == separator) {
+      throw InvalidConfigFileError(location + ": expected '<key> = <value>'");
+    }
+    std::string key = trim(line.substr(0, separator));
+
+    const Option * found = nullptr;
+    for (const Option & option : kOptions) {
+      if (key == option.key) {
+        found = &option;
+        break;
+      }
+    }
+    if (nullptr == found) {
+      throw InvalidConfigFileError(location + ": unknown key '" + key + "'");
+    }
+    try {
+      found->apply(settings, parse_config_value(line.substr(separator + 1)));
+    } catch (const std::runtime_error & error) {
+      throw InvalidConfigFileError(location + ": bad value for '" + key + "': " + error.what());
+    }
+  }
+  if (file.bad()) {
+    throw InvalidConfigFileError("failed to read config file '" + filename + "'");
+  }
+}
+
+}  // namespace rcl_logging_spdlog
@@ -0,0 +1,280 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_LOGGING_SPDLOG__SETTINGS_HPP_
+#define RCL_LOGGING_SPDLOG__SETTINGS_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "spdlog/common.h"
+
+#include "rcl_logging_interface/visibility_control.h"
+
+#include "rcl_logging_spdlog/async_writer.hpp"
+#include "rcl_logging_spdlog/flush_policy.hpp"
+#include "rcl_logging_spdlog/message_filter.hpp"
+#include "rcl_logging_spdlog/rotating_file_writer.hpp"
+#include "rcl_logging_spdlog/thread_settings.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+/// The format in which messages are written to the log file.
+enum class LogFileFormat
+{
+  /// One line of text per message.
+  text,
+  /// Records in the binary log format, see binary_log_format.hpp.
+  binary,
+};
+
+/// How the bytes of the log file get to the file system.
+enum class FileWriterType
+{
+  /// Buffered stdio writes.
+  stdio,
+  /// Memory-mapped, preallocated windows, see MappedFileWriter.
+  mmap,
+  /// Batched writes through io_uring, see UringFileWriter.
+  /**
+   * Falls back to stdio where io_uring is not available.
+   */
+  io_uring,
+};
+
+/// Where an extra sink writes messages to.
+enum class ExtraSinkType
+{
+  /// A log file of its own, next to the main one.
+  file,
+  /// Datagrams over UDP, see DatagramSink.
+  udp,
+  /// Datagrams over a Unix domain socket, see DatagramSink.
+  unix_socket,
+};
+
+/// A sink written to along with the log file, see Settings::extra_sinks.
+struct RCL_LOGGING_INTERFACE_LOCAL ExtraSinkSettings
+{
+  /// The lowest level of messages written to the sink.
+  spdlog::level::level_enum level;
+  ExtraSinkType type;
+  /// For a file the name it gets in place of the main log's extension, like
+  /// "<name>.<target>.log", for udp "<host>:<port>", for a Unix domain socket
+  /// its path.
+  std::string target;
+};
+
+/// Everything about the backend which can be tuned without rebuilding.
+/**
+ * Each setting can be given in a config file as "<key> = <value>", or through
+ * the environment variable RCL_LOGGING_SPDLOG_<KEY>, with the key upper cased.
+ * The config file takes precedence over the environment.
+ */
+struct RCL_LOGGING_INTERFACE_LOCAL Settings
+{
+  /// format: text or binary.
+  LogFileFormat format = LogFileFormat::text;
+  /// line_format: how text logs format structured messages, with rcutils' tokens.
+  /**
+   * Defaults to RCUTILS_CONSOLE_OUTPUT_FORMAT, or rcutils' own default if that
+   * isn't set, so that they look like the messages formatted by rcutils.
+   */
+  std::string line_format = "[{severity}] [{time}] [{name}]: {message}";
+  /// file_writer: stdio, mmap or io_uring.
+  FileWriterType file_writer = FileWriterType::stdio;
+  /// mmap_segment_size: the size of each window mapped by the mmap writer.
+  size_t mmap_segment_size = 16 * 1024 * 1024;
+  /// buffer_size: the size of the stdio buffer, 0 for the C library default.
+  /**
+   * For the io_uring writer this is the size of each registered buffer, with 0
+   * meaning 64 KiB.
+   */
+  size_t buffer_size = 0;
+  /// io_uring_buffers: the number of buffers the io_uring writer can have in flight.
+  size_t io_uring_buffers = 4;
+  /// lazy_log_file: create the log file for the first message written to it,
+  /// rather than at initialization, 0 or 1.
+  bool lazy_log_file = true;
+  /// lazy_log_directory: create the log directory along with a lazy log file,
+  /// rather than at initialization, 0 or 1.
+  bool lazy_log_directory = false;
+
+  /// rotate_size: the maximum size of each log file segment, 0 for unlimited.
+  /**
+   * With the mmap writer this defaults to mmap_segment_size.
+   */
+  size_t rotate_size = 0;
+  /// rotate_interval: the maximum age in seconds of each segment, 0 for unlimited.
+  std::chrono::seconds rotate_interval{0};
+  /// max_files: the number of segments to keep, 0 for all.
+  size_t max_files = 0;
+  /// compress: gzip closed segments, 0 or 1.
+  bool compress = false;
+
+  /// extra_sinks: comma separated "<level>:<type>:<target>", sinks written to
+  /// along with the log file, each from a thread of its own.
+  /**
+   * type is file, udp or unix, see ExtraSinkSettings.
+   */
+  std::vector<ExtraSinkSettings> extra_sinks;
+  /// extra_sink_queue_size: the maximum number of messages waiting for each extra sink.
+  size_t extra_sink_queue_size = 8192;
+
+  /// async: write the log file from a background thread, 0 or 1.
+  /**
+   * There is a single writer thread: async_thread_count is only accepted as 1,
+   * since with more, messages and flushes would reach the file out of order.
+   */
+  bool async = false;
+  /// async_queue_size: the maximum number of messages waiting to be written.
+  size_t async_queue_size = 8192;
+  /// async_overflow_policy: block, discard_new, overrun_oldest or
+  /// shed_by_severity, what to do when the queue is full.
+  OverflowPolicy async_overflow_policy = OverflowPolicy::block;
+  /// async_keep_level: the lowest level shed_by_severity keeps.
+  spdlog::level::level_enum async_keep_level = spdlog::level::err;
+  /// async_record_size: the bytes of name and message which a message in the
+  /// queue can take, longer ones are truncated.
+  size_t async_record_size = 512;
+
+  /// flush_interval: flush the log file every this many seconds, 0 for never.
+  std::chrono::seconds flush_interval{5};
+  /// flush_adaptive: flush sooner when idle and later when busy, 0 or 1.
+  /**
+   * Flushes are then between flush_min_interval_ms and flush_interval apart,
+   * see Flusher.
+   */
+  bool flush_adaptive = false;
+  /// flush_min_interval_ms: the shortest time between adaptive flushes.
+  std::chrono::milliseconds flush_min_interval{100};
+  /// flush_bytes: flush once this many bytes were written, 0 for never.
+  size_t flush_bytes = 0;
+  /// flush_records: flush once this many messages were written, 0 for never.
+  size_t flush_records = 0;
+  /// flush_level: flush after each message of at least debug, info, warn, error or fatal.
+  /**
+   * none disables flushing by severity.
+   */
+  spdlog::level::level_enum flush_level = spdlog::level::err;
+  /// sync_level: like flush_level, but also wait for the data to reach the disk.
+  spdlog::level::level_enum sync_level = spdlog::level::off;
+
+  /// latency_histograms: measure how long messages take to be written and flushed, 0 or 1.
+  bool latency_histograms = false;
+  /// latency_report_interval: log a summary of the latency histograms every
+  /// this many seconds, 0 for never.
+  /**
+   * Any other value implies latency_histograms.
+   */
+  std::chrono::seconds latency_report_interval{0};
+
+  /// flight_recorder_size: the number of messages kept in memory, 0 to disable.
+  /**
+   * Messages not written to the log file are kept instead, and written out
+   * when one of flight_recorder_dump_level arrives, see FlightRecorder.
+   */
+  size_t flight_recorder_size = 0;
+  /// flight_recorder_level: the lowest level of messages kept in memory.
+  spdlog::level::level_enum flight_recorder_level = spdlog::level::debug;
+  /// flight_recorder_dump_level: write out the kept messages before each one of
+  /// at least this level.
+  spdlog::level::level_enum flight_recorder_dump_level = spdlog::level::err;
+  /// flight_recorder_signal: none, SIGUSR1 or SIGUSR2, write out the kept
+  /// messages when the process gets this signal.
+  int flight_recorder_signal = 0;
+
+  /// rate_limit: the messages per second logged for each logger and level, 0 for unlimited.
+  size_t rate_limit = 0;
+  /// rate_limit_burst: the messages logged at once after a quiet period, 0 for rate_limit.
+  size_t rate_limit_burst = 0;
+  /// suppress_duplicates: drop messages identical to the previous one, 0 or 1.
+  bool suppress_duplicates = false;
+  /// duplicate_report_interval: report a run of duplicates every this many
+  /// seconds while it lasts, 0 for only once it ends.
+  std::chrono::seconds duplicate_report_interval{10};
+
+  /// thread_cpus: comma separated CPUs and ranges like "2-3" which the
+  /// background threads may run on, empty for any.
+  std::vector<unsigned> thread_cpus;
+  /// thread_scheduling_policy: other, batch or idle, the scheduling policy of
+  /// the background threads.
+  SchedulingPolicy thread_scheduling_policy = SchedulingPolicy::inherit;
+  /// thread_nice: the nice value of the background threads, from -20 to 19.
+  std::optional<int> thread_nice;
+
+  /// Get the rotation settings for the file writer.
+  RotationSettings
+  rotation() const;
+
+  /// Get the settings for the flush policy of the sink.
+  FlushSettings
+  flush() const;
+
+  /// Get the settings for the background threads writing the log file.
+  AsyncWriterSettings
+  async_writer() const;
+
+  /// Get the settings for the message filter, see MessageFilter.
+  MessageFilterSettings
+  message_filter() const;
+
+  /// Get where and how the background threads run.
+  ThreadSettings
+  threads() const;
+};
+
+/// Thrown when a config file can't be opened.
+class RCL_LOGGING_INTERFACE_LOCAL ConfigFileNotFoundError : public std::runtime_error
+{
+public:
+  using std::runtime_error::runtime_error;
+};
+
+/// Thrown when a config file can't be parsed, or has a bad setting.
+class RCL_LOGGING_INTERFACE_LOCAL InvalidConfigFileError : public std::runtime_error
+{
+public:
+  using std::runtime_error::runtime_error;
+};
+
+/// Update settings from the RCL_LOGGING_SPDLOG_* environment variables.
+/**
+ * \throws std::runtime_error if a variable can't be read or has a bad value.
+ */
+RCL_LOGGING_INTERFACE_LOCAL
+void
+load_settings_from_env(Settings & settings);
+
+/// Update settings from a config file.
+/**
+ * The file has one "<key> = <value>" pair per line.
+ * Blank lines and everything after a '#' are ignored.
+ *
+ * \throws ConfigFileNotFoundError if the file can't be opened.
+ * \throws InvalidConfigFileError if it has a syntax error, an unknown key or a
+ *   bad value.
+ */
+RCL_LOGGING_INTERFACE_LOCAL
+void
+load_settings_from_config_file(Settings & settings, const std::string & filename);
+
+}  // namespace rcl_logging_spdlog
+
+#endif  // RCL_LOGGING_SPDLOG__SETTINGS_HPP_
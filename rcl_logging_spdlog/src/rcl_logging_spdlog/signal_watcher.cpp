@@ -0,0 +1,145 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <functional>
+#include <system_error>
+#include <utility>
+
+#include "rcl_logging_spdlog/signal_watcher.hpp"
+#include "rcl_logging_spdlog/thread_settings.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+namespace
+{
+
+#ifndef _WIN32
+// The pipe the handler wakes the thread up through, there is only one watcher.
+int g_pipe[2] = {-1, -1};
+
+constexpr char kSignalled = 's';
+constexpr char kStop = 'q';
+
+void
+handle_signal(int)
+{
+  // write() is async-signal-safe.  If the pipe is full, the thread has
+  // plenty of wake ups pending already.
+  int saved_errno = errno;
+  char byte = kSignalled;
+  (void)!::write(g_pipe[1], &byte, 1);
+  errno = saved_errno;
+}
+
+void
+close_pipe()
+{
+  ::close(g_pipe[0]);
+  ::close(g_pipe[1]);
+  g_pipe[0] = -1;
+  g_pipe[1] = -1;
+}
+#endif
+
+}  // namespace
+
+SignalWatcher::SignalWatcher(
+  int signal_number, std::function<void()> callback, const ThreadSettings & thread_settings)
+: signal_number_(signal_number),
+  callback_(std::move(callback))
+{
+#ifdef _WIN32
+  (void)thread_settings;
+  throw std::system_error(
+          std::make_error_code(std::errc::function_not_supported),
+          "Watching for signals is not supported on this platform");
+#else
+  if (0 != ::pipe(g_pipe)) {
+    throw std::system_error(errno, std::generic_category(), "Failed creating a pipe");
+  }
+  for (int fd : g_pipe) {
+    ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+  }
+  // The handler must never block.
+  ::fcntl(g_pipe[1], F_SETFL, ::fcntl(g_pipe[1], F_GETFL) | O_NONBLOCK);
+
+  try {
+    thread_ = std::thread(&SignalWatcher::run, this, thread_settings);
+  } catch (const std::system_error &) {
+    close_pipe();
+    throw;
+  }
+
+  struct sigaction action = {};
+  action.sa_handler = handle_signal;
+  sigemptyset(&action.sa_mask);
+  action.sa_flags = SA_RESTART;
+  if (0 != ::sigaction(signal_number_, &action, &previous_action_)) {
+    int error = errno;
+    char byte = kStop;
+    (void)!::write(g_pipe[1], &byte, 1);
+    thread_.join();
+    close_pipe();
+    throw std::system_error(error, std::generic_category(), "Failed installing a signal handler");
+  }
+#endif
+}
+
+SignalWatcher::~SignalWatcher()
+{
+#ifndef _WIN32
+  ::sigaction(signal_number_, &previous_action_, nullptr);
+  // Blocking, so that the stop request can't be lost to a full pipe.
+  ::fcntl(g_pipe[1], F_SETFL, ::fcntl(g_pipe[1], F_GETFL) & ~O_NONBLOCK);
+  char byte = kStop;
+  while (::write(g_pipe[1], &byte, 1) < 0 && EINTR == errno) {
+  }
+  thread_.join();
+  close_pipe();
+#endif
+}
+
+void
+SignalWatcher::run(const ThreadSettings & thread_settings)
+{
+  apply_thread_settings(thread_settings);
+#ifndef _WIN32
+  char bytes[64];
+  while (true) {
+    ssize_t count = ::read(g_pipe[0], bytes, sizeof(bytes));
+    if (count < 0 && EINTR == errno) {
+      continue;
+    }
+    if (count <= 0) {
+      return;
+    }
+    for (ssize_t i = 0; i < count; ++i) {
+      if (kStop == bytes[i]) {
+        return;
+      }
+    }
+    callback_();
+  }
+#endif
+}
+
+}  // namespace rcl_logging_spdlog
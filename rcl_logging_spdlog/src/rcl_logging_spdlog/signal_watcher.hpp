@@ -0,0 +1,73 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_LOGGING_SPDLOG__SIGNAL_WATCHER_HPP_
+#define RCL_LOGGING_SPDLOG__SIGNAL_WATCHER_HPP_
+
+#ifndef _WIN32
+#include <signal.h>
+#endif
+
+#include <functional>
+#include <thread>
+
+#include "rcl_logging_interface/visibility_control.h"
+
+#include "rcl_logging_spdlog/thread_settings.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+/// Calls back from a background thread whenever the process gets a signal.
+/**
+ * The signal handler only wakes the thread up, so the callback is free to
+ * take locks and write files, which a signal handler can't do safely.
+ * Signals arriving while the callback runs are coalesced into one more call.
+ *
+ * Only one instance may exist at a time.
+ * The previous handler of the signal is restored on destruction.
+ * This is only available on POSIX systems.
+ */
+class RCL_LOGGING_INTERFACE_LOCAL SignalWatcher final
+{
+public:
+  /// Install the signal handler and start the background thread.
+  /**
+   * \param thread_settings where and how the thread runs.
+   * \throws std::system_error if the handler or the thread can't be set up.
+   */
+  SignalWatcher(
+    int signal_number, std::function<void()> callback, const ThreadSettings & thread_settings);
+
+  /// Stop the background thread and restore the previous signal handler.
+  ~SignalWatcher();
+
+  SignalWatcher(const SignalWatcher &) = delete;
+  SignalWatcher & operator=(const SignalWatcher &) = delete;
+
+private:
+  void
+  run(const ThreadSettings & thread_settings);
+
+  int signal_number_;
+  std::function<void()> callback_;
+#ifndef _WIN32
+  struct sigaction previous_action_;
+#endif
+  std::thread thread_;
+};
+
+}  // namespace rcl_logging_spdlog
+
+#endif  // RCL_LOGGING_SPDLOG__SIGNAL_WATCHER_HPP_
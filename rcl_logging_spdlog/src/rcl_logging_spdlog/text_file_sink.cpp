@@ -0,0 +1,90 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "spdlog/details/log_msg.h"
+#include "spdlog/details/os.h"
+#include "spdlog/pattern_formatter.h"
+
+#include "rcl_logging_spdlog/text_file_sink.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+TextFileSink::TextFileSink(
+  std::unique_ptr<FileWriter> writer, const FlushSettings & flush_settings)
+: FileSink(flush_settings),
+  writer_(std::move(writer)),
+  message_only_(false)
+{
+}
+
+void
+TextFileSink::sink_it_(const spdlog::details::log_msg & msg)
+{
+  if (message_only_) {
+    static const size_t eol_size = std::strlen(spdlog::details::os::default_eol);
+    size_t size = msg.payload.size() + eol_size;
+    writer_->rotate_if_needed(size);
+    writer_->write(msg.payload.data(), msg.payload.size());
+    writer_->write(spdlog::details::os::default_eol, eol_size);
+    flush_policy().record_written(*writer_, msg, size);
+    return;
+  }
+  buffer_.clear();
+  formatter_->format(msg, buffer_);
+  writer_->rotate_if_needed(buffer_.size());
+  writer_->write(buffer_.data(), buffer_.size());
+  flush_policy().record_written(*writer_, msg, buffer_.size());
+}
+
+void
+TextFileSink::log_batch(const spdlog::details::log_msg * msgs, size_t count)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (size_t i = 0; i < count; ++i) {
+    if (should_log(msgs[i].level)) {
+      sink_it_(msgs[i]);
+    }
+  }
+}
+
+void
+TextFileSink::flush_()
+{
+  flush_policy().flush(*writer_);
+}
+
+void
+TextFileSink::set_pattern_(const std::string & pattern)
+{
+  set_formatter_(std::make_unique<spdlog::pattern_formatter>(pattern));
+  message_only_ = "%v" == pattern;
+}
+
+void
+TextFileSink::set_formatter_(std::unique_ptr<spdlog::formatter> sink_formatter)
+{
+  formatter_ = std::move(sink_formatter);
+  message_only_ = false;
+}
+
+}  // namespace rcl_logging_spdlog
@@ -0,0 +1,73 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_LOGGING_SPDLOG__TEXT_FILE_SINK_HPP_
+#define RCL_LOGGING_SPDLOG__TEXT_FILE_SINK_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "spdlog/details/log_msg.h"
+
+#include "rcl_logging_interface/visibility_control.h"
+
+#include "rcl_logging_spdlog/file_sink.hpp"
+#include "rcl_logging_spdlog/file_writer.hpp"
+#include "rcl_logging_spdlog/flush_policy.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+/// An spdlog sink which writes formatted messages through a FileWriter.
+/**
+ * This is spdlog::sinks::basic_file_sink, but for any of the writers of this
+ * package, and flushing according to a FlushPolicy.
+ *
+ * With the plain "%v" pattern the message is written as it is, followed by a
+ * newline, without first being copied into a format buffer.
+ */
+class RCL_LOGGING_INTERFACE_LOCAL TextFileSink final : public FileSink
+{
+public:
+  TextFileSink(std::unique_ptr<FileWriter> writer, const FlushSettings & flush_settings);
+
+  void
+  log_batch(const spdlog::details::log_msg * msgs, size_t count) override;
+
+protected:
+  void
+  sink_it_(const spdlog::details::log_msg & msg) override;
+
+  void
+  flush_() override;
+
+  void
+  set_pattern_(const std::string & pattern) override;
+
+  void
+  set_formatter_(std::unique_ptr<spdlog::formatter> sink_formatter) override;
+
+private:
+  std::unique_ptr<FileWriter> writer_;
+  bool message_only_;
+  // Reused for every message so that steady state logging doesn't allocate.
+  spdlog::memory_buf_t buffer_;
+};
+
+}  // namespace rcl_logging_spdlog
+
+#endif  // RCL_LOGGING_SPDLOG__TEXT_FILE_SINK_HPP_
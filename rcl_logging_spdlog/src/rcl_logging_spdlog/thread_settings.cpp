@@ -0,0 +1,60 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "rcl_logging_spdlog/thread_settings.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+void
+apply_thread_settings(const ThreadSettings & settings)
+{
+#ifdef __linux__
+  if (!settings.cpus.empty()) {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (unsigned cpu : settings.cpus) {
+      CPU_SET(cpu, &cpus);
+    }
+    (void)pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+  }
+  if (SchedulingPolicy::inherit != settings.policy) {
+    int policy = SCHED_OTHER;
+    if (SchedulingPolicy::batch == settings.policy) {
+      policy = SCHED_BATCH;
+    } else if (SchedulingPolicy::idle == settings.policy) {
+      policy = SCHED_IDLE;
+    }
+    // None of these policies has a static priority.
+    struct sched_param param = {};
+    (void)pthread_setschedparam(pthread_self(), policy, &param);
+  }
+  if (settings.nice) {
+    // On Linux the nice value is per thread, so this leaves the loggers alone.
+    (void)setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), *settings.nice);
+  }
+#else
+  (void)settings;
+#endif
+}
+
+}  // namespace rcl_logging_spdlog
@@ -0,0 +1,66 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_LOGGING_SPDLOG__THREAD_SETTINGS_HPP_
+#define RCL_LOGGING_SPDLOG__THREAD_SETTINGS_HPP_
+
+#include <optional>
+#include <vector>
+
+#include "rcl_logging_interface/visibility_control.h"
+
+namespace rcl_logging_spdlog
+{
+
+/// The scheduling policies background threads can be given, see ThreadSettings.
+enum class SchedulingPolicy
+{
+  /// Keep the policy of the thread creating them.
+  inherit,
+  /// SCHED_OTHER, the default time sharing.
+  other,
+  /// SCHED_BATCH, time sharing for threads which don't need to be responsive.
+  batch,
+  /// SCHED_IDLE, only run when nothing else wants the CPU.
+  idle,
+};
+
+/// Where and how the background threads of the backend run.
+/**
+ * This keeps the threads flushing, writing and archiving the log off the CPUs
+ * set aside for real-time work, and out of its way on the others.
+ */
+struct ThreadSettings
+{
+  /// The CPUs the threads may run on, empty for those of the creating thread.
+  std::vector<unsigned> cpus;
+  SchedulingPolicy policy = SchedulingPolicy::inherit;
+  /// The nice value, from -20 to 19, none to keep that of the creating thread.
+  std::optional<int> nice;
+};
+
+/// Apply settings to the calling thread.
+/**
+ * This is best effort: settings the process isn't allowed to apply, like a
+ * negative nice value without CAP_SYS_NICE, are left out.
+ * Only Linux has per thread nice values and these policies, elsewhere this
+ * does nothing.
+ */
+RCL_LOGGING_INTERFACE_LOCAL
+void
+apply_thread_settings(const ThreadSettings & settings);
+
+}  // namespace rcl_logging_spdlog
+
+#endif  // RCL_LOGGING_SPDLOG__THREAD_SETTINGS_HPP_
@@ -0,0 +1,87 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "rcutils/allocator.h"
+
+#include "spdlog/details/log_msg.h"
+#include "spdlog/formatter.h"
+#include "spdlog/sinks/sink.h"
+
+#include "rcl_logging_spdlog/async_writer.hpp"
+#include "rcl_logging_spdlog/threaded_sink.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+namespace
+{
+
+AsyncWriterSettings
+writer_settings(AsyncWriterSettings settings)
+{
+  settings.overflow_policy = OverflowPolicy::overrun_oldest;
+  return settings;
+}
+
+}  // namespace
+
+ThreadedSink::ThreadedSink(
+  spdlog::sink_ptr target, const AsyncWriterSettings & settings,
+  rcutils_allocator_t allocator)
+: sink_(target),
+  writer_(
+    {std::move(target)}, writer_settings(settings), allocator, [](const std::string & msg) {
+      // There is no logger to hand it to, so like spdlog does by default.
+      std::fprintf(stderr, "[*** LOG ERROR ***] %s\n", msg.c_str());
+    })
+{
+}
+
+void
+ThreadedSink::log(const spdlog::details::log_msg & msg)
+{
+  writer_.post(msg);
+}
+
+void
+ThreadedSink::flush()
+{
+  writer_.post_flush();
+}
+
+void
+ThreadedSink::set_pattern(const std::string & pattern)
+{
+  sink_->set_pattern(pattern);
+}
+
+void
+ThreadedSink::set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter)
+{
+  sink_->set_formatter(std::move(sink_formatter));
+}
+
+uint64_t
+ThreadedSink::dropped() const
+{
+  return writer_.dropped();
+}
+
+}  // namespace rcl_logging_spdlog
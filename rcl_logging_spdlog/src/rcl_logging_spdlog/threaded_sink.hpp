@@ -0,0 +1,84 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_LOGGING_SPDLOG__THREADED_SINK_HPP_
+#define RCL_LOGGING_SPDLOG__THREADED_SINK_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "rcutils/allocator.h"
+
+#include "spdlog/details/log_msg.h"
+#include "spdlog/formatter.h"
+#include "spdlog/sinks/sink.h"
+
+#include "rcl_logging_interface/visibility_control.h"
+
+#include "rcl_logging_spdlog/async_writer.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+/// An spdlog sink which hands messages over to another sink on a thread of its own.
+/**
+ * Logging a message only copies it onto the bounded queue of an AsyncWriter,
+ * so however slow the other sink is, it never holds up the caller or the
+ * other sinks.
+ * When the queue is full the oldest message in it is dropped, and counted.
+ *
+ * Destroying it writes out whatever is still queued.
+ */
+class RCL_LOGGING_INTERFACE_LOCAL ThreadedSink final : public spdlog::sinks::sink
+{
+public:
+  /// Create a sink writing to target.
+  /**
+   * Of settings only the queue_size and record_size are used, messages
+   * longer than record_size are truncated.
+   *
+   * \param allocator allocates the queue, see AsyncWriter.
+   * \throws std::bad_alloc if the queue can't be allocated.
+   * \throws std::system_error if the thread can't be started.
+   */
+  ThreadedSink(
+    spdlog::sink_ptr target, const AsyncWriterSettings & settings,
+    rcutils_allocator_t allocator);
+
+  void
+  log(const spdlog::details::log_msg & msg) override;
+
+  /// Have the other sink flushed, once what was logged before is written.
+  void
+  flush() override;
+
+  void
+  set_pattern(const std::string & pattern) override;
+
+  void
+  set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter) override;
+
+  /// The number of messages dropped from the full queue.
+  uint64_t
+  dropped() const;
+
+private:
+  spdlog::sink_ptr sink_;
+  AsyncWriter writer_;
+};
+
+}  // namespace rcl_logging_spdlog
+
+#endif  // RCL_LOGGING_SPDLOG__THREADED_SINK_HPP_
@@ -0,0 +1,472 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+// liburing is not a dependency, the few system calls needed are made directly.
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && \
+  defined(__NR_io_uring_register)
+#define RCL_LOGGING_SPDLOG_HAVE_IO_URING
+#endif
+#endif
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "spdlog/common.h"
+
+#include "rcl_logging_spdlog/uring_file_writer.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+#ifdef RCL_LOGGING_SPDLOG_HAVE_IO_URING
+
+namespace
+{
+
+// The user data of the fsync submitted by sync(), writes use the buffer index.
+constexpr uint64_t kSyncUserData = UINT64_MAX;
+
+int
+io_uring_setup(unsigned entries, struct io_uring_params * params)
+{
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+int
+io_uring_enter(int ring_fd, unsigned to_submit, unsigned min_complete, unsigned flags)
+{
+  return static_cast<int>(
+    ::syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+int
+io_uring_register(int ring_fd, unsigned opcode, const void * arg, unsigned nr_args)
+{
+  return static_cast<int>(::syscall(__NR_io_uring_register, ring_fd, opcode, arg, nr_args));
+}
+
+bool
+probe_io_uring()
+{
+  struct io_uring_params params;
+  std::memset(&params, 0, sizeof(params));
+  int ring_fd = io_uring_setup(2, &params);
+  if (ring_fd < 0) {
+    // ENOSYS without kernel support, EPERM where it is disabled by policy.
+    return false;
+  }
+  constexpr unsigned kMaxOps = 256;
+  std::vector<char> storage(sizeof(io_uring_probe) + kMaxOps * sizeof(io_uring_probe_op));
+  auto probe = reinterpret_cast<io_uring_probe *>(storage.data());
+  bool supported = 0 == io_uring_register(ring_fd, IORING_REGISTER_PROBE, probe, kMaxOps);
+  for (unsigned op : {IORING_OP_WRITE, IORING_OP_WRITE_FIXED, IORING_OP_FSYNC}) {
+    supported = supported && op < probe->ops_len &&
+      0 != (probe->ops[op].flags & IO_URING_OP_SUPPORTED);
+  }
+  ::close(ring_fd);
+  return supported;
+}
+
+}  // namespace
+
+/// The submission and completion queues shared with the kernel.
+struct UringFileWriter::Ring
+{
+  Ring() = default;
+  Ring(const Ring &) = delete;
+  Ring & operator=(const Ring &) = delete;
+
+  ~Ring()
+  {
+    if (nullptr != sqes) {
+      ::munmap(sqes, sqes_size);
+    }
+    if (nullptr != cq_ring) {
+      ::munmap(cq_ring, cq_ring_size);
+    }
+    if (nullptr != sq_ring) {
+      ::munmap(sq_ring, sq_ring_size);
+    }
+    if (fd >= 0) {
+      ::close(fd);
+    }
+  }
+
+  void
+  setup(unsigned entries)
+  {
+    struct io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    fd = io_uring_setup(entries, &params);
+    if (fd < 0) {
+      spdlog::throw_spdlog_ex("Failed setting up io_uring", errno);
+    }
+    sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    sq_ring = map(sq_ring_size, IORING_OFF_SQ_RING);
+    cq_ring = map(cq_ring_size, IORING_OFF_CQ_RING);
+    sqes = static_cast<io_uring_sqe *>(map(sqes_size, IORING_OFF_SQES));
+
+    char * sq = static_cast<char *>(sq_ring);
+    sq_tail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    sq_mask = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    sq_array = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    char * cq = static_cast<char *>(cq_ring);
+    cq_head = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    cq_tail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    cq_mask = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+  }
+
+  void *
+  map(size_t size, off_t offset)
+  {
+    void * mapping = ::mmap(
+      nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, offset);
+    if (MAP_FAILED == mapping) {
+      spdlog::throw_spdlog_ex("Failed mapping io_uring queues", errno);
+    }
+    return mapping;
+  }
+
+  /// Get the next submission queue entry, cleared.
+  io_uring_sqe *
+  next_sqe()
+  {
+    // Only this thread ever moves the tail, so there is no need to load it atomically.
+    unsigned index = *sq_tail & *sq_mask;
+    io_uring_sqe * sqe = &sqes[index];
+    std::memset(sqe, 0, sizeof(*sqe));
+    sq_array[index] = index;
+    return sqe;
+  }
+
+  /// Submit the entry returned by next_sqe().
+  void
+  submit()
+  {
+    __atomic_store_n(sq_tail, *sq_tail + 1, __ATOMIC_RELEASE);
+    if (io_uring_enter(fd, 1, 0, 0) < 0) {
+      spdlog::throw_spdlog_ex("Failed submitting to io_uring", errno);
+    }
+  }
+
+  int fd = -1;
+  bool fixed_buffers = false;
+  void * sq_ring = nullptr;
+  size_t sq_ring_size = 0;
+  void * cq_ring = nullptr;
+  size_t cq_ring_size = 0;
+  io_uring_sqe * sqes = nullptr;
+  size_t sqes_size = 0;
+  unsigned * sq_tail = nullptr;
+  unsigned * sq_mask = nullptr;
+  unsigned * sq_array = nullptr;
+  unsigned * cq_head = nullptr;
+  unsigned * cq_tail = nullptr;
+  unsigned * cq_mask = nullptr;
+  io_uring_cqe * cqes = nullptr;
+};
+
+#else
+
+struct UringFileWriter::Ring
+{
+};
+
+#endif
+
+UringFileWriter::UringFileWriter(
+  const std::string & filename, size_t buffer_size, size_t buffer_count)
+: filename_(filename),
+  buffer_size_(buffer_size),
+  fd_(-1),
+  current_(0),
+  in_flight_(0),
+  offset_(0),
+  error_(0),
+  sync_done_(false),
+  sync_result_(0)
+{
+#ifndef RCL_LOGGING_SPDLOG_HAVE_IO_URING
+  (void)buffer_count;
+  spdlog::throw_spdlog_ex("io_uring is not supported on this platform");
+#else
+  if (0 == buffer_size_ || 0 == buffer_count) {
+    spdlog::throw_spdlog_ex("The buffers of the io_uring writer must not be empty");
+  }
+  fd_ = ::open(filename_.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, 0644);
+  if (fd_ < 0) {
+    spdlog::throw_spdlog_ex("Failed opening file " + filename_ + " for writing", errno);
+  }
+  struct stat file_status;
+  if (0 != ::fstat(fd_, &file_status)) {
+    int error = errno;
+    ::close(fd_);
+    spdlog::throw_spdlog_ex("Failed getting the size of file " + filename_, error);
+  }
+  offset_ = static_cast<uint64_t>(file_status.st_size);
+
+  try {
+    ring_ = std::make_unique<Ring>();
+    // One entry per buffer, and one for the fsync.
+    ring_->setup(static_cast<unsigned>(buffer_count + 1));
+  } catch (const spdlog::spdlog_ex &) {
+    ring_.reset();
+    ::close(fd_);
+    throw;
+  }
+
+  storage_.resize(buffer_size_ * buffer_count);
+  std::vector<struct iovec> iovecs(buffer_count);
+  for (size_t i = 0; i < buffer_count; ++i) {
+    buffers_.push_back({storage_.data() + i * buffer_size_, 0, false, 0});
+    iovecs[i].iov_base = buffers_[i].data;
+    iovecs[i].iov_len = buffer_size_;
+  }
+  // Registering pins the buffers, which counts against RLIMIT_MEMLOCK on older
+  // kernels.  If that fails the same buffers are written without registration.
+  ring_->fixed_buffers = 0 == io_uring_register(
+    ring_->fd, IORING_REGISTER_BUFFERS, iovecs.data(), static_cast<unsigned>(buffer_count));
+#endif
+}
+
+UringFileWriter::~UringFileWriter()
+{
+#ifdef RCL_LOGGING_SPDLOG_HAVE_IO_URING
+  try {
+    submit_current();
+    wait_for_writes();
+  } catch (const spdlog::spdlog_ex &) {
+    // There is nowhere to report this from here.
+  }
+  // The ring goes first, the kernel may still refer to the registered buffers.
+  ring_.reset();
+  ::close(fd_);
+#endif
+}
+
+void
+UringFileWriter::write(const char * data, size_t size)
+{
+  throw_pending_error();
+  // Make room for completions without a system call, so that the wait below
+  // only happens when the kernel really is behind.
+  reap(0);
+  while (size > 0) {
+    Buffer & buffer = buffers_[current_];
+    wait_for_buffer(current_);
+    size_t chunk = std::min(size, buffer_size_ - buffer.used);
+    std::memcpy(buffer.data + buffer.used, data, chunk);
+    buffer.used += chunk;
+    data += chunk;
+    size -= chunk;
+    if (buffer.used == buffer_size_) {
+      submit_current();
+    }
+  }
+}
+
+void
+UringFileWriter::flush()
+{
+  submit_current();
+  wait_for_writes();
+  throw_pending_error();
+}
+
+void
+UringFileWriter::sync()
+{
+#ifdef RCL_LOGGING_SPDLOG_HAVE_IO_URING
+  flush();
+
+  io_uring_sqe * sqe = ring_->next_sqe();
+  sqe->opcode = IORING_OP_FSYNC;
+  sqe->fd = fd_;
+  sqe->fsync_flags = IORING_FSYNC_DATASYNC;
+  sqe->user_data = kSyncUserData;
+  sync_done_ = false;
+  ring_->submit();
+  while (!sync_done_) {
+    reap(1);
+  }
+  if (sync_result_ < 0) {
+    spdlog::throw_spdlog_ex("Failed syncing file " + filename_, -sync_result_);
+  }
+#endif
+}
+
+size_t
+UringFileWriter::size() const
+{
+  return static_cast<size_t>(offset_) + (buffers_.empty() ? 0 : buffers_[current_].used);
+}
+
+bool
+UringFileWriter::is_supported()
+{
+#ifdef RCL_LOGGING_SPDLOG_HAVE_IO_URING
+  static const bool supported = probe_io_uring();
+  return supported;
+#else
+  return false;
+#endif
+}
+
+void
+UringFileWriter::submit_current()
+{
+#ifdef RCL_LOGGING_SPDLOG_HAVE_IO_URING
+  Buffer & buffer = buffers_[current_];
+  if (0 == buffer.used || buffer.in_flight) {
+    return;
+  }
+  io_uring_sqe * sqe = ring_->next_sqe();
+  if (ring_->fixed_buffers) {
+    sqe->opcode = IORING_OP_WRITE_FIXED;
+    sqe->buf_index = static_cast<uint16_t>(current_);
+  } else {
+    sqe->opcode = IORING_OP_WRITE;
+  }
+  sqe->fd = fd_;
+  sqe->addr = reinterpret_cast<uintptr_t>(buffer.data);
+  sqe->len = static_cast<uint32_t>(buffer.used);
+  sqe->off = offset_;
+  sqe->user_data = current_;
+  ring_->submit();
+
+  buffer.in_flight = true;
+  buffer.offset = offset_;
+  offset_ += buffer.used;
+  ++in_flight_;
+  current_ = (current_ + 1) % buffers_.size();
+#endif
+}
+
+void
+UringFileWriter::reap(unsigned min_complete)
+{
+#ifdef RCL_LOGGING_SPDLOG_HAVE_IO_URING
+  unsigned reaped = 0;
+  while (true) {
+    unsigned head = *ring_->cq_head;
+    unsigned tail = __atomic_load_n(ring_->cq_tail, __ATOMIC_ACQUIRE);
+    while (head != tail) {
+      const io_uring_cqe & cqe = ring_->cqes[head & *ring_->cq_mask];
+      uint64_t user_data = cqe.user_data;
+      int32_t result = cqe.res;
+      ++head;
+      // Hand the entry back to the kernel before acting on it.
+      __atomic_store_n(ring_->cq_head, head, __ATOMIC_RELEASE);
+      complete(user_data, result);
+      ++reaped;
+    }
+    if (reaped >= min_complete) {
+      return;
+    }
+    if (io_uring_enter(ring_->fd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && EINTR != errno) {
+      spdlog::throw_spdlog_ex("Failed waiting for io_uring", errno);
+    }
+  }
+#else
+  (void)min_complete;
+#endif
+}
+
+void
+UringFileWriter::complete(uint64_t user_data, int32_t result)
+{
+#ifdef RCL_LOGGING_SPDLOG_HAVE_IO_URING
+  if (kSyncUserData == user_data) {
+    sync_done_ = true;
+    sync_result_ = result;
+    return;
+  }
+  Buffer & buffer = buffers_[user_data];
+  if (result < 0) {
+    if (0 == error_) {
+      error_ = -result;
+    }
+  } else {
+    // Short writes to regular files are rare enough to finish synchronously.
+    size_t written = static_cast<size_t>(result);
+    while (written < buffer.used) {
+      ssize_t ret = ::pwrite(
+        fd_, buffer.data + written, buffer.used - written,
+        static_cast<off_t>(buffer.offset + written));
+      if (ret <= 0) {
+        if (ret < 0 && EINTR == errno) {
+          continue;
+        }
+        if (0 == error_) {
+          error_ = ret < 0 ? errno : EIO;
+        }
+        break;
+      }
+      written += static_cast<size_t>(ret);
+    }
+  }
+  buffer.used = 0;
+  buffer.in_flight = false;
+  --in_flight_;
+#else
+  (void)user_data;
+  (void)result;
+#endif
+}
+
+void
+UringFileWriter::wait_for_buffer(size_t index)
+{
+  while (buffers_[index].in_flight) {
+    reap(1);
+  }
+}
+
+void
+UringFileWriter::wait_for_writes()
+{
+  while (in_flight_ > 0) {
+    reap(1);
+  }
+}
+
+void
+UringFileWriter::throw_pending_error()
+{
+  if (0 != error_) {
+    int error = error_;
+    error_ = 0;
+    spdlog::throw_spdlog_ex("Failed writing to file " + filename_, error);
+  }
+}
+
+}  // namespace rcl_logging_spdlog
@@ -0,0 +1,127 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_LOGGING_SPDLOG__URING_FILE_WRITER_HPP_
+#define RCL_LOGGING_SPDLOG__URING_FILE_WRITER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rcl_logging_interface/visibility_control.h"
+
+#include "rcl_logging_spdlog/file_writer.hpp"
+
+namespace rcl_logging_spdlog
+{
+
+/// Writes a file through a small io_uring owned by the writer.
+/**
+ * Writes are copied into one of a few buffers registered with the ring.
+ * When a buffer is full it is submitted as a single write at its offset in
+ * the file, and the writer carries on with the next buffer without waiting for
+ * the kernel.
+ * The writer only blocks once every buffer is in flight.
+ * Completions are reaped from the shared completion queue, which needs no
+ * system call.
+ *
+ * flush() submits the partially filled buffer and waits for every outstanding
+ * write, so that afterwards the data is in the file, as after fflush(); sync()
+ * then also waits for an fdatasync submitted through the ring.
+ *
+ * Like other log files, an existing file is appended to.
+ *
+ * This needs Linux 5.6 or newer; use is_supported() before constructing one,
+ * construction throws where io_uring is not available.
+ */
+class RCL_LOGGING_INTERFACE_LOCAL UringFileWriter final : public FileWriter
+{
+public:
+  /// Open filename with buffer_count buffers of buffer_size bytes each.
+  UringFileWriter(const std::string & filename, size_t buffer_size, size_t buffer_count);
+
+  ~UringFileWriter() override;
+
+  void
+  write(const char * data, size_t size) override;
+
+  /// Submit the partially filled buffer, and wait until every write completed.
+  void
+  flush() override;
+
+  void
+  sync() override;
+
+  size_t
+  size() const override;
+
+  /// Whether this kernel supports everything the writer needs.
+  /**
+   * The answer is probed once and then cached.
+   */
+  static bool
+  is_supported();
+
+private:
+  struct Ring;
+
+  struct Buffer
+  {
+    char * data;
+    size_t used;
+    bool in_flight;
+    // Where in the file the buffer was submitted to be written.
+    uint64_t offset;
+  };
+
+  void
+  submit_current();
+
+  /// Reap completions, waiting until at least min_complete were reaped.
+  void
+  reap(unsigned min_complete);
+
+  void
+  complete(uint64_t user_data, int32_t result);
+
+  void
+  wait_for_buffer(size_t index);
+
+  void
+  wait_for_writes();
+
+  void
+  throw_pending_error();
+
+  std::string filename_;
+  size_t buffer_size_;
+  int fd_;
+  std::unique_ptr<Ring> ring_;
+  std::vector<char> storage_;
+  std::vector<Buffer> buffers_;
+  size_t current_;
+  unsigned in_flight_;
+  // The file offset at which the next buffer will be written.
+  uint64_t offset_;
+  // The first error reported by a completion, thrown from the next call.
+  int error_;
+  bool sync_done_;
+  int sync_result_;
+};
+
+}  // namespace rcl_logging_spdlog
+
+#endif  // RCL_LOGGING_SPDLOG__URING_FILE_WRITER_HPP_
@@ -14,12 +14,19 @@
 
 
 #include <rcutils/allocator.h>
+#include <rcutils/env.h>
 #include <rcutils/logging.h>
 #include <rcutils/macros.h>
 
 #include <rcl_logging_interface/rcl_logging_interface.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "performance_test_fixture/performance_test_fixture.hpp"
 
@@ -53,6 +60,13 @@ public:
     if (ret != RCL_LOGGING_RET_OK) {
       st.SkipWithError(rcutils_get_error_string().str);
     }
+    // Logging in steady state must not allocate, see allow_heap_allocations.
+    auto heap_allocations = st.counters.find("heap_allocations");
+    if (!allow_heap_allocations && heap_allocations != st.counters.end() &&
+      heap_allocations->second.value > 0)
+    {
+      st.SkipWithError("Logging allocated memory on the heap");
+    }
   }
 
   static void setLogLevel(int logger_level, benchmark::State & st)
@@ -63,7 +77,285 @@ public:
     }
   }
 
+  // Time each call individually so that the tail latency seen by the caller
+  // is reported, not just the mean.
+  void logAndRecordLatencyPercentiles(int severity, benchmark::State & st)
+  {
+    recordLatencyPercentiles(
+      st, [this, severity]() {
+        rcl_logging_external_log(severity, nullptr, data.c_str());
+      });
+  }
+
+  template<typename LogFunction>
+  void recordLatencyPercentiles(benchmark::State & st, LogFunction log)
+  {
+    std::vector<std::chrono::nanoseconds::rep> latencies;
+    latencies.reserve(static_cast<size_t>(st.max_iterations));
+
+    log();
+    if (asynchronous) {
+      waitForWriters();
+    }
+    reset_heap_counters();
+
+    for (auto _ : st) {
+      RCUTILS_UNUSED(_);
+      auto start = std::chrono::steady_clock::now();
+      log();
+      auto end = std::chrono::steady_clock::now();
+      latencies.push_back(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+    // Adding the counters below allocates.
+    set_are_allocation_measurements_active(false);
+
+    if (latencies.empty()) {
+      return;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double p) {
+        return static_cast<double>(
+          latencies[static_cast<size_t>(p * static_cast<double>(latencies.size() - 1))]);
+      };
+    st.counters["p50_ns"] = percentile(0.50);
+    st.counters["p99_ns"] = percentile(0.99);
+    st.counters["max_ns"] = static_cast<double>(latencies.back());
+  }
+
+  // Let the writer threads finish with what was logged so far, opening the
+  // log file for instance, so that none of it is measured.
+  static void waitForWriters()
+  {
+    rcl_logging_stats_t stats;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (RCL_LOGGING_RET_OK == rcl_logging_external_get_stats(&stats) &&
+      stats.queue_depth > 0 && std::chrono::steady_clock::now() < deadline)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    // The last message is taken off the queue before it is written.
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
   std::string data;
+  // Set for configurations writing from their own threads.
+  bool asynchronous = false;
+  // Only for configurations which allocate by design, every other benchmark
+  // fails if anything was allocated on the heap while it ran.
+  bool allow_heap_allocations = false;
+};
+
+// Takes the size of the message from the benchmark argument.
+class MessageSizeLoggingBenchmarkPerformance : public LoggingBenchmarkPerformance
+{
+public:
+  void SetUp(benchmark::State & st)
+  {
+    LoggingBenchmarkPerformance::SetUp(st);
+    data = std::string(static_cast<size_t>(st.range(0)), '0');
+  }
+};
+
+// Bursts of short messages from a few loggers, like a bridge forwarding logs.
+class BurstLoggingBenchmarkPerformance : public LoggingBenchmarkPerformance
+{
+public:
+  void SetUp(benchmark::State & st)
+  {
+    LoggingBenchmarkPerformance::SetUp(st);
+    data = std::string(64, '0');
+    records.clear();
+    for (size_t i = 0; i < 256; ++i) {
+      const char * name = names[i % 4];
+      records.push_back(
+        {RCUTILS_LOG_SEVERITY_INFO, name, std::strlen(name), data.data(), data.size()});
+    }
+  }
+
+  const char * names[4] = {"bridge.a", "bridge.b", "bridge.c", "bridge.d"};
+  std::vector<rcl_logging_record_t> records;
+};
+
+// Sets RCL_LOGGING_SPDLOG_* environment variables while logging is initialized.
+class ConfiguredLoggingBenchmarkPerformance : public LoggingBenchmarkPerformance
+{
+public:
+  explicit ConfiguredLoggingBenchmarkPerformance(
+    std::vector<std::pair<const char *, const char *>> settings)
+  : settings_(std::move(settings))
+  {
+  }
+
+  void SetUp(benchmark::State & st)
+  {
+    for (const auto & setting : settings_) {
+      if (!rcutils_set_env(setting.first, setting.second)) {
+        st.SkipWithError("Failed to set the logging settings");
+      }
+    }
+    LoggingBenchmarkPerformance::SetUp(st);
+    for (const auto & setting : settings_) {
+      rcutils_set_env(setting.first, nullptr);
+    }
+  }
+
+private:
+  std::vector<std::pair<const char *, const char *>> settings_;
+};
+
+class AsyncLoggingBenchmarkPerformance : public ConfiguredLoggingBenchmarkPerformance
+{
+public:
+  // With room for the whole message in each queued record.
+  AsyncLoggingBenchmarkPerformance()
+  : ConfiguredLoggingBenchmarkPerformance(
+      {{"RCL_LOGGING_SPDLOG_ASYNC", "1"},
+        {"RCL_LOGGING_SPDLOG_ASYNC_RECORD_SIZE", "4096"}})
+  {
+    asynchronous = true;
+  }
+};
+
+class BinaryLoggingBenchmarkPerformance : public ConfiguredLoggingBenchmarkPerformance
+{
+public:
+  BinaryLoggingBenchmarkPerformance()
+  : ConfiguredLoggingBenchmarkPerformance({{"RCL_LOGGING_SPDLOG_FORMAT", "binary"}})
+  {
+  }
+};
+
+class MappedFileLoggingBenchmarkPerformance : public ConfiguredLoggingBenchmarkPerformance
+{
+public:
+  MappedFileLoggingBenchmarkPerformance()
+  : ConfiguredLoggingBenchmarkPerformance({{"RCL_LOGGING_SPDLOG_FILE_WRITER", "mmap"}})
+  {
+    // Mapping the next window of the file.
+    allow_heap_allocations = true;
+  }
+};
+
+// Small segments, so that compression runs throughout the benchmark.
+class RotatingLoggingBenchmarkPerformance : public ConfiguredLoggingBenchmarkPerformance
+{
+public:
+  RotatingLoggingBenchmarkPerformance()
+  : ConfiguredLoggingBenchmarkPerformance(
+      {{"RCL_LOGGING_SPDLOG_ROTATE_SIZE", "1048576"},
+        {"RCL_LOGGING_SPDLOG_MAX_FILES", "4"},
+        {"RCL_LOGGING_SPDLOG_COMPRESS", "1"}})
+  {
+    // Opening the next segment, and compressing the previous one.
+    allow_heap_allocations = true;
+  }
+};
+
+class FlushRecordsLoggingBenchmarkPerformance : public ConfiguredLoggingBenchmarkPerformance
+{
+public:
+  FlushRecordsLoggingBenchmarkPerformance()
+  : ConfiguredLoggingBenchmarkPerformance({{"RCL_LOGGING_SPDLOG_FLUSH_RECORDS", "1"}})
+  {
+  }
+};
+
+class FlushBytesLoggingBenchmarkPerformance : public ConfiguredLoggingBenchmarkPerformance
+{
+public:
+  FlushBytesLoggingBenchmarkPerformance()
+  : ConfiguredLoggingBenchmarkPerformance({{"RCL_LOGGING_SPDLOG_FLUSH_BYTES", "65536"}})
+  {
+  }
+};
+
+class AdaptiveFlushLoggingBenchmarkPerformance : public ConfiguredLoggingBenchmarkPerformance
+{
+public:
+  AdaptiveFlushLoggingBenchmarkPerformance()
+  : ConfiguredLoggingBenchmarkPerformance({{"RCL_LOGGING_SPDLOG_FLUSH_ADAPTIVE", "1"}})
+  {
+  }
+};
+
+class SyncOnErrorLoggingBenchmarkPerformance : public ConfiguredLoggingBenchmarkPerformance
+{
+public:
+  SyncOnErrorLoggingBenchmarkPerformance()
+  : ConfiguredLoggingBenchmarkPerformance({{"RCL_LOGGING_SPDLOG_SYNC_LEVEL", "error"}})
+  {
+  }
+};
+
+class UringLoggingBenchmarkPerformance : public ConfiguredLoggingBenchmarkPerformance
+{
+public:
+  UringLoggingBenchmarkPerformance()
+  : ConfiguredLoggingBenchmarkPerformance({{"RCL_LOGGING_SPDLOG_FILE_WRITER", "io_uring"}})
+  {
+  }
+};
+
+class UringSyncOnErrorLoggingBenchmarkPerformance : public ConfiguredLoggingBenchmarkPerformance
+{
+public:
+  UringSyncOnErrorLoggingBenchmarkPerformance()
+  : ConfiguredLoggingBenchmarkPerformance(
+      {{"RCL_LOGGING_SPDLOG_FILE_WRITER", "io_uring"},
+        {"RCL_LOGGING_SPDLOG_SYNC_LEVEL", "error"}})
+  {
+  }
+};
+
+class FlightRecorderLoggingBenchmarkPerformance : public ConfiguredLoggingBenchmarkPerformance
+{
+public:
+  FlightRecorderLoggingBenchmarkPerformance()
+  : ConfiguredLoggingBenchmarkPerformance({{"RCL_LOGGING_SPDLOG_FLIGHT_RECORDER_SIZE", "1024"}})
+  {
+  }
+};
+
+// Rate limited and suppressing duplicates, without ever reaching the limit.
+class FilteredLoggingBenchmarkPerformance : public ConfiguredLoggingBenchmarkPerformance
+{
+public:
+  FilteredLoggingBenchmarkPerformance()
+  : ConfiguredLoggingBenchmarkPerformance(
+      {{"RCL_LOGGING_SPDLOG_RATE_LIMIT", "1000000000"},
+        {"RCL_LOGGING_SPDLOG_SUPPRESS_DUPLICATES", "1"}})
+  {
+  }
+};
+
+// Never waits for the writer thread, dropping messages instead.
+class AsyncDiscardNewLoggingBenchmarkPerformance : public ConfiguredLoggingBenchmarkPerformance
+{
+public:
+  AsyncDiscardNewLoggingBenchmarkPerformance()
+  : ConfiguredLoggingBenchmarkPerformance(
+      {{"RCL_LOGGING_SPDLOG_ASYNC", "1"},
+        {"RCL_LOGGING_SPDLOG_ASYNC_RECORD_SIZE", "4096"},
+        {"RCL_LOGGING_SPDLOG_ASYNC_OVERFLOW_POLICY", "discard_new"}})
+  {
+    asynchronous = true;
+  }
+};
+
+// Every message also goes to an errors-only file, and to a UDP port nothing
+// listens on, each from a thread of its own.
+class ExtraSinksLoggingBenchmarkPerformance : public ConfiguredLoggingBenchmarkPerformance
+{
+public:
+  ExtraSinksLoggingBenchmarkPerformance()
+  : ConfiguredLoggingBenchmarkPerformance(
+      {{"RCL_LOGGING_SPDLOG_EXTRA_SINKS", "error:file:errors,debug:udp:127.0.0.1:9"},
+        {"RCL_LOGGING_SPDLOG_EXTRA_SINK_QUEUE_SIZE", "1024"},
+        {"RCL_LOGGING_SPDLOG_ASYNC_RECORD_SIZE", "4096"}})
+  {
+    asynchronous = true;
+  }
 };
 
 BENCHMARK_F(LoggingBenchmarkPerformance, log_level_hit)(benchmark::State & st)
@@ -79,15 +371,268 @@ BENCHMARK_F(LoggingBenchmarkPerformance, log_level_hit)(benchmark::State & st)
   }
 }
 
+// The same, timing each call to report the tail latency. The clock reads
+// inflate its mean, which log_level_hit measures without them.
+BENCHMARK_F(LoggingBenchmarkPerformance, log_level_hit_latency)(benchmark::State & st)
+{
+  setLogLevel(RCUTILS_LOG_SEVERITY_INFO, st);
+  logAndRecordLatencyPercentiles(RCUTILS_LOG_SEVERITY_INFO, st);
+}
+
+// Changes the last character of the message every time, so that none is a
+// duplicate, but telling them apart takes comparing the whole message.
+// Measured like LoggingBenchmarkPerformance/log_level_hit, to compare with
+// it the cost of messages the filter lets through.
+BENCHMARK_F(FilteredLoggingBenchmarkPerformance, log_level_hit)(benchmark::State & st)
+{
+  setLogLevel(RCUTILS_LOG_SEVERITY_INFO, st);
+
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, data.c_str());
+  reset_heap_counters();
+
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    data.back() = '0' == data.back() ? '1' : '0';
+    rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, data.c_str());
+  }
+}
+
+// The same, timing each call to report the tail latency.
+BENCHMARK_F(FilteredLoggingBenchmarkPerformance, log_level_hit_latency)(benchmark::State & st)
+{
+  setLogLevel(RCUTILS_LOG_SEVERITY_INFO, st);
+  recordLatencyPercentiles(
+    st, [this]() {
+      data.back() = '0' == data.back() ? '1' : '0';
+      rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, data.c_str());
+    });
+}
+
+// A logger stuck repeating itself costs the hashing, not the writing.
+BENCHMARK_F(FilteredLoggingBenchmarkPerformance, log_duplicate)(benchmark::State & st)
+{
+  setLogLevel(RCUTILS_LOG_SEVERITY_INFO, st);
+  logAndRecordLatencyPercentiles(RCUTILS_LOG_SEVERITY_INFO, st);
+}
+
+BENCHMARK_F(AsyncLoggingBenchmarkPerformance, log_level_hit)(benchmark::State & st)
+{
+  setLogLevel(RCUTILS_LOG_SEVERITY_INFO, st);
+  logAndRecordLatencyPercentiles(RCUTILS_LOG_SEVERITY_INFO, st);
+}
+
+BENCHMARK_F(ExtraSinksLoggingBenchmarkPerformance, log_level_hit)(benchmark::State & st)
+{
+  setLogLevel(RCUTILS_LOG_SEVERITY_INFO, st);
+  logAndRecordLatencyPercentiles(RCUTILS_LOG_SEVERITY_INFO, st);
+}
+
+BENCHMARK_F(AsyncDiscardNewLoggingBenchmarkPerformance, log_level_hit)(benchmark::State & st)
+{
+  setLogLevel(RCUTILS_LOG_SEVERITY_INFO, st);
+  logAndRecordLatencyPercentiles(RCUTILS_LOG_SEVERITY_INFO, st);
+}
+
+BENCHMARK_F(BinaryLoggingBenchmarkPerformance, log_level_hit)(benchmark::State & st)
+{
+  setLogLevel(RCUTILS_LOG_SEVERITY_INFO, st);
+  logAndRecordLatencyPercentiles(RCUTILS_LOG_SEVERITY_INFO, st);
+}
+
+BENCHMARK_F(MappedFileLoggingBenchmarkPerformance, log_level_hit)(benchmark::State & st)
+{
+  setLogLevel(RCUTILS_LOG_SEVERITY_INFO, st);
+  logAndRecordLatencyPercentiles(RCUTILS_LOG_SEVERITY_INFO, st);
+}
+
+BENCHMARK_F(RotatingLoggingBenchmarkPerformance, log_level_hit)(benchmark::State & st)
+{
+  setLogLevel(RCUTILS_LOG_SEVERITY_INFO, st);
+  logAndRecordLatencyPercentiles(RCUTILS_LOG_SEVERITY_INFO, st);
+}
+
+BENCHMARK_F(FlushRecordsLoggingBenchmarkPerformance, log_level_hit)(benchmark::State & st)
+{
+  setLogLevel(RCUTILS_LOG_SEVERITY_INFO, st);
+  logAndRecordLatencyPercentiles(RCUTILS_LOG_SEVERITY_INFO, st);
+}
+
+BENCHMARK_F(FlushBytesLoggingBenchmarkPerformance, log_level_hit)(benchmark::State & st)
+{
+  setLogLevel(RCUTILS_LOG_SEVERITY_INFO, st);
+  logAndRecordLatencyPercentiles(RCUTILS_LOG_SEVERITY_INFO, st);
+}
+
+BENCHMARK_F(AdaptiveFlushLoggingBenchmarkPerformance, log_level_hit)(benchmark::State & st)
+{
+  setLogLevel(RCUTILS_LOG_SEVERITY_INFO, st);
+  logAndRecordLatencyPercentiles(RCUTILS_LOG_SEVERITY_INFO, st);
+}
+
+// The default flushes every error, compare with syncing every error.
+BENCHMARK_F(UringLoggingBenchmarkPerformance, log_level_hit)(benchmark::State & st)
+{
+  setLogLevel(RCUTILS_LOG_SEVERITY_INFO, st);
+  logAndRecordLatencyPercentiles(RCUTILS_LOG_SEVERITY_INFO, st);
+}
+
+BENCHMARK_DEFINE_F(MessageSizeLoggingBenchmarkPerformance, log_level_hit)(
+  benchmark::State & st)
+{
+  setLogLevel(RCUTILS_LOG_SEVERITY_INFO, st);
+  logAndRecordLatencyPercentiles(RCUTILS_LOG_SEVERITY_INFO, st);
+  st.SetBytesProcessed(static_cast<int64_t>(st.iterations() * data.size()));
+}
+BENCHMARK_REGISTER_F(MessageSizeLoggingBenchmarkPerformance, log_level_hit)
+->RangeMultiplier(4)->Range(16, 64 * 1024);
+
+// The same, with the lengths passed in rather than measured by the backend.
+BENCHMARK_DEFINE_F(MessageSizeLoggingBenchmarkPerformance, log_with_length_level_hit)(
+  benchmark::State & st)
+{
+  setLogLevel(RCUTILS_LOG_SEVERITY_INFO, st);
+  recordLatencyPercentiles(
+    st, [this]() {
+      rcl_logging_external_log_with_length(
+        RCUTILS_LOG_SEVERITY_INFO, nullptr, 0, data.data(), data.size());
+    });
+  st.SetBytesProcessed(static_cast<int64_t>(st.iterations() * data.size()));
+}
+BENCHMARK_REGISTER_F(MessageSizeLoggingBenchmarkPerformance, log_with_length_level_hit)
+->RangeMultiplier(4)->Range(16, 64 * 1024);
+
+// The backend formats the message, with the time stamp it got, rather than
+// rcutils before calling into it.
+BENCHMARK_F(LoggingBenchmarkPerformance, log_structured_level_hit)(benchmark::State & st)
+{
+  setLogLevel(RCUTILS_LOG_SEVERITY_INFO, st);
+  rcl_logging_structured_record_t record = {
+    RCUTILS_LOG_SEVERITY_INFO, nullptr, 0, 0, __FILE__, __func__, __LINE__, data.data(),
+    data.size()};
+  recordLatencyPercentiles(
+    st, [&record]() {
+      record.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+      rcl_logging_external_log_structured(&record);
+    });
+}
+
+BENCHMARK_F(BurstLoggingBenchmarkPerformance, log_one_by_one)(benchmark::State & st)
+{
+  setLogLevel(RCUTILS_LOG_SEVERITY_INFO, st);
+  rcl_logging_external_log_batch(records.data(), records.size());
+  reset_heap_counters();
+
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    for (const rcl_logging_record_t & record : records) {
+      rcl_logging_external_log_with_length(
+        record.severity, record.name, record.name_length, record.msg, record.msg_length);
+    }
+  }
+  set_are_allocation_measurements_active(false);
+  st.SetItemsProcessed(static_cast<int64_t>(st.iterations() * records.size()));
+}
+
+BENCHMARK_F(BurstLoggingBenchmarkPerformance, log_batch)(benchmark::State & st)
+{
+  setLogLevel(RCUTILS_LOG_SEVERITY_INFO, st);
+  rcl_logging_external_log_batch(records.data(), records.size());
+  reset_heap_counters();
+
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    rcl_logging_external_log_batch(records.data(), records.size());
+  }
+  set_are_allocation_measurements_active(false);
+  st.SetItemsProcessed(static_cast<int64_t>(st.iterations() * records.size()));
+}
+
+BENCHMARK_F(LoggingBenchmarkPerformance, log_error)(benchmark::State & st)
+{
+  setLogLevel(RCUTILS_LOG_SEVERITY_INFO, st);
+  logAndRecordLatencyPercentiles(RCUTILS_LOG_SEVERITY_ERROR, st);
+}
+
+BENCHMARK_F(SyncOnErrorLoggingBenchmarkPerformance, log_error)(benchmark::State & st)
+{
+  setLogLevel(RCUTILS_LOG_SEVERITY_INFO, st);
+  logAndRecordLatencyPercentiles(RCUTILS_LOG_SEVERITY_ERROR, st);
+}
+
+BENCHMARK_F(UringSyncOnErrorLoggingBenchmarkPerformance, log_error)(benchmark::State & st)
+{
+  setLogLevel(RCUTILS_LOG_SEVERITY_INFO, st);
+  logAndRecordLatencyPercentiles(RCUTILS_LOG_SEVERITY_ERROR, st);
+}
+
 BENCHMARK_F(LoggingBenchmarkPerformance, log_level_miss)(benchmark::State & st)
 {
   setLogLevel(RCUTILS_LOG_SEVERITY_INFO, st);
+  // Setting the level publishes a new set of thresholds, which allocates
+  reset_heap_counters();
+
   for (auto _ : st) {
     RCUTILS_UNUSED(_);
     rcl_logging_external_log(RCUTILS_LOG_SEVERITY_DEBUG, nullptr, data.c_str());
   }
 }
 
+BENCHMARK_F(LoggingBenchmarkPerformance, log_structured_level_miss)(benchmark::State & st)
+{
+  setLogLevel(RCUTILS_LOG_SEVERITY_INFO, st);
+  rcl_logging_structured_record_t record = {
+    RCUTILS_LOG_SEVERITY_DEBUG, nullptr, 0, 0, __FILE__, __func__, __LINE__, data.data(),
+    data.size()};
+  reset_heap_counters();
+
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    rcl_logging_external_log_structured(&record);
+  }
+}
+
+// This is what a caller checking the exported threshold before formatting and
+// calling into the backend pays for a message that would be dropped anyway.
+BENCHMARK_F(LoggingBenchmarkPerformance, log_level_miss_threshold)(benchmark::State & st)
+{
+  setLogLevel(RCUTILS_LOG_SEVERITY_INFO, st);
+  reset_heap_counters();
+
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    if (rcl_logging_external_severity_might_be_enabled(RCUTILS_LOG_SEVERITY_DEBUG)) {
+      rcl_logging_external_log(RCUTILS_LOG_SEVERITY_DEBUG, nullptr, data.c_str());
+    }
+  }
+}
+
+BENCHMARK_F(LoggingBenchmarkPerformance, log_level_miss_named_logger)(benchmark::State & st)
+{
+  setLogLevel(RCUTILS_LOG_SEVERITY_INFO, st);
+  rcl_logging_ret_t ret = rcl_logging_external_set_logger_level(
+    "node.debug_logger", RCUTILS_LOG_SEVERITY_DEBUG);
+  if (ret != RCL_LOGGING_RET_OK) {
+    st.SkipWithError(rcutils_get_error_string().str);
+  }
+  const char * logger_name = "node.other_logger";
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_DEBUG, logger_name, data.c_str());
+  reset_heap_counters();
+
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    rcl_logging_external_log(RCUTILS_LOG_SEVERITY_DEBUG, logger_name, data.c_str());
+  }
+}
+
+// A message below the level of the logger, kept by the flight recorder
+// instead of being dropped.
+BENCHMARK_F(FlightRecorderLoggingBenchmarkPerformance, log_level_miss)(benchmark::State & st)
+{
+  setLogLevel(RCUTILS_LOG_SEVERITY_INFO, st);
+  logAndRecordLatencyPercentiles(RCUTILS_LOG_SEVERITY_DEBUG, st);
+}
+
 BENCHMARK_F(PerformanceTest, logging_reinitialize)(benchmark::State & st)
 {
   rcutils_allocator_t allocator = rcutils_get_default_allocator();
@@ -98,12 +643,18 @@ BENCHMARK_F(PerformanceTest, logging_reinitialize)(benchmark::State & st)
 
   reset_heap_counters();
 
+  // Like another rcl context coming and going while the first one keeps
+  // logging initialized, sharing its log file and threads.
   for (auto _ : st) {
     RCUTILS_UNUSED(_);
     ret = rcl_logging_external_initialize(nullptr, nullptr, allocator);
     if (ret != RCL_LOGGING_RET_OK) {
       st.SkipWithError(rcutils_get_error_string().str);
     }
+    ret = rcl_logging_external_shutdown();
+    if (ret != RCL_LOGGING_RET_OK) {
+      st.SkipWithError(rcutils_get_error_string().str);
+    }
   }
 
   ret = rcl_logging_external_shutdown();
@@ -0,0 +1,225 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rcutils/allocator.h>
+#include <rcutils/env.h>
+#include <rcutils/error_handling.h>
+#include <rcutils/logging.h>
+#include <rcutils/macros.h>
+#include <rcutils/process.h>
+
+#include <rcl_logging_interface/rcl_logging_interface.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+
+using performance_test_fixture::PerformanceTest;
+
+namespace
+{
+constexpr int kMaxThreads = 8;
+
+// Where the log file is written, the third benchmark argument.
+enum LogDirectory : int64_t
+{
+  // Under the default logging directory, normally on disk.
+  kDisk = 0,
+  // Under /dev/shm, so that only the cost of the logging itself is measured.
+  kTmpfs = 1,
+};
+}  // namespace
+
+// Threads logging at once, each with a logger of its own.
+/**
+ * The benchmark arguments are the size of the messages, the percentage of
+ * them at a severity which is logged (the others are below the level of the
+ * logger), and the LogDirectory.
+ *
+ * Logging is set up and torn down by the first thread only, the others wait
+ * for it at the start of the benchmark loop.
+ * Items and bytes processed are summed over all threads, and the latency
+ * percentiles are taken over the calls of all threads.
+ */
+class ScalingLoggingBenchmarkPerformance : public PerformanceTest
+{
+public:
+  void SetUp(benchmark::State & st) override
+  {
+    if (0 != st.thread_index()) {
+      return;
+    }
+    if (st.threads() > kMaxThreads) {
+      st.SkipWithError("Too many threads");
+      return;
+    }
+
+    std::filesystem::path base_directory;
+    if (kTmpfs == st.range(2)) {
+      base_directory = "/dev/shm";
+    } else {
+      rcutils_allocator_t allocator = rcutils_get_default_allocator();
+      char * logging_directory = nullptr;
+      if (RCL_LOGGING_RET_OK != rcl_logging_get_logging_directory(allocator, &logging_directory)) {
+        st.SkipWithError(rcutils_get_error_string().str);
+        return;
+      }
+      base_directory = logging_directory;
+      allocator.deallocate(logging_directory, allocator.state);
+    }
+    log_directory_ = base_directory /
+      ("rcl_logging_spdlog_benchmark_" + std::to_string(rcutils_get_pid()));
+    std::error_code ec;
+    std::filesystem::create_directories(log_directory_, ec);
+    if (ec) {
+      st.SkipWithError("Failed to create the log directory");
+      return;
+    }
+
+    rcutils_set_env("ROS_LOG_DIR", log_directory_.string().c_str());
+    rcl_logging_ret_t ret = rcl_logging_external_initialize(
+      nullptr, nullptr, rcutils_get_default_allocator());
+    rcutils_set_env("ROS_LOG_DIR", nullptr);
+    if (ret != RCL_LOGGING_RET_OK) {
+      st.SkipWithError(rcutils_get_error_string().str);
+      return;
+    }
+    if (rcl_logging_external_set_logger_level(nullptr, RCUTILS_LOG_SEVERITY_INFO) !=
+      RCL_LOGGING_RET_OK)
+    {
+      st.SkipWithError(rcutils_get_error_string().str);
+    }
+
+    data_ = std::string(static_cast<size_t>(st.range(0)), '0');
+    // Hits and misses shuffled, rather than in runs.
+    severities_.assign(100, RCUTILS_LOG_SEVERITY_DEBUG);
+    std::fill_n(severities_.begin(), st.range(1), RCUTILS_LOG_SEVERITY_INFO);
+    std::shuffle(severities_.begin(), severities_.end(), std::mt19937(42));
+    // Everything the threads use is allocated up front, so that only the
+    // allocations of the backend are counted.
+    names_.clear();
+    latencies_.assign(static_cast<size_t>(st.threads()), {});
+    for (int thread = 0; thread < st.threads(); ++thread) {
+      names_.push_back("node_" + std::to_string(thread));
+      latencies_[static_cast<size_t>(thread)].reserve(static_cast<size_t>(st.max_iterations));
+    }
+
+    PerformanceTest::SetUp(st);
+  }
+
+  void TearDown(benchmark::State & st) override
+  {
+    if (0 != st.thread_index()) {
+      return;
+    }
+    PerformanceTest::TearDown(st);
+
+    std::vector<std::chrono::nanoseconds::rep> latencies;
+    for (const auto & thread_latencies : latencies_) {
+      latencies.insert(latencies.end(), thread_latencies.begin(), thread_latencies.end());
+    }
+    if (!latencies.empty()) {
+      std::sort(latencies.begin(), latencies.end());
+      auto percentile = [&latencies](double p) {
+          return static_cast<double>(
+            latencies[static_cast<size_t>(p * static_cast<double>(latencies.size() - 1))]);
+        };
+      st.counters["p50_ns"] = percentile(0.50);
+      st.counters["p99_ns"] = percentile(0.99);
+      st.counters["max_ns"] = static_cast<double>(latencies.back());
+    }
+
+    if (RCL_LOGGING_RET_OK != rcl_logging_external_shutdown()) {
+      st.SkipWithError(rcutils_get_error_string().str);
+    }
+    std::error_code ec;
+    std::filesystem::remove_all(log_directory_, ec);
+  }
+
+  void run(benchmark::State & st)
+  {
+    size_t thread = static_cast<size_t>(st.thread_index());
+    // Threads start at different points of the pattern.
+    size_t next = thread * 37;
+    int64_t hits = 0;
+
+    for (auto _ : st) {
+      RCUTILS_UNUSED(_);
+      // The members are only safe to look at once in the loop, the first
+      // thread may still be setting them up before that.
+      const char * name = names_[thread].c_str();
+      std::vector<std::chrono::nanoseconds::rep> & latencies = latencies_[thread];
+      int severity = severities_[next++ % severities_.size()];
+      auto start = std::chrono::steady_clock::now();
+      rcl_logging_external_log(severity, name, data_.c_str());
+      auto end = std::chrono::steady_clock::now();
+      latencies.push_back(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+      hits += RCUTILS_LOG_SEVERITY_INFO == severity ? 1 : 0;
+    }
+
+    st.SetItemsProcessed(static_cast<int64_t>(st.iterations()));
+    st.SetBytesProcessed(hits * static_cast<int64_t>(data_.size()));
+  }
+
+private:
+  std::filesystem::path log_directory_;
+  std::string data_;
+  std::vector<int> severities_;
+  std::vector<std::string> names_;
+  std::vector<std::vector<std::chrono::nanoseconds::rep>> latencies_;
+};
+
+// How throughput and latency scale with the number of threads.
+BENCHMARK_DEFINE_F(ScalingLoggingBenchmarkPerformance, log_threads)(benchmark::State & st)
+{
+  run(st);
+}
+BENCHMARK_REGISTER_F(ScalingLoggingBenchmarkPerformance, log_threads)
+->ArgNames({"size", "hit_percent", "tmpfs"})
+->ArgsProduct({{256}, {100}, {kDisk, kTmpfs}})
+->ThreadRange(1, kMaxThreads)
+->UseRealTime();
+
+// How they scale with the size of the messages, alone and contended.
+BENCHMARK_DEFINE_F(ScalingLoggingBenchmarkPerformance, log_sizes)(benchmark::State & st)
+{
+  run(st);
+}
+BENCHMARK_REGISTER_F(ScalingLoggingBenchmarkPerformance, log_sizes)
+->ArgNames({"size", "hit_percent", "tmpfs"})
+->ArgsProduct({{16, 64, 256, 1024, 4096, 16384, 65536}, {100}, {kDisk, kTmpfs}})
+->Threads(1)
+->Threads(4)
+->UseRealTime();
+
+// Messages mostly below the level of their logger, as with debug messages
+// left in the code, should cost next to nothing however many threads log.
+BENCHMARK_DEFINE_F(ScalingLoggingBenchmarkPerformance, log_mixed)(benchmark::State & st)
+{
+  run(st);
+}
+BENCHMARK_REGISTER_F(ScalingLoggingBenchmarkPerformance, log_mixed)
+->ArgNames({"size", "hit_percent", "tmpfs"})
+->ArgsProduct({{256}, {0, 10, 50, 90}, {kTmpfs}})
+->Threads(1)
+->Threads(4)
+->UseRealTime();
@@ -12,11 +12,38 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <zlib.h>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/resource.h>
+#endif
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
 #include <filesystem>
 #include <fstream>
+#include <new>
 #include <random>
 #include <sstream>
 #include <string>
+#include <utility>
+#include <thread>
+#include <vector>
 
 #include "gmock/gmock.h"
 
@@ -33,6 +60,8 @@
 #include "rcutils/strdup.h"
 #include "rcutils/testing/fault_injection.h"
 
+#include "rcl_logging_spdlog/binary_log_format.hpp"
+
 static constexpr int logger_levels[] =
 {
   RCUTILS_LOG_SEVERITY_UNSET,
@@ -43,6 +72,38 @@ static constexpr int logger_levels[] =
   RCUTILS_LOG_SEVERITY_FATAL,
 };
 
+#ifndef _WIN32
+// The heap allocations made through operator new while g_count_allocations
+// is set, which the backend's logging paths are meant to make none of.
+// A replaced operator new doesn't reach into DLLs, so this is not on Windows.
+static std::atomic<bool> g_count_allocations{false};
+static std::atomic<size_t> g_allocations{0};
+
+// Out of line, so that the compiler doesn't pair up inlined calls to malloc
+// and free with new and delete expressions.
+__attribute__((noinline)) void * operator new(size_t size)
+{
+  if (g_count_allocations.load(std::memory_order_relaxed)) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+  }
+  void * memory = std::malloc(0 == size ? 1 : size);
+  if (nullptr == memory) {
+    throw std::bad_alloc();
+  }
+  return memory;
+}
+
+__attribute__((noinline)) void operator delete(void * memory) noexcept
+{
+  std::free(memory);
+}
+
+__attribute__((noinline)) void operator delete(void * memory, size_t) noexcept
+{
+  std::free(memory);
+}
+#endif
+
 // This is a helper class that resets an environment
 // variable when leaving scope
 class RestoreEnvVar final
@@ -157,6 +218,11 @@ public:
     return found;
   }
 
+  std::filesystem::path log_file_path_dir() const
+  {
+    return local_log_dir_;
+  }
+
   rcutils_allocator_t allocator;
 
 private:
@@ -183,9 +249,8 @@ private:
 
 TEST_F(AllocatorTest, init_invalid)
 {
-  // Config files are not supported by spdlog
   EXPECT_EQ(
-    RCL_LOGGING_RET_ERROR,
+    RCL_LOGGING_RET_CONFIG_FILE_DOESNT_EXIST,
     rcl_logging_external_initialize(nullptr, "anything", allocator));
   rcutils_reset_error();
   EXPECT_EQ(
@@ -340,6 +405,101 @@ TEST_F(LoggingTest, init_invalid_flush_setting)
   rcutils_reset_error();
 }
 
+TEST_F(LoggingTest, init_async)
+{
+  RestoreEnvVar async_var("RCL_LOGGING_SPDLOG_ASYNC");
+  RestoreEnvVar queue_size_var("RCL_LOGGING_SPDLOG_ASYNC_QUEUE_SIZE");
+  RestoreEnvVar thread_count_var("RCL_LOGGING_SPDLOG_ASYNC_THREAD_COUNT");
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_ASYNC", "1");
+  // Use a tiny queue so that the callers have to wait on the writer thread
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_ASYNC_QUEUE_SIZE", "2");
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_ASYNC_THREAD_COUNT", "1");
+
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_initialize(nullptr, nullptr, allocator));
+
+  std::stringstream expected_log;
+  for (int level : logger_levels) {
+    EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_set_logger_level(nullptr, level));
+
+    for (int severity : logger_levels) {
+      std::stringstream ss;
+      ss << "Message of severity " << severity << " at level " << level;
+      rcl_logging_external_log(severity, nullptr, ss.str().c_str());
+
+      if (severity >= level) {
+        expected_log << ss.str() << std::endl;
+      } else if (severity == 0 && level == 10) {
+        // This is a special case - not sure what the right behavior is
+        expected_log << ss.str() << std::endl;
+      }
+    }
+  }
+
+  // Shutting down must drain the queue before the file is closed
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+
+  std::string log_file_path = find_single_log(nullptr).string();
+  std::ifstream log_file(log_file_path);
+  std::stringstream actual_log;
+  actual_log << log_file.rdbuf();
+  EXPECT_EQ(
+    expected_log.str(),
+    actual_log.str()) << "Unexpected log contents in " << log_file_path;
+}
+
+TEST_F(LoggingTest, init_invalid_async_settings)
+{
+  RestoreEnvVar async_var("RCL_LOGGING_SPDLOG_ASYNC");
+  RestoreEnvVar queue_size_var("RCL_LOGGING_SPDLOG_ASYNC_QUEUE_SIZE");
+  RestoreEnvVar thread_count_var("RCL_LOGGING_SPDLOG_ASYNC_THREAD_COUNT");
+  RestoreEnvVar record_size_var("RCL_LOGGING_SPDLOG_ASYNC_RECORD_SIZE");
+  using ::testing::HasSubstr;
+
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_ASYNC", "invalid");
+  ASSERT_EQ(RCL_LOGGING_RET_ERROR, rcl_logging_external_initialize(nullptr, nullptr, allocator));
+  EXPECT_THAT(rcutils_get_error_string().str, HasSubstr("RCL_LOGGING_SPDLOG_ASYNC"));
+  rcutils_reset_error();
+
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_ASYNC", "1");
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_ASYNC_QUEUE_SIZE", "0");
+  ASSERT_EQ(RCL_LOGGING_RET_ERROR, rcl_logging_external_initialize(nullptr, nullptr, allocator));
+  EXPECT_THAT(rcutils_get_error_string().str, HasSubstr("RCL_LOGGING_SPDLOG_ASYNC_QUEUE_SIZE"));
+  rcutils_reset_error();
+
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_ASYNC_QUEUE_SIZE", "1024");
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_ASYNC_THREAD_COUNT", "many");
+  ASSERT_EQ(RCL_LOGGING_RET_ERROR, rcl_logging_external_initialize(nullptr, nullptr, allocator));
+  EXPECT_THAT(rcutils_get_error_string().str, HasSubstr("RCL_LOGGING_SPDLOG_ASYNC_THREAD_COUNT"));
+  rcutils_reset_error();
+
+  // Only one thread keeps messages in order
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_ASYNC_THREAD_COUNT", "2");
+  ASSERT_EQ(RCL_LOGGING_RET_ERROR, rcl_logging_external_initialize(nullptr, nullptr, allocator));
+  EXPECT_THAT(rcutils_get_error_string().str, HasSubstr("RCL_LOGGING_SPDLOG_ASYNC_THREAD_COUNT"));
+  rcutils_reset_error();
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_ASYNC_THREAD_COUNT", "1");
+
+  // Sizes which would overflow, or not fit into memory
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_ASYNC_QUEUE_SIZE", "18446744073709551615");
+  ASSERT_EQ(RCL_LOGGING_RET_ERROR, rcl_logging_external_initialize(nullptr, nullptr, allocator));
+  EXPECT_THAT(rcutils_get_error_string().str, HasSubstr("RCL_LOGGING_SPDLOG_ASYNC_QUEUE_SIZE"));
+  rcutils_reset_error();
+
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_ASYNC_QUEUE_SIZE", "1024");
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_ASYNC_RECORD_SIZE", "1099511627776");
+  ASSERT_EQ(RCL_LOGGING_RET_ERROR, rcl_logging_external_initialize(nullptr, nullptr, allocator));
+  EXPECT_THAT(rcutils_get_error_string().str, HasSubstr("RCL_LOGGING_SPDLOG_ASYNC_RECORD_SIZE"));
+  rcutils_reset_error();
+
+  // Each within its limit, but not both together
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_ASYNC_QUEUE_SIZE", "16777216");
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_ASYNC_RECORD_SIZE", "1048576");
+  ASSERT_EQ(RCL_LOGGING_RET_ERROR, rcl_logging_external_initialize(nullptr, nullptr, allocator));
+  EXPECT_THAT(
+    rcutils_get_error_string().str, HasSubstr("Invalid size of the async logging queue"));
+  rcutils_reset_error();
+}
+
 TEST_F(LoggingTest, full_cycle)
 {
   ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_initialize(nullptr, nullptr, allocator));
@@ -365,6 +525,8 @@ TEST_F(LoggingTest, full_cycle)
     }
   }
 
+  // Once for each initialize
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
   EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
 
   std::string log_file_path = find_single_log(nullptr).string();
@@ -376,6 +538,1729 @@ TEST_F(LoggingTest, full_cycle)
     actual_log.str()) << "Unexpected log contents in " << log_file_path;
 }
 
+TEST_F(LoggingTest, binary_format)
+{
+  RestoreEnvVar format_var("RCL_LOGGING_SPDLOG_FORMAT");
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_FORMAT", "binary");
+
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_initialize(nullptr, nullptr, allocator));
+
+  std::stringstream expected_log;
+  const char * names[] = {nullptr, "a", "a.b", "", "a"};
+  for (const char * name : names) {
+    for (int severity : logger_levels) {
+      std::stringstream ss;
+      ss << "Message of severity " << severity << " from " << (name ? name : "(null)");
+      rcl_logging_external_log(severity, name, ss.str().c_str());
+      if (severity >= RCUTILS_LOG_SEVERITY_INFO) {
+        expected_log << ss.str() << std::endl;
+      }
+    }
+  }
+  // Messages are written as is, including empty ones and embedded newlines
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_WARN, "a", "");
+  expected_log << std::endl;
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_WARN, "a", "two\nlines");
+  expected_log << "two\nlines" << std::endl;
+
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+
+  std::filesystem::path log_file_path = find_single_log(nullptr);
+  EXPECT_EQ(".binlog", log_file_path.extension().string());
+  std::ifstream log_file(log_file_path, std::ios::binary);
+  std::stringstream decoded_log;
+  std::string error;
+  ASSERT_TRUE(
+    rcl_logging_spdlog::binary_log::decode_to_text(log_file, decoded_log, error)) << error;
+  EXPECT_EQ(
+    expected_log.str(),
+    decoded_log.str()) << "Unexpected log contents in " << log_file_path;
+}
+
+TEST_F(LoggingTest, binary_format_decode_invalid)
+{
+  std::string error;
+  std::stringstream output;
+  {
+    std::stringstream input("not a binary log");
+    EXPECT_FALSE(rcl_logging_spdlog::binary_log::decode_to_text(input, output, error));
+  }
+  {
+    std::string data(
+      rcl_logging_spdlog::binary_log::kMagic,
+      sizeof(rcl_logging_spdlog::binary_log::kMagic));
+    data += std::string("\x01\0\0\0\0\0\0\0", 8);
+    // A message record claiming a payload longer than the file
+    data += std::string(8, '\0');
+    data += std::string("\0\0\0\0\x10\0\0\0\x14\0\0\0", 12);
+    data += "short";
+    std::stringstream input(data);
+    EXPECT_FALSE(rcl_logging_spdlog::binary_log::decode_to_text(input, output, error));
+    EXPECT_EQ("truncated record payload", error);
+  }
+  EXPECT_EQ("", output.str());
+}
+
+TEST_F(LoggingTest, init_invalid_format)
+{
+  RestoreEnvVar format_var("RCL_LOGGING_SPDLOG_FORMAT");
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_FORMAT", "invalid");
+
+  ASSERT_EQ(RCL_LOGGING_RET_ERROR, rcl_logging_external_initialize(nullptr, nullptr, allocator));
+  using ::testing::HasSubstr;
+  EXPECT_THAT(rcutils_get_error_string().str, HasSubstr("RCL_LOGGING_SPDLOG_FORMAT"));
+  rcutils_reset_error();
+}
+
+// Read all the segments written by the mmap file writer back, in order.
+static std::string read_log_segments(const std::filesystem::path & first_segment)
+{
+  std::filesystem::path base = first_segment.parent_path() / first_segment.stem();
+  std::string extension = first_segment.extension().string();
+  std::string contents;
+  for (size_t index = 0; ; ++index) {
+    std::filesystem::path segment = index == 0 ?
+      first_segment :
+      std::filesystem::path(base.string() + "." + std::to_string(index) + extension);
+    if (!std::filesystem::exists(segment)) {
+      break;
+    }
+    std::ifstream segment_file(segment, std::ios::binary);
+    std::stringstream segment_contents;
+    segment_contents << segment_file.rdbuf();
+    contents += segment_contents.str();
+  }
+  return contents;
+}
+
+static std::string read_gzip_file(const std::filesystem::path & path)
+{
+  gzFile file = gzopen(path.string().c_str(), "rb");
+  if (nullptr == file) {
+    throw std::runtime_error("Failed to open " + path.string());
+  }
+  std::string contents;
+  char buffer[4096];
+  int count = 0;
+  while ((count = gzread(file, buffer, sizeof(buffer))) > 0) {
+    contents.append(buffer, static_cast<size_t>(count));
+  }
+  gzclose(file);
+  return contents;
+}
+
+TEST_F(LoggingTest, mmap_file_writer)
+{
+  RestoreEnvVar writer_var("RCL_LOGGING_SPDLOG_FILE_WRITER");
+  RestoreEnvVar segment_size_var("RCL_LOGGING_SPDLOG_MMAP_SEGMENT_SIZE");
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_FILE_WRITER", "mmap");
+  // Small enough that messages span segments
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_MMAP_SEGMENT_SIZE", "100");
+
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_initialize("mmap", nullptr, allocator));
+
+  std::stringstream expected_log;
+  for (int i = 0; i < 20; ++i) {
+    std::stringstream ss;
+    ss << "Message number " << i;
+    rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, ss.str().c_str());
+    expected_log << ss.str() << std::endl;
+  }
+  std::string long_message(250, 'x');
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, long_message.c_str());
+  expected_log << long_message << std::endl;
+
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+
+  std::filesystem::path log_file_path;
+  for (const auto & entry : std::filesystem::directory_iterator{log_file_path_dir()}) {
+    // The first segment is the only one without a segment number
+    if (entry.path().stem().extension().empty()) {
+      log_file_path = entry.path();
+    }
+    // Segments are truncated to what was written when closed, and a message
+    // too long for a segment gets one of its own rather than being split
+    auto size = std::filesystem::file_size(entry.path());
+    EXPECT_TRUE(size <= 100u || size == long_message.size() + 1) << entry.path();
+  }
+  ASSERT_FALSE(log_file_path.empty());
+  EXPECT_TRUE(std::filesystem::exists(log_file_path.parent_path() /
+    (log_file_path.stem().string() + ".4.log")));
+  EXPECT_EQ(expected_log.str(), read_log_segments(log_file_path));
+}
+
+TEST_F(LoggingTest, mmap_file_writer_binary_format)
+{
+  RestoreEnvVar writer_var("RCL_LOGGING_SPDLOG_FILE_WRITER");
+  RestoreEnvVar format_var("RCL_LOGGING_SPDLOG_FORMAT");
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_FILE_WRITER", "mmap");
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_FORMAT", "binary");
+
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_initialize(nullptr, nullptr, allocator));
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, "a", "first");
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_WARN, nullptr, "second");
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+
+  std::ifstream log_file(find_single_log(nullptr), std::ios::binary);
+  std::stringstream decoded_log;
+  std::string error;
+  ASSERT_TRUE(
+    rcl_logging_spdlog::binary_log::decode_to_text(log_file, decoded_log, error)) << error;
+  EXPECT_EQ("first\nsecond\n", decoded_log.str());
+}
+
+TEST_F(LoggingTest, init_invalid_file_writer)
+{
+  RestoreEnvVar writer_var("RCL_LOGGING_SPDLOG_FILE_WRITER");
+  RestoreEnvVar segment_size_var("RCL_LOGGING_SPDLOG_MMAP_SEGMENT_SIZE");
+  using ::testing::HasSubstr;
+
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_FILE_WRITER", "invalid");
+  ASSERT_EQ(RCL_LOGGING_RET_ERROR, rcl_logging_external_initialize(nullptr, nullptr, allocator));
+  EXPECT_THAT(rcutils_get_error_string().str, HasSubstr("RCL_LOGGING_SPDLOG_FILE_WRITER"));
+  rcutils_reset_error();
+
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_FILE_WRITER", "mmap");
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_MMAP_SEGMENT_SIZE", "-1");
+  ASSERT_EQ(RCL_LOGGING_RET_ERROR, rcl_logging_external_initialize(nullptr, nullptr, allocator));
+  EXPECT_THAT(rcutils_get_error_string().str, HasSubstr("RCL_LOGGING_SPDLOG_MMAP_SEGMENT_SIZE"));
+  rcutils_reset_error();
+
+  RestoreEnvVar buffers_var("RCL_LOGGING_SPDLOG_IO_URING_BUFFERS");
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_FILE_WRITER", "io_uring");
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_MMAP_SEGMENT_SIZE", "");
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_IO_URING_BUFFERS", "0");
+  ASSERT_EQ(RCL_LOGGING_RET_ERROR, rcl_logging_external_initialize(nullptr, nullptr, allocator));
+  EXPECT_THAT(rcutils_get_error_string().str, HasSubstr("RCL_LOGGING_SPDLOG_IO_URING_BUFFERS"));
+  rcutils_reset_error();
+}
+
+TEST_F(LoggingTest, rotation)
+{
+  RestoreEnvVar size_var("RCL_LOGGING_SPDLOG_ROTATE_SIZE");
+  RestoreEnvVar max_files_var("RCL_LOGGING_SPDLOG_MAX_FILES");
+  RestoreEnvVar compress_var("RCL_LOGGING_SPDLOG_COMPRESS");
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_ROTATE_SIZE", "100");
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_MAX_FILES", "3");
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_COMPRESS", "1");
+
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_initialize("rotate", nullptr, allocator));
+
+  // 5 messages fit in each segment, so this fills 4 of them
+  std::stringstream expected_log;
+  for (int i = 0; i < 20; ++i) {
+    std::stringstream ss;
+    ss << "Message number " << i;
+    rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, ss.str().c_str());
+    if (i >= 5) {
+      expected_log << ss.str() << std::endl;
+    }
+  }
+
+  // Shutting down waits for the closed segments to be compressed
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+
+  // The newest file may be a compressed one, but they all share the base name
+  std::filesystem::path any_segment = find_single_log("rotate");
+  std::string filename = any_segment.filename().string();
+  std::string base = (any_segment.parent_path() / filename.substr(0, filename.find('.'))).string();
+  std::filesystem::path last_segment = base + ".3.log";
+  ASSERT_TRUE(std::filesystem::exists(last_segment));
+
+  // Only the newest 3 segments are kept, and all but the last are compressed
+  EXPECT_FALSE(std::filesystem::exists(base + ".log"));
+  EXPECT_FALSE(std::filesystem::exists(base + ".log.gz"));
+  EXPECT_FALSE(std::filesystem::exists(base + ".1.log"));
+  EXPECT_FALSE(std::filesystem::exists(base + ".2.log"));
+  EXPECT_EQ(3, std::distance(
+      std::filesystem::directory_iterator{log_file_path_dir()},
+      std::filesystem::directory_iterator{}));
+
+  std::ifstream last_segment_file(last_segment);
+  std::stringstream last_segment_contents;
+  last_segment_contents << last_segment_file.rdbuf();
+  EXPECT_EQ(
+    expected_log.str(),
+    read_gzip_file(base + ".1.log.gz") + read_gzip_file(base + ".2.log.gz") +
+    last_segment_contents.str());
+}
+
+TEST_F(LoggingTest, rotation_interval)
+{
+  RestoreEnvVar interval_var("RCL_LOGGING_SPDLOG_ROTATE_INTERVAL");
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_ROTATE_INTERVAL", "1");
+
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_initialize("interval", nullptr, allocator));
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, "first");
+  std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, "second");
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+
+  std::filesystem::path last_segment = find_single_log("interval");
+  EXPECT_EQ(".1", last_segment.stem().extension().string());
+  std::ifstream last_segment_file(last_segment);
+  std::stringstream last_segment_contents;
+  last_segment_contents << last_segment_file.rdbuf();
+  EXPECT_EQ("second\n", last_segment_contents.str());
+}
+
+TEST_F(LoggingTest, rotation_binary_format)
+{
+  RestoreEnvVar size_var("RCL_LOGGING_SPDLOG_ROTATE_SIZE");
+  RestoreEnvVar format_var("RCL_LOGGING_SPDLOG_FORMAT");
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_ROTATE_SIZE", "80");
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_FORMAT", "binary");
+
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_initialize(nullptr, nullptr, allocator));
+  for (int i = 0; i < 4; ++i) {
+    std::string message = "message " + std::to_string(i);
+    rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, "a", message.c_str());
+  }
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+
+  // Every segment has its own file header and logger names
+  std::filesystem::path any_segment = find_single_log(nullptr);
+  std::string filename = any_segment.filename().string();
+  std::string base = (any_segment.parent_path() / filename.substr(0, filename.find('.'))).string();
+  EXPECT_FALSE(std::filesystem::exists(base + ".4.binlog"));
+  for (int i = 0; i < 4; ++i) {
+    std::string segment = base + (i > 0 ? "." + std::to_string(i) : "") + ".binlog";
+    std::ifstream segment_file(segment, std::ios::binary);
+    std::stringstream decoded_log;
+    std::string error;
+    ASSERT_TRUE(
+      rcl_logging_spdlog::binary_log::decode_to_text(segment_file, decoded_log, error)) <<
+      segment << ": " << error;
+    EXPECT_EQ("message " + std::to_string(i) + "\n", decoded_log.str());
+  }
+}
+
+TEST_F(LoggingTest, init_invalid_rotation_settings)
+{
+  RestoreEnvVar size_var("RCL_LOGGING_SPDLOG_ROTATE_SIZE");
+  RestoreEnvVar compress_var("RCL_LOGGING_SPDLOG_COMPRESS");
+  using ::testing::HasSubstr;
+
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_ROTATE_SIZE", "big");
+  ASSERT_EQ(RCL_LOGGING_RET_ERROR, rcl_logging_external_initialize(nullptr, nullptr, allocator));
+  EXPECT_THAT(rcutils_get_error_string().str, HasSubstr("RCL_LOGGING_SPDLOG_ROTATE_SIZE"));
+  rcutils_reset_error();
+
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_ROTATE_SIZE", "1000");
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_COMPRESS", "2");
+  ASSERT_EQ(RCL_LOGGING_RET_ERROR, rcl_logging_external_initialize(nullptr, nullptr, allocator));
+  EXPECT_THAT(rcutils_get_error_string().str, HasSubstr("RCL_LOGGING_SPDLOG_COMPRESS"));
+  rcutils_reset_error();
+}
+
+TEST_F(LoggingTest, config_file)
+{
+  RestoreEnvVar format_var("RCL_LOGGING_SPDLOG_FORMAT");
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_FORMAT", "binary");
+
+  std::filesystem::path config_file_path = log_file_path_dir() / "logging.conf";
+  {
+    std::ofstream config_file(config_file_path);
+    config_file <<
+      "# Takes precedence over the environment\n"
+      "format = text\n"
+      "\n"
+      "  buffer_size=65536  \n"
+      "flush_level = info  # flush every message\n"
+      "flush_interval = 0\n";
+  }
+
+  ASSERT_EQ(
+    RCL_LOGGING_RET_OK,
+    rcl_logging_external_initialize(nullptr, config_file_path.string().c_str(), allocator));
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_DEBUG, nullptr, "not logged");
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, "flushed");
+
+  // Read before shutting down, to see that the message was flushed
+  std::filesystem::path log_file_path = find_single_log(nullptr);
+  EXPECT_EQ(".log", log_file_path.extension().string());
+  std::ifstream log_file(log_file_path);
+  std::stringstream actual_log;
+  actual_log << log_file.rdbuf();
+  EXPECT_EQ("flushed\n", actual_log.str());
+
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+}
+
+TEST_F(LoggingTest, config_file_invalid)
+{
+  using ::testing::HasSubstr;
+  std::filesystem::path config_file_path = log_file_path_dir() / "logging.conf";
+  auto try_config = [&](const std::string & contents) {
+      {
+        std::ofstream config_file(config_file_path, std::ios::trunc);
+        config_file << contents;
+      }
+      rcl_logging_ret_t ret = rcl_logging_external_initialize(
+        nullptr, config_file_path.string().c_str(), allocator);
+      std::string error = rcutils_get_error_string().str;
+      rcutils_reset_error();
+      return std::make_pair(ret, error);
+    };
+
+  auto result = try_config("async = 1\nunknown_key = 1\n");
+  EXPECT_EQ(RCL_LOGGING_RET_CONFIG_FILE_INVALID, result.first);
+  EXPECT_THAT(result.second, HasSubstr("line 2: unknown key 'unknown_key'"));
+
+  result = try_config("async_queue_size = 0\n");
+  EXPECT_EQ(RCL_LOGGING_RET_CONFIG_FILE_INVALID, result.first);
+  EXPECT_THAT(result.second, HasSubstr("line 1: bad value for 'async_queue_size'"));
+
+  result = try_config("async_overflow_policy = drop\n");
+  EXPECT_EQ(RCL_LOGGING_RET_CONFIG_FILE_INVALID, result.first);
+  EXPECT_THAT(result.second, HasSubstr("bad value for 'async_overflow_policy'"));
+
+  result = try_config("async_keep_level = critical\n");
+  EXPECT_EQ(RCL_LOGGING_RET_CONFIG_FILE_INVALID, result.first);
+  EXPECT_THAT(result.second, HasSubstr("bad value for 'async_keep_level'"));
+
+  result = try_config("async_record_size = 0\n");
+  EXPECT_EQ(RCL_LOGGING_RET_CONFIG_FILE_INVALID, result.first);
+  EXPECT_THAT(result.second, HasSubstr("bad value for 'async_record_size'"));
+
+  result = try_config("thread_cpus = 3-1\n");
+  EXPECT_EQ(RCL_LOGGING_RET_CONFIG_FILE_INVALID, result.first);
+  EXPECT_THAT(result.second, HasSubstr("bad value for 'thread_cpus'"));
+
+  result = try_config("thread_scheduling_policy = fifo\n");
+  EXPECT_EQ(RCL_LOGGING_RET_CONFIG_FILE_INVALID, result.first);
+  EXPECT_THAT(result.second, HasSubstr("bad value for 'thread_scheduling_policy'"));
+
+  result = try_config("thread_nice = 20\n");
+  EXPECT_EQ(RCL_LOGGING_RET_CONFIG_FILE_INVALID, result.first);
+  EXPECT_THAT(result.second, HasSubstr("bad value for 'thread_nice'"));
+
+  result = try_config("flight_recorder_signal = SIGKILL\n");
+  EXPECT_EQ(RCL_LOGGING_RET_CONFIG_FILE_INVALID, result.first);
+  EXPECT_THAT(result.second, HasSubstr("bad value for 'flight_recorder_signal'"));
+
+  result = try_config("line_format = \"{message}\n");
+  EXPECT_EQ(RCL_LOGGING_RET_CONFIG_FILE_INVALID, result.first);
+  EXPECT_THAT(
+    result.second, HasSubstr("line 1: bad value for 'line_format': missing closing quote"));
+
+  result = try_config("line_format = \"{message}\" {name}\n");
+  EXPECT_EQ(RCL_LOGGING_RET_CONFIG_FILE_INVALID, result.first);
+  EXPECT_THAT(result.second, HasSubstr("bad value for 'line_format': unexpected text"));
+
+  result = try_config("# comment\nasync\n");
+  EXPECT_EQ(RCL_LOGGING_RET_CONFIG_FILE_INVALID, result.first);
+  EXPECT_THAT(result.second, HasSubstr("line 2: expected '<key> = <value>'"));
+
+  EXPECT_EQ(
+    RCL_LOGGING_RET_CONFIG_FILE_DOESNT_EXIST,
+    rcl_logging_external_initialize(
+      nullptr, (log_file_path_dir() / "missing.conf").string().c_str(), allocator));
+  rcutils_reset_error();
+}
+
+static std::string read_file(const std::filesystem::path & path)
+{
+  std::ifstream file(path, std::ios::binary);
+  std::stringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+#ifndef _WIN32
+// Text messages are written as they are, rather than through a formatter
+// and its buffer, which would have to grow for a message larger than any so far.
+TEST_F(LoggingTest, text_written_without_formatting)
+{
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_initialize(nullptr, nullptr, allocator));
+  // Creating the log file allocates.
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, "first");
+
+  std::string large(1024 * 1024, 'x');
+  g_allocations = 0;
+  g_count_allocations = true;
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, large.c_str());
+  g_count_allocations = false;
+  EXPECT_EQ(0u, g_allocations.load());
+
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+  EXPECT_EQ("first\n" + large + "\n", read_file(find_single_log(nullptr)));
+}
+
+#endif
+
+TEST_F(LoggingTest, shared_initialization)
+{
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_initialize(nullptr, nullptr, allocator));
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, "first client");
+
+  // Another client shares the same log file
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_initialize("other", nullptr, allocator));
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, "second client");
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+
+  // Still there for the first one
+  EXPECT_TRUE(rcl_logging_external_is_enabled_for(nullptr, RCUTILS_LOG_SEVERITY_INFO));
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, "still logging");
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+
+  // Gone after the last one, and logging anyway does nothing
+  EXPECT_FALSE(rcl_logging_external_is_enabled_for(nullptr, RCUTILS_LOG_SEVERITY_FATAL));
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_FATAL, nullptr, "too late");
+  rcl_logging_record_t record = {RCUTILS_LOG_SEVERITY_FATAL, nullptr, 0, "too late", 8};
+  rcl_logging_external_log_batch(&record, 1);
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+
+  EXPECT_EQ(
+    "first client\nsecond client\nstill logging\n", read_file(find_single_log(nullptr)));
+  EXPECT_TRUE(find_single_log("other").empty());
+}
+
+TEST_F(LoggingTest, lazy_log_file)
+{
+  // Nothing written, nothing created
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_initialize(nullptr, nullptr, allocator));
+  EXPECT_TRUE(find_single_log(nullptr).empty());
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_DEBUG, nullptr, "below the level");
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+  EXPECT_TRUE(find_single_log(nullptr).empty());
+
+  // Concurrent first messages all end up in the one file
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_initialize(nullptr, nullptr, allocator));
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; ++i) {
+    threads.emplace_back(
+      []() {
+        rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, "first");
+      });
+  }
+  for (std::thread & thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+  std::string expected_log;
+  for (int i = 0; i < 8; ++i) {
+    expected_log += "first\n";
+  }
+  EXPECT_EQ(expected_log, read_file(find_single_log(nullptr)));
+
+  // Created right away when asked to
+  RestoreEnvVar lazy_file_var("RCL_LOGGING_SPDLOG_LAZY_LOG_FILE");
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_LAZY_LOG_FILE", "0");
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_initialize("eager", nullptr, allocator));
+  EXPECT_FALSE(find_single_log("eager").empty());
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_LAZY_LOG_FILE", "");
+
+  // The directory too
+  RestoreEnvVar lazy_directory_var("RCL_LOGGING_SPDLOG_LAZY_LOG_DIRECTORY");
+  rcpputils::set_env_var("RCL_LOGGING_SPDLOG_LAZY_LOG_DIRECTORY", "1");
+  std::filesystem::path lazy_log_dir = log_file_path_dir() / "lazy" / "log";
+  rcpputils::set_env_var("ROS_LOG_DIR", lazy_log_dir.string().c_str());
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_initialize(nullptr, nullptr, allocator));
+  EXPECT_FALSE(std::filesystem::exists(lazy_log_dir));
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, "created");
+  EXPECT_TRUE(std::filesystem::exists(lazy_log_dir));
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+  EXPECT_EQ("created\n", read_file(find_single_log(nullptr)));
+}
+
+TEST_F(LoggingTest, flush_thresholds)
+{
+  std::filesystem::path config_file_path = log_file_path_dir() / "logging.conf";
+  {
+    std::ofstream config_file(config_file_path);
+    config_file <<
+      "flush_interval = 0\n"
+      "flush_level = none\n"
+      "flush_records = 3\n"
+      "flush_bytes = 10\n"
+      "sync_level = error\n";
+  }
+  ASSERT_EQ(
+    RCL_LOGGING_RET_OK,
+    rcl_logging_external_initialize(nullptr, config_file_path.string().c_str(), allocator));
+
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, "a");
+  std::filesystem::path log_file_path = find_single_log(nullptr);
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, "b");
+  EXPECT_EQ("", read_file(log_file_path));
+  // Reaches the record threshold
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, "c");
+  EXPECT_EQ("a\nb\nc\n", read_file(log_file_path));
+  // Reaches the byte threshold
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, "0123456789");
+  EXPECT_EQ("a\nb\nc\n0123456789\n", read_file(log_file_path));
+  // Synced right away
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_ERROR, nullptr, "d");
+  EXPECT_EQ("a\nb\nc\n0123456789\nd\n", read_file(log_file_path));
+
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+}
+
+TEST_F(LoggingTest, flush_adaptive)
+{
+  std::filesystem::path config_file_path = log_file_path_dir() / "logging.conf";
+  {
+    std::ofstream config_file(config_file_path);
+    config_file <<
+      "flush_interval = 3600\n"
+      "flush_level = none\n"
+      "flush_adaptive = 1\n"
+      "flush_min_interval_ms = 10\n";
+  }
+  ASSERT_EQ(
+    RCL_LOGGING_RET_OK,
+    rcl_logging_external_initialize(nullptr, config_file_path.string().c_str(), allocator));
+
+  // Once idle, the message is flushed well before the interval is up
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, "idle");
+  std::filesystem::path log_file_path = find_single_log(nullptr);
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (read_file(log_file_path).empty() && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  EXPECT_EQ("idle\n", read_file(log_file_path));
+
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+}
+
+TEST_F(LoggingTest, io_uring_file_writer)
+{
+  // Falls back to stdio where io_uring is not available, so this passes either way
+  std::filesystem::path config_file_path = log_file_path_dir() / "logging.conf";
+  {
+    std::ofstream config_file(config_file_path);
+    config_file <<
+      "file_writer = io_uring\n"
+      "buffer_size = 64\n"
+      "io_uring_buffers = 2\n"
+      "flush_interval = 0\n"
+      "flush_level = warn\n"
+      "sync_level = error\n";
+  }
+  ASSERT_EQ(
+    RCL_LOGGING_RET_OK,
+    rcl_logging_external_initialize(nullptr, config_file_path.string().c_str(), allocator));
+
+  // Enough to fill every buffer several times over, and one longer than a buffer
+  std::stringstream expected_log;
+  for (int i = 0; i < 50; ++i) {
+    std::stringstream ss;
+    ss << "Message number " << i;
+    rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, ss.str().c_str());
+    expected_log << ss.str() << std::endl;
+  }
+  std::string long_message(250, 'x');
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, long_message.c_str());
+  expected_log << long_message << std::endl;
+  // A flush waits for all outstanding writes
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_WARN, nullptr, "flushed");
+  expected_log << "flushed" << std::endl;
+  std::filesystem::path log_file_path = find_single_log(nullptr);
+  EXPECT_EQ(expected_log.str(), read_file(log_file_path));
+
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_ERROR, nullptr, "synced");
+  expected_log << "synced" << std::endl;
+  EXPECT_EQ(expected_log.str(), read_file(log_file_path));
+
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, "last");
+  expected_log << "last" << std::endl;
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+  EXPECT_EQ(expected_log.str(), read_file(log_file_path));
+}
+
+TEST_F(LoggingTest, per_logger_levels)
+{
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_initialize(nullptr, nullptr, allocator));
+
+  EXPECT_EQ(
+    RCL_LOGGING_RET_OK,
+    rcl_logging_external_set_logger_level(nullptr, RCUTILS_LOG_SEVERITY_WARN));
+  EXPECT_EQ(
+    RCL_LOGGING_RET_OK,
+    rcl_logging_external_set_logger_level("a.b", RCUTILS_LOG_SEVERITY_DEBUG));
+  EXPECT_EQ(
+    RCL_LOGGING_RET_OK,
+    rcl_logging_external_set_logger_level("a.b.c.d", RCUTILS_LOG_SEVERITY_ERROR));
+
+  const char * names[] = {nullptr, "a", "a.b", "a.b.c", "a.b.c.d", "a.b.c.d.e", "a.bc", "b"};
+  std::stringstream expected_log;
+  auto log_all = [&](const char * when, bool b_is_debug) {
+      for (const char * name : names) {
+        std::string logger_name = name == nullptr ? "" : name;
+        // Log twice so that the second lookup is served from the cache
+        for (int i = 0; i < 2; ++i) {
+          for (int severity : {RCUTILS_LOG_SEVERITY_DEBUG, RCUTILS_LOG_SEVERITY_ERROR}) {
+            std::stringstream ss;
+            ss << when << " message of severity " << severity << " from '" << logger_name << "'";
+            rcl_logging_external_log(severity, name, ss.str().c_str());
+
+            bool inherits_from_a_b = b_is_debug &&
+              (logger_name == "a.b" || logger_name == "a.b.c");
+            if (severity == RCUTILS_LOG_SEVERITY_ERROR || inherits_from_a_b) {
+              expected_log << ss.str() << std::endl;
+            }
+          }
+        }
+      }
+    };
+  log_all("before", true);
+
+  // Unsetting the level of a logger makes it inherit from its parent again
+  EXPECT_EQ(
+    RCL_LOGGING_RET_OK,
+    rcl_logging_external_set_logger_level("a.b", RCUTILS_LOG_SEVERITY_UNSET));
+  log_all("after", false);
+
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+
+  std::string log_file_path = find_single_log(nullptr).string();
+  std::ifstream log_file(log_file_path);
+  std::stringstream actual_log;
+  actual_log << log_file.rdbuf();
+  EXPECT_EQ(
+    expected_log.str(),
+    actual_log.str()) << "Unexpected log contents in " << log_file_path;
+}
+
+// Levels keep changing while other threads look them up, and the tries they
+// superseded are freed meanwhile.
+TEST_F(LoggingTest, per_logger_levels_concurrent)
+{
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_initialize(nullptr, nullptr, allocator));
+
+  constexpr int kThreads = 2;
+  constexpr int kCount = 2000;
+  std::atomic<bool> logging{true};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back(
+      [t]() {
+        for (int i = 0; i < kCount; ++i) {
+          std::string msg = std::to_string(t) + " " + std::to_string(i);
+          rcl_logging_external_log(RCUTILS_LOG_SEVERITY_ERROR, "a.b.c", msg.c_str());
+        }
+      });
+  }
+  std::thread setter(
+    [&logging]() {
+      for (int i = 0; logging.load(); ++i) {
+        EXPECT_EQ(
+          RCL_LOGGING_RET_OK,
+          rcl_logging_external_set_logger_level(
+            "a.b", 0 == i % 2 ? RCUTILS_LOG_SEVERITY_DEBUG : RCUTILS_LOG_SEVERITY_WARN));
+      }
+    });
+  for (std::thread & thread : threads) {
+    thread.join();
+  }
+  logging = false;
+  setter.join();
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+
+  // Errors pass either level.
+  std::stringstream lines(read_file(find_single_log(nullptr)));
+  std::string line;
+  size_t count = 0;
+  while (std::getline(lines, line)) {
+    ++count;
+  }
+  EXPECT_EQ(static_cast<size_t>(kThreads * kCount), count);
+}
+
+TEST_F(LoggingTest, log_with_length)
+{
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_initialize(nullptr, nullptr, allocator));
+  EXPECT_EQ(
+    RCL_LOGGING_RET_OK,
+    rcl_logging_external_set_logger_level("a.b", RCUTILS_LOG_SEVERITY_ERROR));
+
+  // Neither the names nor the messages are null terminated where they end
+  const std::string buffer = "a.b.c|first|second|third|fourth";
+  const char * name = buffer.data();
+  const char * msg = buffer.data() + 6;
+  rcl_logging_external_log_with_length(RCUTILS_LOG_SEVERITY_INFO, name, 1, msg, 5);
+  // Same name pointer as above, but a different logger
+  rcl_logging_external_log_with_length(RCUTILS_LOG_SEVERITY_INFO, name, 5, msg + 6, 6);
+  rcl_logging_external_log_with_length(RCUTILS_LOG_SEVERITY_ERROR, name, 3, msg + 13, 5);
+  rcl_logging_external_log_with_length(RCUTILS_LOG_SEVERITY_INFO, nullptr, 0, msg + 19, 6);
+  // Embedded null characters are part of the message
+  rcl_logging_external_log_with_length(RCUTILS_LOG_SEVERITY_INFO, nullptr, 0, "x\0y", 3);
+
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+
+  EXPECT_EQ(
+    std::string("first\nthird\nfourth\nx\0y\n", 23), read_file(find_single_log(nullptr)));
+}
+
+TEST_F(LoggingTest, log_batch)
+{
+  for (const char * async : {"0", "1"}) {
+    std::filesystem::path config_file_path = log_file_path_dir() / "logging.conf";
+    {
+      std::ofstream config_file(config_file_path);
+      config_file << "async = " << async << "\n";
+    }
+    ASSERT_EQ(
+      RCL_LOGGING_RET_OK,
+      rcl_logging_external_initialize(
+        async, config_file_path.string().c_str(), allocator)) << "async = " << async;
+    EXPECT_EQ(
+      RCL_LOGGING_RET_OK,
+      rcl_logging_external_set_logger_level("quiet", RCUTILS_LOG_SEVERITY_ERROR));
+
+    // More records than are handed to the sinks at once
+    const char * names[] = {"", "loud", "quiet"};
+    std::vector<std::string> messages;
+    for (int i = 0; i < 200; ++i) {
+      messages.push_back("Message number " + std::to_string(i));
+    }
+    std::vector<rcl_logging_record_t> records;
+    std::stringstream expected_log;
+    for (size_t i = 0; i < messages.size(); ++i) {
+      int severity = i % 5 == 0 ? RCUTILS_LOG_SEVERITY_ERROR : RCUTILS_LOG_SEVERITY_INFO;
+      const char * name = names[i % 3];
+      records.push_back(
+        {severity, name, std::strlen(name), messages[i].data(), messages[i].size()});
+      if (RCUTILS_LOG_SEVERITY_ERROR == severity || std::string("quiet") != name) {
+        expected_log << messages[i] << std::endl;
+      }
+    }
+    rcl_logging_external_log_batch(records.data(), records.size());
+    rcl_logging_external_log_batch(nullptr, 0);
+
+    EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+    EXPECT_EQ(expected_log.str(), read_file(find_single_log(async))) << "async = " << async;
+  }
+}
+
+TEST_F(LoggingTest, log_structured)
+{
+  RestoreEnvVar console_format_var("RCUTILS_CONSOLE_OUTPUT_FORMAT");
+  ASSERT_TRUE(rcpputils::set_env_var("RCUTILS_CONSOLE_OUTPUT_FORMAT", nullptr));
+
+  // Formatted like rcutils does by default
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_initialize("default", nullptr, allocator));
+  EXPECT_EQ(
+    RCL_LOGGING_RET_OK,
+    rcl_logging_external_set_logger_level("quiet", RCUTILS_LOG_SEVERITY_ERROR));
+  rcl_logging_structured_record_t record = {
+    RCUTILS_LOG_SEVERITY_WARN, "a.b|", 3, 1700000000123456789, "file.cpp", "function", 42,
+    "hello|", 5};
+  rcl_logging_external_log_structured(&record);
+  record.name = "quiet";
+  record.name_length = 5;
+  rcl_logging_external_log_structured(&record);
+  // Later in the same second, then in the next one
+  record = {
+    RCUTILS_LOG_SEVERITY_INFO, nullptr, 0, 1700000000999000001, nullptr, nullptr, 0, "", 0};
+  rcl_logging_external_log_structured(&record);
+  record.timestamp_ns = 1700000001000000000;
+  record.severity = RCUTILS_LOG_SEVERITY_ERROR + 1;
+  rcl_logging_external_log_structured(&record);
+  rcl_logging_external_log_structured(nullptr);
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+  EXPECT_EQ(
+    "[WARN] [1700000000.123456789] [a.b]: hello\n"
+    "[INFO] [1700000000.999000001] []: \n"
+    "[FATAL] [1700000001.000000000] []: \n",
+    read_file(find_single_log("default")));
+
+  // Every token rcutils knows, and one it doesn't
+  std::filesystem::path config_file_path = log_file_path_dir() / "logging.conf";
+  {
+    std::ofstream config_file(config_file_path);
+    config_file << "line_format = {date_time_with_ms} {severity} {name} {file_name}:"
+      "{line_number} {function_name} {time_as_nanoseconds} {unknown} {message\n";
+  }
+  ASSERT_EQ(
+    RCL_LOGGING_RET_OK,
+    rcl_logging_external_initialize("tokens", config_file_path.string().c_str(), allocator));
+  std::stringstream expected_log;
+  for (int64_t timestamp_ns : {1700000000123456789, 1700000000124000000, 1700000003000000000}) {
+    record = {
+      RCUTILS_LOG_SEVERITY_INFO, "x", 1, timestamp_ns, "file.cpp", "function", 42, "hello", 5};
+    rcl_logging_external_log_structured(&record);
+    std::time_t seconds = static_cast<std::time_t>(timestamp_ns / 1000000000);
+    char date_time[32];
+    ASSERT_NE(
+      0u, std::strftime(
+        date_time, sizeof(date_time), "%Y-%m-%d %H:%M:%S", std::localtime(&seconds)));
+    char milliseconds[8];
+    std::snprintf(
+      milliseconds, sizeof(milliseconds), ".%03d",
+      static_cast<int>(timestamp_ns / 1000000 % 1000));
+    expected_log << date_time << milliseconds << " INFO x file.cpp:42 function " <<
+      timestamp_ns << " {unknown} {message\n";
+  }
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+  EXPECT_EQ(expected_log.str(), read_file(find_single_log("tokens")));
+
+  // The rcutils format is taken from the environment too
+  ASSERT_TRUE(rcpputils::set_env_var("RCUTILS_CONSOLE_OUTPUT_FORMAT", "{name}: {message}"));
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_initialize("env", nullptr, allocator));
+  record = {RCUTILS_LOG_SEVERITY_INFO, "x", 1, 0, nullptr, nullptr, 0, "hello", 5};
+  rcl_logging_external_log_structured(&record);
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+  EXPECT_EQ("x: hello\n", read_file(find_single_log("env")));
+}
+
+TEST_F(LoggingTest, config_file_quoted_values)
+{
+  std::filesystem::path config_file_path = log_file_path_dir() / "logging.conf";
+  {
+    std::ofstream config_file(config_file_path);
+    config_file <<
+      "line_format = \"#{line_number} \\\"{message}\\\" \\\\\"  # the '#' is kept\n";
+  }
+  ASSERT_EQ(
+    RCL_LOGGING_RET_OK,
+    rcl_logging_external_initialize("quoted", config_file_path.string().c_str(), allocator));
+  rcl_logging_structured_record_t record = {
+    RCUTILS_LOG_SEVERITY_INFO, "", 0, 0, "file.cpp", "function", 42, "quoted", 6};
+  rcl_logging_external_log_structured(&record);
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+
+  EXPECT_EQ("#42 \"quoted\" \\\n", read_file(find_single_log("quoted")));
+}
+
+TEST_F(LoggingTest, is_enabled_for)
+{
+  EXPECT_FALSE(rcl_logging_external_is_enabled_for(nullptr, RCUTILS_LOG_SEVERITY_FATAL));
+  EXPECT_TRUE(rcl_logging_external_severity_might_be_enabled(RCUTILS_LOG_SEVERITY_DEBUG));
+
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_initialize(nullptr, nullptr, allocator));
+
+  // The default level is info
+  EXPECT_FALSE(rcl_logging_external_is_enabled_for(nullptr, RCUTILS_LOG_SEVERITY_DEBUG));
+  EXPECT_TRUE(rcl_logging_external_is_enabled_for(nullptr, RCUTILS_LOG_SEVERITY_INFO));
+  EXPECT_FALSE(rcl_logging_external_severity_might_be_enabled(RCUTILS_LOG_SEVERITY_DEBUG));
+  EXPECT_TRUE(rcl_logging_external_severity_might_be_enabled(RCUTILS_LOG_SEVERITY_INFO));
+
+  EXPECT_EQ(
+    RCL_LOGGING_RET_OK,
+    rcl_logging_external_set_logger_level(nullptr, RCUTILS_LOG_SEVERITY_ERROR));
+  EXPECT_FALSE(rcl_logging_external_is_enabled_for("a.b", RCUTILS_LOG_SEVERITY_WARN));
+  EXPECT_FALSE(rcl_logging_external_severity_might_be_enabled(RCUTILS_LOG_SEVERITY_WARN));
+
+  // A single logger with a lower level lowers the threshold for all of them
+  EXPECT_EQ(
+    RCL_LOGGING_RET_OK,
+    rcl_logging_external_set_logger_level("a", RCUTILS_LOG_SEVERITY_DEBUG));
+  EXPECT_TRUE(rcl_logging_external_is_enabled_for("a.b", RCUTILS_LOG_SEVERITY_DEBUG));
+  EXPECT_FALSE(rcl_logging_external_is_enabled_for("b", RCUTILS_LOG_SEVERITY_WARN));
+  EXPECT_TRUE(rcl_logging_external_severity_might_be_enabled(RCUTILS_LOG_SEVERITY_DEBUG));
+
+  EXPECT_EQ(
+    RCL_LOGGING_RET_OK,
+    rcl_logging_external_set_logger_level("a", RCUTILS_LOG_SEVERITY_UNSET));
+  EXPECT_FALSE(rcl_logging_external_is_enabled_for("a.b", RCUTILS_LOG_SEVERITY_DEBUG));
+  EXPECT_FALSE(rcl_logging_external_severity_might_be_enabled(RCUTILS_LOG_SEVERITY_WARN));
+  EXPECT_TRUE(rcl_logging_external_severity_might_be_enabled(RCUTILS_LOG_SEVERITY_ERROR));
+
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+
+  EXPECT_FALSE(rcl_logging_external_is_enabled_for(nullptr, RCUTILS_LOG_SEVERITY_FATAL));
+  EXPECT_TRUE(rcl_logging_external_severity_might_be_enabled(RCUTILS_LOG_SEVERITY_DEBUG));
+}
+
+TEST_F(LoggingTest, flight_recorder)
+{
+  std::filesystem::path config_file_path = log_file_path_dir() / "logging.conf";
+  {
+    std::ofstream config_file(config_file_path);
+    config_file <<
+      "flight_recorder_size = 3\n"
+      "flight_recorder_level = info\n"
+#ifndef _WIN32
+      "flight_recorder_signal = SIGUSR1\n"
+#endif
+      "flush_interval = 0\n"
+      "flush_level = warn\n";
+  }
+  ASSERT_EQ(
+    RCL_LOGGING_RET_OK,
+    rcl_logging_external_initialize(nullptr, config_file_path.string().c_str(), allocator));
+  EXPECT_EQ(
+    RCL_LOGGING_RET_OK,
+    rcl_logging_external_set_logger_level(nullptr, RCUTILS_LOG_SEVERITY_WARN));
+
+  // Kept back, but asked for
+  EXPECT_TRUE(rcl_logging_external_is_enabled_for(nullptr, RCUTILS_LOG_SEVERITY_INFO));
+  EXPECT_TRUE(rcl_logging_external_severity_might_be_enabled(RCUTILS_LOG_SEVERITY_INFO));
+  EXPECT_FALSE(rcl_logging_external_is_enabled_for(nullptr, RCUTILS_LOG_SEVERITY_DEBUG));
+  EXPECT_FALSE(rcl_logging_external_severity_might_be_enabled(RCUTILS_LOG_SEVERITY_DEBUG));
+
+  const std::string begin = "--- Begin of flight recorder dump ---\n";
+  auto end = [](int count) {
+      return "--- End of flight recorder dump, " + std::to_string(count) + " messages ---\n";
+    };
+
+  // Only the last three are kept
+  for (const char * msg : {"i1", "i2", "i3", "i4"}) {
+    rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, "a", msg);
+  }
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_DEBUG, "a", "never kept");
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_WARN, "a", "w1");
+  std::filesystem::path log_file_path = find_single_log(nullptr);
+  std::string expected_log = "w1\n";
+  EXPECT_EQ(expected_log, read_file(log_file_path));
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_ERROR, "a", "e1");
+  expected_log += begin + "i2\ni3\ni4\n" + end(3) + "e1\n";
+  EXPECT_EQ(expected_log, read_file(log_file_path));
+
+  // Nothing kept, nothing dumped
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_FATAL, "a", "f1");
+  expected_log += "f1\n";
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_dump_flight_recorder());
+  EXPECT_EQ(expected_log, read_file(log_file_path));
+
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, "a", "i5");
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_dump_flight_recorder());
+  expected_log += begin + "i5\n" + end(1);
+  EXPECT_EQ(expected_log, read_file(log_file_path));
+
+  // Cut to 512 bytes with the logger name, and marked as such
+  std::string long_msg(600, 'x');
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, "a", long_msg.c_str());
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_dump_flight_recorder());
+  expected_log += begin + std::string(499, 'x') + " [truncated]\n" + end(1);
+  EXPECT_EQ(expected_log, read_file(log_file_path));
+
+  // Within a batch, dumped right before the error
+  rcl_logging_record_t records[] = {
+    {RCUTILS_LOG_SEVERITY_WARN, "a", 1, "w2", 2},
+    {RCUTILS_LOG_SEVERITY_INFO, "a", 1, "i6", 2},
+    {RCUTILS_LOG_SEVERITY_ERROR, "a", 1, "e2", 2},
+  };
+  rcl_logging_external_log_batch(records, 3);
+  expected_log += "w2\n" + begin + "i6\n" + end(1) + "e2\n";
+  EXPECT_EQ(expected_log, read_file(log_file_path));
+
+#ifndef _WIN32
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, "a", "i7");
+  expected_log += begin + "i7\n" + end(1);
+  ASSERT_EQ(0, raise(SIGUSR1));
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (read_file(log_file_path) != expected_log &&
+    std::chrono::steady_clock::now() < deadline)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  EXPECT_EQ(expected_log, read_file(log_file_path));
+#endif
+
+  // Whatever is still kept at shutdown is gone
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, "a", "i8");
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+  EXPECT_EQ(expected_log, read_file(log_file_path));
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_dump_flight_recorder());
+}
+
+TEST_F(LoggingTest, flight_recorder_concurrent)
+{
+  std::filesystem::path config_file_path = log_file_path_dir() / "logging.conf";
+  {
+    std::ofstream config_file(config_file_path);
+    config_file <<
+      "flight_recorder_size = 100\n"
+      "flight_recorder_level = info\n";
+  }
+  ASSERT_EQ(
+    RCL_LOGGING_RET_OK,
+    rcl_logging_external_initialize(nullptr, config_file_path.string().c_str(), allocator));
+  EXPECT_EQ(
+    RCL_LOGGING_RET_OK,
+    rcl_logging_external_set_logger_level(nullptr, RCUTILS_LOG_SEVERITY_WARN));
+
+  constexpr int kThreads = 4;
+  constexpr int kCount = 2000;
+  std::atomic<bool> start{false};
+  std::atomic<int> running{kThreads};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back(
+      [t, &start, &running]() {
+        while (!start) {
+          std::this_thread::yield();
+        }
+        for (int i = 0; i < kCount; ++i) {
+          std::string msg = std::to_string(t) + " " + std::to_string(i);
+          rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, msg.c_str());
+        }
+        --running;
+      });
+  }
+  start = true;
+  while (running > 0) {
+    EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_dump_flight_recorder());
+  }
+  for (std::thread & thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_dump_flight_recorder());
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+
+  // Some are replaced before they are dumped, but none is dumped twice or
+  // torn, and those of each thread come in the order it logged them.
+  std::vector<int> last(kThreads, -1);
+  int dumped = 0;
+  int counted = 0;
+  std::stringstream lines(read_file(find_single_log(nullptr)));
+  std::string line;
+  while (std::getline(lines, line)) {
+    if (0 == line.rfind("--- Begin", 0)) {
+      continue;
+    }
+    if (0 == line.rfind("--- End of flight recorder dump, ", 0)) {
+      counted += std::stoi(line.substr(std::strlen("--- End of flight recorder dump, ")));
+      continue;
+    }
+    std::stringstream fields(line);
+    int t = -1;
+    int i = -1;
+    fields >> t >> i;
+    ASSERT_TRUE(fields.eof()) << line;
+    ASSERT_GE(t, 0);
+    ASSERT_LT(t, kThreads);
+    EXPECT_GT(i, last[static_cast<size_t>(t)]) << line;
+    EXPECT_LT(i, kCount) << line;
+    last[static_cast<size_t>(t)] = i;
+    ++dumped;
+  }
+  EXPECT_EQ(counted, dumped);
+  // The last message is kept until the last dump
+  EXPECT_EQ(kCount - 1, *std::max_element(last.begin(), last.end()));
+}
+
+TEST_F(LoggingTest, message_filter)
+{
+  std::filesystem::path config_file_path = log_file_path_dir() / "logging.conf";
+  {
+    std::ofstream config_file(config_file_path);
+    config_file <<
+      "rate_limit = 10\n"
+      "rate_limit_burst = 3\n"
+      "suppress_duplicates = 1\n"
+      "duplicate_report_interval = 0\n";
+  }
+  ASSERT_EQ(
+    RCL_LOGGING_RET_OK,
+    rcl_logging_external_initialize(nullptr, config_file_path.string().c_str(), allocator));
+  std::stringstream expected_log;
+
+  // Duplicates don't take from the rate limit
+  for (int i = 0; i < 100; ++i) {
+    rcl_logging_external_log(RCUTILS_LOG_SEVERITY_WARN, "sensor", "stuck");
+  }
+  expected_log << "stuck" << std::endl;
+  // Neither is one of another level
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_ERROR, "sensor", "stuck");
+  expected_log << "stuck" << std::endl;
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_WARN, "sensor", "unstuck");
+  expected_log << "--- The previous message of logger 'sensor' was repeated 99 times ---" <<
+    std::endl << "unstuck" << std::endl;
+
+  // One token left of the burst
+  for (int i = 0; i < 10; ++i) {
+    rcl_logging_external_log(
+      RCUTILS_LOG_SEVERITY_WARN, "sensor", ("reading " + std::to_string(i)).c_str());
+  }
+  expected_log << "reading 0" << std::endl;
+  // Other loggers are not affected
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_WARN, "other", "other");
+  expected_log << "other" << std::endl;
+
+  // Refilled by then
+  std::this_thread::sleep_for(std::chrono::milliseconds(150));
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_WARN, "sensor", "reading 10");
+  expected_log << "--- 9 messages of logger 'sensor' were dropped by the rate limit ---" <<
+    std::endl << "reading 10" << std::endl;
+
+  rcl_logging_record_t records[] = {
+    {RCUTILS_LOG_SEVERITY_INFO, "batch", 5, "b", 1},
+    {RCUTILS_LOG_SEVERITY_INFO, "batch", 5, "b", 1},
+    {RCUTILS_LOG_SEVERITY_INFO, "batch", 5, "c", 1},
+  };
+  rcl_logging_external_log_batch(records, 3);
+  expected_log << "b" << std::endl <<
+    "--- The previous message of logger 'batch' was repeated 1 times ---" << std::endl <<
+    "c" << std::endl;
+
+  // Different only in the time stamp rcutils put in front
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, "ts", "[INFO] [1.5] [ts]: same");
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, "ts", "[INFO] [2.5] [ts]: same");
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, "ts", "[INFO] [3.5] [ts]: different");
+  expected_log << "[INFO] [1.5] [ts]: same" << std::endl <<
+    "--- The previous message of logger 'ts' was repeated 1 times ---" << std::endl <<
+    "[INFO] [3.5] [ts]: different" << std::endl;
+
+  // Reported on shutdown, if there is nothing else to report it
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, "root");
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, "root");
+  expected_log << "root" << std::endl <<
+    "--- The previous message of the root logger was repeated 1 times ---" << std::endl;
+
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+  EXPECT_EQ(expected_log.str(), read_file(find_single_log(nullptr)));
+}
+
+// Loggers hashed to different shards of the filter, and to the same ones.
+TEST_F(LoggingTest, message_filter_concurrent_loggers)
+{
+  std::filesystem::path config_file_path = log_file_path_dir() / "logging.conf";
+  {
+    std::ofstream config_file(config_file_path);
+    config_file <<
+      "suppress_duplicates = 1\n"
+      "duplicate_report_interval = 0\n";
+  }
+  ASSERT_EQ(
+    RCL_LOGGING_RET_OK,
+    rcl_logging_external_initialize(nullptr, config_file_path.string().c_str(), allocator));
+
+  constexpr int kThreads = 8;
+  constexpr int kLoggersPerThread = 8;
+  constexpr int kMessages = 100;
+  std::vector<std::thread> threads;
+  for (int thread = 0; thread < kThreads; ++thread) {
+    threads.emplace_back(
+      [thread]() {
+        for (int i = 0; i < kMessages; ++i) {
+          for (int logger = 0; logger < kLoggersPerThread; ++logger) {
+            std::string name =
+              "logger_" + std::to_string(thread) + "_" + std::to_string(logger);
+            rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, name.c_str(), "stuck");
+          }
+        }
+      });
+  }
+  for (std::thread & thread : threads) {
+    thread.join();
+  }
+
+  // Each logger is reported on shutdown, none got the duplicates of another
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+  std::string log = read_file(find_single_log(nullptr));
+  for (int thread = 0; thread < kThreads; ++thread) {
+    for (int logger = 0; logger < kLoggersPerThread; ++logger) {
+      std::string report = "--- The previous message of logger 'logger_" +
+        std::to_string(thread) + "_" + std::to_string(logger) + "' was repeated " +
+        std::to_string(kMessages - 1) + " times ---\n";
+      EXPECT_NE(std::string::npos, log.find(report)) << report;
+    }
+  }
+  size_t logged = 0;
+  for (size_t pos = log.find("stuck\n"); std::string::npos != pos;
+    pos = log.find("stuck\n", pos + 1))
+  {
+    ++logged;
+  }
+  EXPECT_EQ(static_cast<size_t>(kThreads * kLoggersPerThread), logged);
+}
+
+TEST_F(LoggingTest, stats)
+{
+  EXPECT_EQ(RCL_LOGGING_RET_INVALID_ARGUMENT, rcl_logging_external_get_stats(nullptr));
+  rcutils_reset_error();
+
+  std::filesystem::path config_file_path = log_file_path_dir() / "logging.conf";
+  {
+    std::ofstream config_file(config_file_path);
+    config_file <<
+      "flush_level = warn\n"
+      "suppress_duplicates = 1\n";
+  }
+  ASSERT_EQ(
+    RCL_LOGGING_RET_OK,
+    rcl_logging_external_initialize(nullptr, config_file_path.string().c_str(), allocator));
+
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, "stats", "same");
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, "stats", "same");
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_DEBUG, "stats", "debug");
+  rcl_logging_record_t records[] = {
+    {RCUTILS_LOG_SEVERITY_DEBUG, "batch", 5, "debug", 5},
+    {RCUTILS_LOG_SEVERITY_ERROR, "batch", 5, "error", 5},
+  };
+  rcl_logging_external_log_batch(records, 2);
+  // In between warn and error, counted as error
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_WARN + 1, "stats", "error");
+
+  rcl_logging_stats_t stats;
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_get_stats(&stats));
+  EXPECT_EQ(0u, stats.accepted[RCL_LOGGING_STATS_SEVERITY_DEBUG]);
+  EXPECT_EQ(1u, stats.accepted[RCL_LOGGING_STATS_SEVERITY_INFO]);
+  EXPECT_EQ(0u, stats.accepted[RCL_LOGGING_STATS_SEVERITY_WARN]);
+  EXPECT_EQ(2u, stats.accepted[RCL_LOGGING_STATS_SEVERITY_ERROR]);
+  EXPECT_EQ(0u, stats.accepted[RCL_LOGGING_STATS_SEVERITY_FATAL]);
+  EXPECT_EQ(2u, stats.filtered[RCL_LOGGING_STATS_SEVERITY_DEBUG]);
+  EXPECT_EQ(1u, stats.filtered[RCL_LOGGING_STATS_SEVERITY_INFO]);
+  EXPECT_EQ(0u, stats.filtered[RCL_LOGGING_STATS_SEVERITY_ERROR]);
+  // Each error flushed
+  EXPECT_EQ(2u, stats.flush_count);
+  EXPECT_EQ(0u, stats.dropped);
+  EXPECT_EQ(0u, stats.queue_depth);
+  EXPECT_EQ(0u, stats.peak_queue_depth);
+  // The duplicate is only reported on shutdown
+  EXPECT_EQ(std::string("same\nerror\nerror\n").size(), stats.bytes_written);
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+
+  // Counted from zero again
+  ASSERT_EQ(
+    RCL_LOGGING_RET_OK,
+    rcl_logging_external_initialize("again", config_file_path.string().c_str(), allocator));
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_get_stats(&stats));
+  EXPECT_EQ(0u, stats.accepted[RCL_LOGGING_STATS_SEVERITY_INFO]);
+  EXPECT_EQ(0u, stats.filtered[RCL_LOGGING_STATS_SEVERITY_DEBUG]);
+  EXPECT_EQ(0u, stats.bytes_written);
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+}
+
+TEST_F(LoggingTest, stats_async)
+{
+  RestoreEnvVar async_var("RCL_LOGGING_SPDLOG_ASYNC");
+  RestoreEnvVar queue_size_var("RCL_LOGGING_SPDLOG_ASYNC_QUEUE_SIZE");
+  ASSERT_TRUE(rcpputils::set_env_var("RCL_LOGGING_SPDLOG_ASYNC", "1"));
+  ASSERT_TRUE(rcpputils::set_env_var("RCL_LOGGING_SPDLOG_ASYNC_QUEUE_SIZE", "16"));
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_initialize(nullptr, nullptr, allocator));
+
+  for (int i = 0; i < 1000; ++i) {
+    rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, "message");
+  }
+  rcl_logging_stats_t stats;
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_get_stats(&stats));
+  EXPECT_EQ(1000u, stats.accepted[RCL_LOGGING_STATS_SEVERITY_INFO]);
+  // The queue blocks rather than dropping by default
+  EXPECT_EQ(0u, stats.dropped);
+  EXPECT_LE(stats.queue_depth, 16u);
+  EXPECT_LE(stats.peak_queue_depth, 16u);
+  EXPECT_GE(stats.peak_queue_depth, 1u);
+
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+}
+
+TEST_F(LoggingTest, extra_sinks)
+{
+  std::string extra_sinks = "error:file:errors";
+#ifndef _WIN32
+  // Bound before logging is initialized, so that no datagram is lost.
+  int udp_socket = socket(AF_INET, SOCK_DGRAM, 0);
+  ASSERT_LE(0, udp_socket);
+  RCPPUTILS_SCOPE_EXIT({close(udp_socket);});
+  struct sockaddr_in udp_address = {};
+  udp_address.sin_family = AF_INET;
+  udp_address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t udp_address_size = sizeof(udp_address);
+  ASSERT_EQ(
+    0, bind(udp_socket, reinterpret_cast<struct sockaddr *>(&udp_address), udp_address_size));
+  ASSERT_EQ(
+    0, getsockname(
+      udp_socket, reinterpret_cast<struct sockaddr *>(&udp_address), &udp_address_size));
+  extra_sinks += ",warn:udp:127.0.0.1:" + std::to_string(ntohs(udp_address.sin_port));
+
+  std::string unix_path = (log_file_path_dir() / "log.sock").string();
+  int unix_socket = socket(AF_UNIX, SOCK_DGRAM, 0);
+  ASSERT_LE(0, unix_socket);
+  RCPPUTILS_SCOPE_EXIT({close(unix_socket);});
+  struct sockaddr_un unix_address = {};
+  unix_address.sun_family = AF_UNIX;
+  ASSERT_LT(unix_path.size(), sizeof(unix_address.sun_path));
+  std::strncpy(unix_address.sun_path, unix_path.c_str(), sizeof(unix_address.sun_path) - 1);
+  ASSERT_EQ(
+    0, bind(
+      unix_socket, reinterpret_cast<struct sockaddr *>(&unix_address), sizeof(unix_address)));
+  extra_sinks += ", debug:unix:" + unix_path;
+#endif
+  RestoreEnvVar extra_sinks_var("RCL_LOGGING_SPDLOG_EXTRA_SINKS");
+  ASSERT_TRUE(rcpputils::set_env_var("RCL_LOGGING_SPDLOG_EXTRA_SINKS", extra_sinks.c_str()));
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_initialize(nullptr, nullptr, allocator));
+  EXPECT_EQ(
+    RCL_LOGGING_RET_OK,
+    rcl_logging_external_set_logger_level(nullptr, RCUTILS_LOG_SEVERITY_INFO));
+
+  // Every sink only gets what passed the logger level too
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_DEBUG, nullptr, "debug");
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, "info");
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_WARN, nullptr, "warn");
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_ERROR, nullptr, "error");
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_FATAL, nullptr, "fatal");
+  rcl_logging_stats_t stats;
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_get_stats(&stats));
+  EXPECT_EQ(0u, stats.dropped);
+  // Whatever is still queued for the extra sinks is written out
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+
+  std::filesystem::path errors_file_path;
+  for (const std::filesystem::directory_entry & dir_entry :
+    std::filesystem::directory_iterator{log_file_path_dir()})
+  {
+    std::string name = dir_entry.path().filename().string();
+    if (name.size() > 11 && name.compare(name.size() - 11, 11, ".errors.log") == 0) {
+      errors_file_path = dir_entry.path();
+    }
+  }
+  ASSERT_FALSE(errors_file_path.empty());
+  std::string log_file_name = errors_file_path.filename().string();
+  log_file_name.replace(log_file_name.size() - 11, 7, "");
+  EXPECT_EQ("info\nwarn\nerror\nfatal\n", read_file(log_file_path_dir() / log_file_name));
+  EXPECT_EQ("error\nfatal\n", read_file(errors_file_path));
+
+#ifndef _WIN32
+  auto receive_all = [](int fd) {
+      std::vector<std::string> datagrams;
+      char buffer[256];
+      ssize_t size;
+      while ((size = recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT)) >= 0) {
+        datagrams.emplace_back(buffer, static_cast<size_t>(size));
+      }
+      return datagrams;
+    };
+  EXPECT_EQ(
+    std::vector<std::string>({"warn\n", "error\n", "fatal\n"}), receive_all(udp_socket));
+  EXPECT_EQ(
+    std::vector<std::string>({"info\n", "warn\n", "error\n", "fatal\n"}),
+    receive_all(unix_socket));
+#endif
+
+  using ::testing::HasSubstr;
+  for (const char * invalid : {"error", "error:file", "error:pipe:x", "loud:file:x",
+      "error:file:", "error:file:1st", "error:file:../x", "error:file:a,"})
+  {
+    ASSERT_TRUE(rcpputils::set_env_var("RCL_LOGGING_SPDLOG_EXTRA_SINKS", invalid));
+    EXPECT_EQ(
+      RCL_LOGGING_RET_ERROR,
+      rcl_logging_external_initialize(nullptr, nullptr, allocator)) << invalid;
+    EXPECT_THAT(rcutils_get_error_string().str, HasSubstr("RCL_LOGGING_SPDLOG_EXTRA_SINKS"));
+    rcutils_reset_error();
+  }
+}
+
+TEST_F(LoggingTest, async_overflow_policies)
+{
+  RestoreEnvVar async_var("RCL_LOGGING_SPDLOG_ASYNC");
+  RestoreEnvVar queue_size_var("RCL_LOGGING_SPDLOG_ASYNC_QUEUE_SIZE");
+  RestoreEnvVar record_size_var("RCL_LOGGING_SPDLOG_ASYNC_RECORD_SIZE");
+  RestoreEnvVar policy_var("RCL_LOGGING_SPDLOG_ASYNC_OVERFLOW_POLICY");
+  ASSERT_TRUE(rcpputils::set_env_var("RCL_LOGGING_SPDLOG_ASYNC", "1"));
+  ASSERT_TRUE(rcpputils::set_env_var("RCL_LOGGING_SPDLOG_ASYNC_QUEUE_SIZE", "4"));
+  // Small enough for some of the messages not to fit, and be truncated
+  constexpr size_t kRecordSize = 16;
+  ASSERT_TRUE(
+    rcpputils::set_env_var(
+      "RCL_LOGGING_SPDLOG_ASYNC_RECORD_SIZE", std::to_string(kRecordSize).c_str()));
+
+  constexpr int kCount = 2000;
+  std::vector<std::string> messages;
+  for (int i = 0; i < kCount; ++i) {
+    messages.push_back("message " + std::to_string(i) + std::string(i % 7 == 0 ? 20 : 0, '.'));
+  }
+  // Each of the messages written is one of those logged, in the same order.
+  auto count_written = [&messages](const std::string & log) {
+      std::stringstream lines(log);
+      std::string line;
+      size_t next = 0;
+      size_t written = 0;
+      while (std::getline(lines, line)) {
+        while (next < messages.size() && messages[next].substr(0, kRecordSize) != line) {
+          ++next;
+        }
+        if (next == messages.size()) {
+          ADD_FAILURE() << "Unexpected line: " << line;
+          break;
+        }
+        ++next;
+        ++written;
+      }
+      return written;
+    };
+
+  for (const char * policy : {"discard_new", "overrun_oldest", "shed_by_severity"}) {
+    SCOPED_TRACE(policy);
+    ASSERT_TRUE(rcpputils::set_env_var("RCL_LOGGING_SPDLOG_ASYNC_OVERFLOW_POLICY", policy));
+    ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_initialize(policy, nullptr, allocator));
+    EXPECT_EQ(
+      RCL_LOGGING_RET_OK,
+      rcl_logging_external_set_logger_level(nullptr, RCUTILS_LOG_SEVERITY_DEBUG));
+    // The last one is an error, kept by shed_by_severity
+    for (int i = 0; i < kCount; ++i) {
+      rcl_logging_external_log(
+        i % 2 == 0 ? RCUTILS_LOG_SEVERITY_DEBUG : RCUTILS_LOG_SEVERITY_ERROR, nullptr,
+        messages[i].c_str());
+    }
+    rcl_logging_stats_t stats;
+    ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_get_stats(&stats));
+    EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+
+    std::string log = read_file(find_single_log(policy));
+    // Every message is either written or counted as dropped
+    EXPECT_EQ(kCount, count_written(log) + stats.dropped);
+    if (std::string("discard_new") == policy) {
+      // Posted to the empty queue
+      EXPECT_EQ(0u, log.rfind(messages.front().substr(0, kRecordSize) + "\n", 0));
+    } else {
+      // Always gets in, at the expense of an older one
+      EXPECT_EQ(log.size() - messages.back().size() - 1, log.rfind(messages.back() + "\n"));
+    }
+  }
+}
+
+// Logging calls racing with shutdown either log, or do nothing.
+TEST_F(LoggingTest, log_while_reinitializing)
+{
+  std::filesystem::path config_file_path = log_file_path_dir() / "logging.conf";
+  {
+    std::ofstream config_file(config_file_path);
+    config_file <<
+      "flight_recorder_size = 16\n"
+      "flight_recorder_level = debug\n"
+      "rate_limit = 1000000\n"
+      "suppress_duplicates = 1\n";
+  }
+  std::atomic<bool> stop{false};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back(
+      [t, &stop]() {
+        rcl_logging_record_t records[] = {
+          {RCUTILS_LOG_SEVERITY_INFO, "batch", 5, "b1", 2},
+          {RCUTILS_LOG_SEVERITY_ERROR, "batch", 5, "b2", 2},
+        };
+        rcl_logging_structured_record_t record = {
+          RCUTILS_LOG_SEVERITY_WARN, "structured", 10, 0, "file.cpp", "function", 1, "s", 1};
+        rcl_logging_stats_t stats;
+        for (int i = 0; !stop; ++i) {
+          std::string msg = std::to_string(t) + " " + std::to_string(i);
+          rcl_logging_external_log(RCUTILS_LOG_SEVERITY_DEBUG, "a", msg.c_str());
+          rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, "a", msg.c_str());
+          rcl_logging_external_log_batch(records, 2);
+          rcl_logging_external_log_structured(&record);
+          rcl_logging_external_is_enabled_for("a", RCUTILS_LOG_SEVERITY_INFO);
+          EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_get_stats(&stats));
+          EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_dump_flight_recorder());
+        }
+      });
+  }
+  for (int i = 0; i < 50; ++i) {
+    EXPECT_EQ(
+      RCL_LOGGING_RET_OK,
+      rcl_logging_external_initialize(
+        "reinitialized", config_file_path.string().c_str(), allocator));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+  }
+  stop = true;
+  for (std::thread & thread : threads) {
+    thread.join();
+  }
+}
+
+TEST_F(LoggingTest, async_concurrent_callers)
+{
+  RestoreEnvVar async_var("RCL_LOGGING_SPDLOG_ASYNC");
+  RestoreEnvVar queue_size_var("RCL_LOGGING_SPDLOG_ASYNC_QUEUE_SIZE");
+  ASSERT_TRUE(rcpputils::set_env_var("RCL_LOGGING_SPDLOG_ASYNC", "1"));
+  ASSERT_TRUE(rcpputils::set_env_var("RCL_LOGGING_SPDLOG_ASYNC_QUEUE_SIZE", "4"));
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_initialize(nullptr, nullptr, allocator));
+
+  constexpr int kThreads = 4;
+  constexpr int kCount = 1000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back(
+      [t]() {
+        for (int i = 0; i < kCount; ++i) {
+          std::string msg = std::to_string(t) + " " + std::to_string(i);
+          rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, msg.c_str());
+        }
+      });
+  }
+  for (std::thread & thread : threads) {
+    thread.join();
+  }
+  rcl_logging_stats_t stats;
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_get_stats(&stats));
+  EXPECT_EQ(0u, stats.dropped);
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+
+  // Blocking, every message is written exactly once, and those of each
+  // thread in the order it logged them
+  std::vector<std::vector<std::string>> written(kThreads);
+  std::stringstream lines(read_file(find_single_log(nullptr)));
+  std::string line;
+  while (std::getline(lines, line)) {
+    int t = std::stoi(line);
+    ASSERT_GE(t, 0);
+    ASSERT_LT(t, kThreads);
+    written[static_cast<size_t>(t)].push_back(line);
+  }
+  for (int t = 0; t < kThreads; ++t) {
+    std::vector<std::string> expected;
+    for (int i = 0; i < kCount; ++i) {
+      expected.push_back(std::to_string(t) + " " + std::to_string(i));
+    }
+    EXPECT_EQ(expected, written[static_cast<size_t>(t)]);
+  }
+}
+
+#ifdef __linux__
+TEST_F(LoggingTest, thread_settings)
+{
+  // Pin to a CPU this process may run on, which need not be CPU 0 in a container.
+  cpu_set_t allowed;
+  ASSERT_EQ(0, sched_getaffinity(0, sizeof(allowed), &allowed));
+  int cpu = 0;
+  while (!CPU_ISSET(cpu, &allowed)) {
+    ++cpu;
+  }
+  int main_nice = getpriority(PRIO_PROCESS, 0);
+  int main_policy = sched_getscheduler(0);
+
+  RestoreEnvVar async_var("RCL_LOGGING_SPDLOG_ASYNC");
+  RestoreEnvVar cpus_var("RCL_LOGGING_SPDLOG_THREAD_CPUS");
+  RestoreEnvVar policy_var("RCL_LOGGING_SPDLOG_THREAD_SCHEDULING_POLICY");
+  RestoreEnvVar nice_var("RCL_LOGGING_SPDLOG_THREAD_NICE");
+  ASSERT_TRUE(rcpputils::set_env_var("RCL_LOGGING_SPDLOG_ASYNC", "1"));
+  ASSERT_TRUE(
+    rcpputils::set_env_var("RCL_LOGGING_SPDLOG_THREAD_CPUS", std::to_string(cpu).c_str()));
+  ASSERT_TRUE(rcpputils::set_env_var("RCL_LOGGING_SPDLOG_THREAD_SCHEDULING_POLICY", "batch"));
+  ASSERT_TRUE(rcpputils::set_env_var("RCL_LOGGING_SPDLOG_THREAD_NICE", "5"));
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_initialize(nullptr, nullptr, allocator));
+
+  // The threads apply the settings once they start, so wait for the async
+  // writer and the flusher to get there.
+  auto placed_threads = [cpu]() {
+      size_t count = 0;
+      for (const auto & task : std::filesystem::directory_iterator("/proc/self/task")) {
+        std::string stat = read_file(task.path() / "stat");
+        // The fields after the command name, which may contain spaces, start
+        // with the state, and have the nice value and policy 16 and 38 later.
+        std::stringstream fields(stat.substr(stat.rfind(')') + 2));
+        std::vector<std::string> values;
+        std::string value;
+        while (fields >> value) {
+          values.push_back(value);
+        }
+        cpu_set_t cpus;
+        pid_t tid = static_cast<pid_t>(std::stol(task.path().filename().string()));
+        if (values.size() > 38 && "5" == values[16] &&
+          std::to_string(SCHED_BATCH) == values[38] &&
+          0 == sched_getaffinity(tid, sizeof(cpus), &cpus) &&
+          1 == CPU_COUNT(&cpus) && CPU_ISSET(cpu, &cpus))
+        {
+          ++count;
+        }
+      }
+      return count;
+    };
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (placed_threads() < 2 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(2u, placed_threads());
+  // Only the backend's own threads are affected.
+  EXPECT_EQ(main_nice, getpriority(PRIO_PROCESS, 0));
+  EXPECT_EQ(main_policy, sched_getscheduler(0));
+
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+}
+#endif
+
+TEST_F(LoggingTest, latency_histograms)
+{
+  EXPECT_EQ(
+    RCL_LOGGING_RET_INVALID_ARGUMENT, rcl_logging_external_get_latency_histograms(nullptr));
+  rcutils_reset_error();
+
+  std::filesystem::path config_file_path = log_file_path_dir() / "logging.conf";
+  {
+    std::ofstream config_file(config_file_path);
+    config_file <<
+      "flush_level = warn\n"
+      "latency_report_interval = 1\n";
+  }
+  ASSERT_EQ(
+    RCL_LOGGING_RET_OK,
+    rcl_logging_external_initialize(nullptr, config_file_path.string().c_str(), allocator));
+
+  for (int i = 0; i < 10; ++i) {
+    rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, "info");
+  }
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_WARN, nullptr, "flushed");
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, "not flushed");
+
+  rcl_logging_latency_histograms_t histograms;
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_get_latency_histograms(&histograms));
+  EXPECT_EQ(12u, histograms.written.count);
+  EXPECT_EQ(11u, histograms.flushed.count);
+  for (const auto & histogram : {histograms.written, histograms.flushed}) {
+    EXPECT_LE(histogram.p50_ns, histogram.p90_ns);
+    EXPECT_LE(histogram.p90_ns, histogram.p99_ns);
+    EXPECT_LE(histogram.p99_ns, histogram.p999_ns);
+    EXPECT_LE(histogram.p999_ns, histogram.max_ns);
+    uint64_t bucketed = 0;
+    for (uint64_t bucket : histogram.buckets) {
+      bucketed += bucket;
+    }
+    EXPECT_EQ(histogram.count, bucketed);
+  }
+  // Flushing comes after writing
+  EXPECT_GE(histograms.flushed.max_ns, histograms.written.p50_ns);
+
+  // Reported by the first message once the interval is over
+  std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_INFO, nullptr, "report");
+
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+  using ::testing::HasSubstr;
+  EXPECT_THAT(
+    read_file(find_single_log(nullptr)),
+    HasSubstr("report\n--- Logging latency of 13 messages: written p50 "));
+
+  // Not measured unless configured
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_initialize("off", nullptr, allocator));
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_ERROR, nullptr, "error");
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_get_latency_histograms(&histograms));
+  EXPECT_EQ(0u, histograms.written.count);
+  EXPECT_EQ(0u, histograms.flushed.count);
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+}
+
+TEST_F(LoggingTest, latency_histograms_skip_replayed)
+{
+  std::filesystem::path config_file_path = log_file_path_dir() / "logging.conf";
+  {
+    std::ofstream config_file(config_file_path);
+    config_file <<
+      "flight_recorder_size = 3\n"
+      "flight_recorder_level = debug\n"
+      "flush_interval = 0\n"
+      "latency_histograms = 1\n";
+  }
+  ASSERT_EQ(
+    RCL_LOGGING_RET_OK,
+    rcl_logging_external_initialize(nullptr, config_file_path.string().c_str(), allocator));
+
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_DEBUG, nullptr, "recorded 1");
+  rcl_logging_external_log(RCUTILS_LOG_SEVERITY_DEBUG, nullptr, "recorded 2");
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_dump_flight_recorder());
+
+  // Only the lines around the dump, which were logged just now
+  rcl_logging_latency_histograms_t histograms;
+  ASSERT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_get_latency_histograms(&histograms));
+  EXPECT_EQ(2u, histograms.written.count);
+  EXPECT_LT(histograms.written.max_ns, 200000000u);
+  EXPECT_EQ(2u, histograms.flushed.count);
+  EXPECT_LT(histograms.flushed.max_ns, 200000000u);
+
+  EXPECT_EQ(RCL_LOGGING_RET_OK, rcl_logging_external_shutdown());
+  EXPECT_EQ(
+    "--- Begin of flight recorder dump ---\nrecorded 1\nrecorded 2\n"
+    "--- End of flight recorder dump, 2 messages ---\n",
+    read_file(find_single_log(nullptr)));
+}
+
 TEST_F(LoggingTest, init_fini_maybe_fail_test)
 {
   RCUTILS_FAULT_INJECTION_TEST(